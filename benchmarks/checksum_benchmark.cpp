@@ -0,0 +1,104 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <array>
+#include <random>
+#include <chrono>
+#include <string_view>
+#include <cstdint>
+#include <cstdlib>
+
+#include "include/utils/algorithms.h"
+
+/**
+ * Measures the throughput of the Internet checksum kernels on the packets of different sizes and compares them with
+ * the previous implementation, which summed one 16-bit word per iteration.
+ * The result of every kernel is checked against the previous implementation.
+ * Usage: checksum_benchmark [iteration-count(1000000)]
+ */
+
+constexpr std::array<std::size_t, 9> PACKET_SIZES = { 20, 40, 64, 128, 256, 576, 1500, 4096, 9000 };
+
+__attribute__((noinline)) std::uint16_t CalcChecksumBytewise(const std::span<const std::uint8_t> packet)
+{
+    std::uint32_t sum = 0;
+    for (std::size_t i = 0; i + 1 < packet.size(); i += 2) {
+        sum += (packet[i] << 8) | packet[i + 1];
+    }
+
+    if (packet.size() % 2 == 1) {
+        sum += packet[packet.size() - 1] << 8;
+    }
+
+    while (sum >> 16) {
+        sum = (sum & 0xFFFF) + (sum >> 16);
+    }
+    return static_cast<std::uint16_t>(~sum & 0xFFFF);
+}
+
+template<typename F>
+double MeasureNsPerPacket(const std::span<const std::uint8_t> packet, const unsigned long iterationCount, F&& calcChecksum)
+{
+    // The result is accumulated to prevent the compiler from throwing away the calls
+    volatile std::uint16_t sink = 0;
+    const auto startTime = std::chrono::steady_clock::now();
+    for (unsigned long i = 0; i < iterationCount; ++i) {
+        sink = sink + calcChecksum(packet);
+    }
+    const auto duration = std::chrono::steady_clock::now() - startTime;
+    return std::chrono::duration<double, std::nano>(duration).count() / iterationCount;
+}
+
+int main(int argc, char** argv) {
+    using posnet::utils::ChecksumKernel;
+    const unsigned long iterationCount = argc > 1 ? std::stoul(argv[1]) : 1000000;
+
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<int> distribution(0, 0xFF);
+    std::vector<std::uint8_t> buffer(PACKET_SIZES.back() + 1);
+    for (auto& byte : buffer) {
+        byte = static_cast<std::uint8_t>(distribution(generator));
+    }
+
+    std::cout << "selected kernel: " << posnet::utils::ChecksumKernelToStr(posnet::utils::GetChecksumKernel()) << std::endl;
+    std::cout << std::setw(8) << "size" << std::setw(12) << "bytewise";
+    for (const auto kernel : { ChecksumKernel::Scalar, ChecksumKernel::Sse2, ChecksumKernel::Avx2 }) {
+        if (posnet::utils::IsChecksumKernelSupported(kernel)) {
+            std::cout << std::setw(20) << posnet::utils::ChecksumKernelToStr(kernel);
+        }
+    }
+    std::cout << std::setw(20) << "dispatched" << "  (ns per packet, speedup)" << std::endl;
+
+    for (const auto size : PACKET_SIZES) {
+        // The odd offset checks the kernels on the unaligned data too
+        for (const std::size_t offset : { 0, 1 }) {
+            const auto packet = std::span<const std::uint8_t>(buffer.data() + offset, size - offset);
+            const auto expected = CalcChecksumBytewise(packet);
+            const auto bytewiseNs = MeasureNsPerPacket(packet, iterationCount, CalcChecksumBytewise);
+
+            std::cout << std::setw(8) << packet.size() << std::setw(12) << std::fixed << std::setprecision(1) << bytewiseNs;
+            for (const auto kernel : { ChecksumKernel::Scalar, ChecksumKernel::Sse2, ChecksumKernel::Avx2 }) {
+                if (!posnet::utils::IsChecksumKernelSupported(kernel)) {
+                    continue;
+                }
+
+                if (posnet::utils::CalcChecksum(packet, kernel) != expected) {
+                    std::cerr << "\nkernel=" << posnet::utils::ChecksumKernelToStr(kernel) << " returned wrong checksum for size="
+                        << packet.size() << std::endl;
+                    return EXIT_FAILURE;
+                }
+
+                const auto kernelNs = MeasureNsPerPacket(packet, iterationCount, [kernel](const auto packet) {
+                    return posnet::utils::CalcChecksum(packet, kernel);
+                });
+                std::cout << std::setw(12) << kernelNs << " (x" << std::setprecision(1) << bytewiseNs / kernelNs << ")";
+            }
+
+            const auto dispatchedNs = MeasureNsPerPacket(packet, iterationCount, [](const auto packet) {
+                return posnet::utils::CalcChecksum(packet);
+            });
+            std::cout << std::setw(12) << dispatchedNs << " (x" << bytewiseNs / dispatchedNs << ")" << std::endl;
+        }
+    }
+    return EXIT_SUCCESS;
+}
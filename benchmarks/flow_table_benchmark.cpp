@@ -0,0 +1,118 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <cstdint>
+#include <cstdlib>
+
+#include "include/flow-table/flow_table.h"
+
+/**
+ * Measures the update rate of the flow accounting: FlowTable against std::unordered_map with the same key, hash and record.
+ * The updates pick the flows uniformly, so the large tables do not fit into the cache. The last case keeps the table
+ * at the half of the flows, so every second update evicts the least recently updated flow.
+ * Usage: flow_table_benchmark [update-count(20000000)]
+ */
+
+using posnet::FlowKey;
+using posnet::FlowRecord;
+using posnet::FlowTable;
+
+struct FlowKeyHash {
+    std::size_t operator()(const FlowKey& key) const noexcept
+    {
+        return key.getHash();
+    }
+};
+
+std::uint64_t NextRandom(std::uint64_t& state)
+{
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+std::vector<FlowKey> MakeKeys(const std::size_t count)
+{
+    std::uint64_t state = 0x2545f4914f6cdd1dULL;
+    std::vector<FlowKey> keys(count);
+    for (auto& key : keys) {
+        const auto value = NextRandom(state);
+        key.sourceIpAddress = static_cast<std::uint32_t>(value);
+        key.destIpAddress = static_cast<std::uint32_t>(value >> 32);
+        key.sourcePort = static_cast<std::uint16_t>(NextRandom(state));
+        key.destPort = 443;
+        key.protocol = 6;
+    }
+    return keys;
+}
+
+std::vector<std::uint32_t> MakeSequence(const std::size_t flowCount, const std::size_t updateCount)
+{
+    std::uint64_t state = 0x9e3779b97f4a7c15ULL;
+    std::vector<std::uint32_t> sequence(updateCount);
+    for (auto& index : sequence) {
+        index = static_cast<std::uint32_t>(NextRandom(state) % flowCount);
+    }
+    return sequence;
+}
+
+template<typename Update>
+void Measure(const std::string_view name, const std::size_t flowCount, const std::vector<std::uint32_t>& sequence,
+    Update&& update)
+{
+    const auto start = std::chrono::steady_clock::now();
+    std::uint64_t timestamp = 0;
+    for (const auto index : sequence) {
+        update(index, std::chrono::nanoseconds(++timestamp));
+    }
+    const auto duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << std::setw(24) << name << std::setw(10) << flowCount << std::setw(12) << std::fixed << std::setprecision(2)
+        << sequence.size() / duration / 1e6 << " Mupdates/s" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    const std::size_t updateCount = argc > 1 ? std::stoull(argv[1]) : 20000000;
+
+    std::cout << std::setw(24) << "table" << std::setw(10) << "flows" << std::setw(12) << "rate" << std::endl;
+    for (const FlowTable::SizeType flowCount : { 1 << 10, 1 << 16, 1 << 20 }) {
+        const auto keys = MakeKeys(flowCount);
+        const auto sequence = MakeSequence(flowCount, updateCount);
+
+        std::uint64_t expectedFlowCount = 0;
+        {
+            std::unordered_map<FlowKey, FlowRecord, FlowKeyHash> flows;
+            flows.reserve(flowCount);
+            Measure("std::unordered_map", flowCount, sequence, [&keys, &flows](const auto index, const auto timestamp) {
+                auto& record = flows[keys[index]];
+                if (record.packetCount == 0) {
+                    record.key = keys[index];
+                    record.firstSeen = timestamp;
+                }
+                ++record.packetCount;
+                record.byteCount += 64;
+                record.lastSeen = timestamp;
+            });
+            expectedFlowCount = flows.size();
+        }
+
+        FlowTable table(FlowTable::Configuration{ .maxFlowCount = flowCount });
+        Measure("FlowTable", flowCount, sequence, [&keys, &table](const auto index, const auto timestamp) {
+            table.update(keys[index], 64, timestamp);
+        });
+        if (table.getFlowCount() != expectedFlowCount) {
+            std::cout << "MISMATCH: " << table.getFlowCount() << " != " << expectedFlowCount << std::endl;
+        }
+
+        FlowTable smallTable(FlowTable::Configuration{ .maxFlowCount = flowCount / 2 });
+        Measure("FlowTable(LRU eviction)", flowCount, sequence, [&keys, &smallTable](const auto index, const auto timestamp) {
+            smallTable.update(keys[index], 64, timestamp);
+        });
+    }
+    return EXIT_SUCCESS;
+}
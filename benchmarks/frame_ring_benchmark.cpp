@@ -0,0 +1,155 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <array>
+#include <deque>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+
+#include "include/frame_descriptor.h"
+#include "include/utils/strict_mutex.h"
+
+/**
+ * Measures the throughput of the frame descriptor handoff between the threads: the mutex-protected deque(StrictMutex,
+ * the only primitive of the tree before the rings), SpscFrameRing and MpmcFrameRing with the single and the batch calls.
+ * The rings use the backpressure policy, so every descriptor is delivered and the sums are checked.
+ * Usage: frame_ring_benchmark [descriptor-count-per-producer(4000000)]
+ */
+
+using posnet::FrameDescriptor;
+using posnet::utils::OverflowPolicy;
+
+constexpr std::size_t RING_CAPACITY = 4096;
+constexpr std::size_t BATCH_SIZE = 32;
+
+class MutexQueue final {
+public:
+    void enqueue(const FrameDescriptor& descriptor)
+    {
+        auto queue = m_queue.lock();
+        queue->push_back(descriptor);
+    }
+
+    bool tryDequeue(FrameDescriptor& descriptor)
+    {
+        auto queue = m_queue.lock();
+        if (queue->empty()) {
+            return false;
+        }
+        descriptor = queue->front();
+        queue->pop_front();
+        return true;
+    }
+
+private:
+    posnet::utils::StrictMutex<std::deque<FrameDescriptor>> m_queue;
+};
+
+template<typename Enqueue, typename Dequeue>
+void Measure(const std::string_view name, const unsigned int producerCount, const unsigned int consumerCount,
+    const std::uint64_t countPerProducer, Enqueue&& enqueue, Dequeue&& dequeue)
+{
+    const auto totalCount = countPerProducer * producerCount;
+    std::atomic<std::uint64_t> consumedCount = 0;
+    std::atomic<std::uint64_t> consumedSum = 0;
+
+    const auto startTime = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (unsigned int i = 0; i < producerCount; ++i) {
+        threads.emplace_back([&enqueue, countPerProducer] {
+            for (std::uint64_t sequence = 1; sequence <= countPerProducer;) {
+                sequence += enqueue(sequence, countPerProducer - sequence + 1);
+            }
+        });
+    }
+
+    for (unsigned int i = 0; i < consumerCount; ++i) {
+        threads.emplace_back([&dequeue, &consumedCount, &consumedSum, totalCount] {
+            std::uint64_t sum = 0;
+            posnet::utils::Backoff backoff;
+            while (consumedCount.load(std::memory_order_relaxed) < totalCount) {
+                const auto [count, batchSum] = dequeue();
+                if (count == 0) {
+                    // The consumer does not burn the time slice of the producer, if they share the core
+                    backoff.pause();
+                    continue;
+                }
+                backoff.reset();
+                sum += batchSum;
+                consumedCount.fetch_add(count, std::memory_order_relaxed);
+            }
+            consumedSum.fetch_add(sum);
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    const auto duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+    const auto expectedSum = countPerProducer * (countPerProducer + 1) / 2 * producerCount;
+    std::cout << std::setw(28) << name << std::setw(6) << producerCount << "x" << std::left << std::setw(6) << consumerCount
+        << std::right << std::setw(12) << std::fixed << std::setprecision(2) << totalCount / duration / 1e6 << " Mdesc/s"
+        << (consumedSum.load() == expectedSum ? "" : "  MISMATCH") << std::endl;
+}
+
+template<typename Ring>
+void MeasureRing(const std::string_view name, const unsigned int producerCount, const unsigned int consumerCount,
+    const std::uint64_t countPerProducer, const std::size_t batchSize)
+{
+    Ring ring(RING_CAPACITY);
+    Measure(name, producerCount, consumerCount, countPerProducer,
+        [&ring, batchSize](const std::uint64_t sequence, const std::uint64_t leftCount) {
+            std::array<FrameDescriptor, BATCH_SIZE> batch;
+            const auto count = std::min<std::uint64_t>(batchSize, leftCount);
+            for (std::uint64_t i = 0; i < count; ++i) {
+                batch[i].length = static_cast<FrameDescriptor::SizeType>(sequence + i);
+            }
+            return ring.enqueueBatch(std::span<const FrameDescriptor>(batch.data(), count));
+        },
+        [&ring, batchSize] {
+            std::array<FrameDescriptor, BATCH_SIZE> batch;
+            const auto count = ring.dequeueBatch(std::span<FrameDescriptor>(batch.data(), batchSize));
+            std::uint64_t sum = 0;
+            for (std::size_t i = 0; i < count; ++i) {
+                sum += batch[i].length;
+            }
+            return std::pair<std::uint64_t, std::uint64_t>{ count, sum };
+        });
+}
+
+int main(int argc, char** argv) {
+    const std::uint64_t countPerProducer = argc > 1 ? std::stoull(argv[1]) : 4000000;
+
+    std::cout << std::setw(28) << "queue" << std::setw(13) << "prod x cons" << std::setw(12) << "throughput" << std::endl;
+    for (const unsigned int threadCount : { 1, 2 }) {
+        MutexQueue queue;
+        Measure("StrictMutex<deque>", threadCount, threadCount, countPerProducer,
+            [&queue](const std::uint64_t sequence, std::uint64_t) {
+                FrameDescriptor descriptor;
+                descriptor.length = static_cast<FrameDescriptor::SizeType>(sequence);
+                queue.enqueue(descriptor);
+                return std::uint64_t{ 1 };
+            },
+            [&queue] {
+                FrameDescriptor descriptor;
+                const auto isDequeued = queue.tryDequeue(descriptor);
+                return std::pair<std::uint64_t, std::uint64_t>{ isDequeued ? 1 : 0, isDequeued ? descriptor.length : 0 };
+            });
+    }
+
+    MeasureRing<posnet::SpscFrameRing<OverflowPolicy::Backpressure>>("SpscFrameRing", 1, 1, countPerProducer, 1);
+    MeasureRing<posnet::SpscFrameRing<OverflowPolicy::Backpressure>>("SpscFrameRing batch", 1, 1, countPerProducer, BATCH_SIZE);
+    for (const unsigned int threadCount : { 1, 2, 4 }) {
+        MeasureRing<posnet::MpmcFrameRing<OverflowPolicy::Backpressure>>("MpmcFrameRing", threadCount, threadCount, countPerProducer, 1);
+        MeasureRing<posnet::MpmcFrameRing<OverflowPolicy::Backpressure>>("MpmcFrameRing batch", threadCount, threadCount, countPerProducer, BATCH_SIZE);
+    }
+    return EXIT_SUCCESS;
+}
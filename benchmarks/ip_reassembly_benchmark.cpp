@@ -0,0 +1,133 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <cstring>
+#include <cstdint>
+#include <cstdlib>
+
+#include <netinet/ip.h>
+#include <netinet/udp.h>
+#include <arpa/inet.h>
+
+#include "include/ip-reassembly/ip_reassembler.h"
+#include "include/frame-viewers/ip_viewer.h"
+#include "include/frame-viewers/udp_viewer.h"
+
+/**
+ * Measures the reassembly of the fragmented UDP datagrams: every datagram carries 8000 bytes of UDP payload, which is split
+ * into 6 fragments by 1500 bytes MTU. The fragments of the window of datagrams are interleaved(the first fragments
+ * of all datagrams of the window, then the second ones, ...), in the forward or in the reverse order, so the window is
+ * the count of the datagrams, which are reassembled at once. Every reassembled datagram is checked by UdpViewer::TryView.
+ * Usage: ip_reassembly_benchmark [pass-count(20)]
+ */
+
+using posnet::IpReassembler;
+
+constexpr std::size_t DATAGRAM_COUNT = 4096;
+constexpr std::size_t UDP_PAYLOAD_SIZE = 8000;
+constexpr std::size_t MTU = 1500;
+
+struct FragmentedDatagram {
+    std::vector<std::vector<std::uint8_t>> fragments;
+};
+
+std::vector<std::uint8_t> MakeFragment(const std::uint16_t id, const std::uint8_t* const payload, const std::size_t size,
+    const std::size_t offset, const bool hasMoreFragments)
+{
+    std::vector<std::uint8_t> packet(sizeof(struct iphdr) + size);
+    auto* const header = reinterpret_cast<struct iphdr*>(packet.data());
+    header->version = 4;
+    header->ihl = sizeof(struct iphdr) / 4;
+    header->tot_len = htons(static_cast<std::uint16_t>(packet.size()));
+    header->id = htons(id);
+    header->frag_off = htons(static_cast<std::uint16_t>((offset / 8) | (hasMoreFragments ? IP_MF : 0)));
+    header->ttl = 64;
+    header->protocol = IPPROTO_UDP;
+    header->saddr = htonl(0x0a000001);
+    header->daddr = htonl(0x0a000002);
+    std::memcpy(packet.data() + sizeof(struct iphdr), payload, size);
+    return packet;
+}
+
+std::vector<FragmentedDatagram> MakeDatagrams()
+{
+    std::vector<FragmentedDatagram> datagrams(DATAGRAM_COUNT);
+    std::vector<std::uint8_t> udpDatagram(sizeof(struct udphdr) + UDP_PAYLOAD_SIZE);
+    for (std::size_t i = 0; i < DATAGRAM_COUNT; ++i) {
+        auto* const udpHeader = reinterpret_cast<struct udphdr*>(udpDatagram.data());
+        udpHeader->source = htons(53);
+        udpHeader->dest = htons(static_cast<std::uint16_t>(1024 + i));
+        udpHeader->len = htons(static_cast<std::uint16_t>(udpDatagram.size()));
+        std::memset(udpDatagram.data() + sizeof(struct udphdr), static_cast<int>(i), UDP_PAYLOAD_SIZE);
+
+        const auto maxFragmentPayload = (MTU - sizeof(struct iphdr)) / 8 * 8;
+        for (std::size_t offset = 0; offset < udpDatagram.size(); offset += maxFragmentPayload) {
+            const auto size = std::min(maxFragmentPayload, udpDatagram.size() - offset);
+            datagrams[i].fragments.push_back(MakeFragment(static_cast<std::uint16_t>(i), udpDatagram.data() + offset, size,
+                offset, offset + size < udpDatagram.size()));
+        }
+    }
+    return datagrams;
+}
+
+void Measure(const std::string_view name, const std::vector<FragmentedDatagram>& datagrams, const std::size_t window,
+    const bool isReversed, const std::size_t passCount)
+{
+    IpReassembler reassembler(IpReassembler::Configuration{
+        .maxDatagramCount = 4096,
+        .memoryLimitInBytes = 64 * 1024 * 1024,
+    });
+
+    std::uint64_t fragmentCount = 0;
+    std::uint64_t reassembledCount = 0;
+    std::uint64_t invalidCount = 0;
+    std::chrono::nanoseconds timestamp(0);
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t pass = 0; pass < passCount; ++pass) {
+        for (std::size_t first = 0; first < datagrams.size(); first += window) {
+            const auto fragmentsPerDatagram = datagrams[first].fragments.size();
+            for (std::size_t j = 0; j < fragmentsPerDatagram; ++j) {
+                const auto fragmentIndex = isReversed ? fragmentsPerDatagram - 1 - j : j;
+                for (std::size_t i = first; i < first + window && i < datagrams.size(); ++i) {
+                    const auto& fragment = datagrams[i].fragments[fragmentIndex];
+                    timestamp += std::chrono::microseconds(1);
+                    ++fragmentCount;
+                    const auto datagram = reassembler.process(fragment, timestamp);
+                    if (!datagram) {
+                        continue;
+                    }
+
+                    ++reassembledCount;
+                    const auto ipViewer = posnet::IpViewer::TryView(*datagram);
+                    const auto udpViewer = posnet::UdpViewer::TryView(ipViewer->getPayload(*datagram));
+                    if (!udpViewer || udpViewer->getDestPort() != static_cast<int>(1024 + i)) {
+                        ++invalidCount;
+                    }
+                }
+            }
+        }
+    }
+    const auto duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    const auto statistics = reassembler.getStatistics();
+    std::cout << std::setw(20) << name << std::setw(8) << window << std::setw(12) << std::fixed << std::setprecision(2)
+        << fragmentCount / duration / 1e6 << " Mfrag/s" << std::setw(12) << reassembledCount / duration / 1e3 << " Kdgram/s"
+        << std::setw(10) << fragmentCount * MTU * 8 / duration / 1e9 << " Gbit/s"
+        << ((invalidCount != 0 || reassembledCount != passCount * datagrams.size() || statistics.activeDatagrams != 0) ? "  MISMATCH" : "")
+        << std::endl;
+}
+
+int main(int argc, char** argv) {
+    const std::size_t passCount = argc > 1 ? std::stoull(argv[1]) : 20;
+    const auto datagrams = MakeDatagrams();
+
+    std::cout << std::setw(20) << "order" << std::setw(8) << "window" << std::setw(12) << "fragments" << std::endl;
+    for (const std::size_t window : { 1, 16, 256, 4096 }) {
+        Measure("forward", datagrams, window, false, passCount);
+        Measure("reverse", datagrams, window, true, passCount);
+    }
+    return EXIT_SUCCESS;
+}
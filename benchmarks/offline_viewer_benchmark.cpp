@@ -0,0 +1,194 @@
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+
+#include "include/capture-file/pcap_reader.h"
+#include "include/capture-file/pcap_writer.h"
+#include "include/frame-dissector/frame_dissector.h"
+
+#include "include/frame-viewers/ethernet_viewer.h"
+#include "include/frame-viewers/ip_viewer.h"
+#include "include/frame-viewers/tcp_viewer.h"
+#include "include/frame-viewers/udp_viewer.h"
+
+#include "include/frame-builder/ethernet_builder.h"
+#include "include/frame-builder/ip_builder.h"
+#include "include/frame-builder/udp_builder.h"
+
+/**
+ * Measures the throughput of the viewers on the recorded traffic, entirely offline. The capture file is mapped by
+ * PcapReader and every pass runs over all frames of the file:
+ * 1) viewers - EthernetViewer, IpViewer and the l4 viewer are constructed one from another(the frame is parsed by every viewer);
+ * 2) dissector - the frame is parsed once by FrameDissector and the viewers are constructed from ParsedFrame;
+ * 3) columns - the frames are dissected by batches into FrameColumns.
+ * Usage: offline_viewer_benchmark <capture-file> [pass-count(10)]
+ *        offline_viewer_benchmark --generate <capture-file> [frame-count(1000000)] - writes the synthetic UDP traffic
+ */
+
+constexpr posnet::def::SizeType COLUMNS_BATCH_SIZE = 256;
+
+using ConstRawFrameViewType = posnet::PcapReader::ConstRawFrameViewType;
+
+int GenerateCapture(const std::string_view path, const unsigned long frameCount)
+{
+    posnet::EthernetBuilder ethernetBuilder;
+    ethernetBuilder.setProtocol(posnet::EthernetBuilder::ProtocolType::IP)
+        .setDestMacAddress("00:00:00:00:00:00")
+        .setSourceMacAddress("00:00:00:00:00:00");
+
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<unsigned int> sizeDistribution(0, 1400);
+    std::vector<posnet::def::ByteType> frame(2048, 0);
+    posnet::PcapWriter writer(path);
+    for (unsigned long i = 0; i < frameCount; ++i) {
+        const auto payloadSize = sizeDistribution(generator);
+        auto ipBuilder = posnet::MakeDefaultIpBuilder();
+        ipBuilder.setVersion(posnet::IpBuilder::VersionType::V4)
+            .setProtocol(posnet::IpBuilder::ProtocolType::UDP)
+            .setSourceIpAddress("10.0.0." + std::to_string(generator() % 256))
+            .setDestIpAddress("10.0.1." + std::to_string(generator() % 256))
+            .setTotalLength(posnet::IpBuilder::DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES +
+                posnet::UdpBuilder::DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES + payloadSize);
+
+        posnet::UdpBuilder udpBuilder;
+        udpBuilder.setSourcePort(generator() % 65536)
+            .setDestPort(generator() % 1024)
+            .setUdpDataGramLength(posnet::UdpBuilder::DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES + payloadSize);
+
+        posnet::def::SizeType size = 0;
+        for (const posnet::BaseFrame* builder : std::initializer_list<const posnet::BaseFrame*>{ &ethernetBuilder, &ipBuilder, &udpBuilder }) {
+            std::copy(builder->getStart(), builder->getStart() + builder->getSize(), frame.data() + size);
+            size += builder->getSize();
+        }
+
+        while (!writer.write(ConstRawFrameViewType{ frame.data(), size + payloadSize })) {
+            // The benchmark data must not be lost, so the generator waits for the disk
+            writer.flush();
+        }
+    }
+    writer.close();
+    std::cout << "generated frames=" << frameCount << " written bytes=" << writer.getStatistics().writtenBytes << std::endl;
+    return EXIT_SUCCESS;
+}
+
+template<typename F>
+void RunBenchmark(const std::string_view name, posnet::PcapReader& reader, const unsigned long passCount, F&& pass)
+{
+    std::uint64_t frameCount = 0;
+    std::uint64_t byteCount = 0;
+    std::uint64_t checksum = 0;
+    const auto startTime = std::chrono::steady_clock::now();
+    for (unsigned long i = 0; i < passCount; ++i) {
+        reader.reset();
+        pass(reader, frameCount, byteCount, checksum);
+    }
+    const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    std::cout << name << ": frames=" << frameCount << " rate=" << static_cast<std::uint64_t>(frameCount / seconds) << " fps"
+        << " throughput=" << byteCount * 8 / seconds / 1e9 << " Gbit/s (checksum=" << checksum << ")" << std::endl;
+}
+
+void RunViewersPass(posnet::PcapReader& reader, std::uint64_t& frameCount, std::uint64_t& byteCount, std::uint64_t& checksum)
+{
+    reader.forEach([&](const posnet::PcapReader::Record& record) {
+        ++frameCount;
+        byteCount += record.frame.size();
+        const posnet::EthernetViewer ethernetViewer(record.frame);
+        if (ethernetViewer.getProtocol() != posnet::EthernetViewer::ProtocolType::IP) {
+            return;
+        }
+
+        const posnet::IpViewer ipViewer(ethernetViewer);
+        checksum += ipViewer.getSourceIpAddress();
+        switch (ipViewer.getProtocol()) {
+            case posnet::IpViewer::ProtocolType::TCP: {
+                checksum += posnet::TcpViewer(ipViewer).getDestPort();
+                break;
+            }
+            case posnet::IpViewer::ProtocolType::UDP: {
+                checksum += posnet::UdpViewer(ipViewer).getDestPort();
+                break;
+            }
+            default:
+                break;
+        }
+    });
+}
+
+void RunDissectorPass(posnet::PcapReader& reader, std::uint64_t& frameCount, std::uint64_t& byteCount, std::uint64_t& checksum)
+{
+    const posnet::FrameDissector dissector;
+    posnet::ParsedFrame parsedFrame;
+    reader.forEach([&](const posnet::PcapReader::Record& record) {
+        ++frameCount;
+        byteCount += record.frame.size();
+        dissector.dissect(record.frame, parsedFrame);
+        if (!parsedFrame.hasFlag(posnet::ParsedFrame::Flag::Ip)) {
+            return;
+        }
+
+        checksum += posnet::IpViewer(parsedFrame).getSourceIpAddress();
+        if (parsedFrame.hasFlag(posnet::ParsedFrame::Flag::Tcp)) {
+            checksum += posnet::TcpViewer(parsedFrame).getDestPort();
+        } else if (parsedFrame.hasFlag(posnet::ParsedFrame::Flag::Udp)) {
+            checksum += posnet::UdpViewer(parsedFrame).getDestPort();
+        }
+    });
+}
+
+void RunColumnsPass(posnet::PcapReader& reader, std::uint64_t& frameCount, std::uint64_t& byteCount, std::uint64_t& checksum)
+{
+    const posnet::FrameDissector dissector;
+    posnet::FrameColumns columns(COLUMNS_BATCH_SIZE);
+    std::vector<ConstRawFrameViewType> frames;
+    frames.reserve(COLUMNS_BATCH_SIZE);
+
+    const auto handleBatch = [&] {
+        columns.clear();
+        dissector.dissectBatch(frames, columns);
+        for (posnet::FrameColumns::SizeType i = 0; i < columns.size(); ++i) {
+            if ((columns.getFlags()[i] & static_cast<std::uint16_t>(posnet::ParsedFrame::Flag::Ip)) != 0) {
+                checksum += columns.getSourceIpAddresses()[i] + columns.getDestPorts()[i];
+            }
+            byteCount += columns.getFrameLengths()[i];
+        }
+        frameCount += frames.size();
+        frames.clear();
+    };
+
+    reader.forEach([&](const posnet::PcapReader::Record& record) {
+        frames.push_back(record.frame);
+        if (frames.size() == COLUMNS_BATCH_SIZE) {
+            handleBatch();
+        }
+    });
+    handleBatch();
+}
+
+int main(int argc, char** argv) {
+    try {
+        if (argc > 2 && std::string_view(argv[1]) == "--generate") {
+            return GenerateCapture(argv[2], argc > 3 ? std::stoul(argv[3]) : 1000000);
+        } else if (argc < 2) {
+            std::cerr << "Usage: offline_viewer_benchmark <capture-file> [pass-count(10)]\n"
+                << "       offline_viewer_benchmark --generate <capture-file> [frame-count(1000000)]" << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        const unsigned long passCount = argc > 2 ? std::stoul(argv[2]) : 10;
+        posnet::PcapReader reader(argv[1]);
+        std::cout << "file size=" << reader.getFileSize() << " link type=" << reader.getLinkType() << std::endl;
+
+        RunBenchmark("viewers", reader, passCount, RunViewersPass);
+        RunBenchmark("dissector", reader, passCount, RunDissectorPass);
+        RunBenchmark("columns", reader, passCount, RunColumnsPass);
+        return EXIT_SUCCESS;
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}
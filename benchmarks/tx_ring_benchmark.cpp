@@ -0,0 +1,184 @@
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <cstdlib>
+
+#include "include/net-io/packet_tx_ring.h"
+
+#include "include/frame-builder/ethernet_builder.h"
+#include "include/frame-builder/ip_builder.h"
+#include "include/frame-builder/udp_builder.h"
+#include "include/frame-builder/frame_template.h"
+
+#include "include/utils/scoped_lock.h"
+
+#include <linux/if_packet.h>
+#include <sys/socket.h>
+#include <net/ethernet.h>
+#include <net/if.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+
+/**
+ * Measures the sustained transmit rate(frames per second) of three paths:
+ * 1) the frame is assembled in the stack buffer by memcpy of every builder and sent by one sendto per frame;
+ * 2) the builders are appended directly into the slots of PacketTxRing and the whole batch is flushed by one send();
+ * 3) the same as 2), but the frame is stamped from FrameTemplate with the per-frame ip id and source port,
+ *    the checksums are updated incrementally.
+ * Usage: tx_ring_benchmark [iface-name(lo)] [frame-count(1000000)] [batch-size(256)]
+ */
+
+constexpr std::string_view PAYLOAD("posnet tx benchmark payload");
+constexpr auto PORT = 12345;
+
+struct Frame {
+    posnet::EthernetBuilder ethernetBuilder;
+    posnet::IpBuilder ipBuilder;
+    posnet::UdpBuilder udpBuilder;
+};
+
+void BuildFrame(Frame& frame)
+{
+    frame.ethernetBuilder.setProtocol(posnet::EthernetBuilder::ProtocolType::IP)
+        .setDestMacAddress("00:00:00:00:00:00")
+        .setSourceMacAddress("00:00:00:00:00:00");
+
+    frame.ipBuilder.setHeaderLengthInBytes(posnet::IpBuilder::DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES)
+        .setVersion(posnet::IpBuilder::VersionType::V4)
+        .setTypeOfService(0)
+        .setId(0)
+        .setTTL(64)
+        .setProtocol(posnet::IpBuilder::ProtocolType::UDP)
+        .setSourceIpAddress("127.0.0.1")
+        .setDestIpAddress("127.0.0.1")
+        .setTotalLength(posnet::IpBuilder::DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES +
+            posnet::UdpBuilder::DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES + PAYLOAD.size());
+    frame.ipBuilder.calcCheckSum();
+
+    frame.udpBuilder.setSourcePort(PORT + 1)
+        .setDestPort(PORT)
+        .setCheckSum(0)
+        .setUdpDataGramLength(posnet::UdpBuilder::DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES + PAYLOAD.size());
+}
+
+void PrintResult(const std::string_view name, const unsigned long frameCount, const std::chrono::steady_clock::duration duration)
+{
+    const auto seconds = std::chrono::duration<double>(duration).count();
+    std::cout << name << ": frames=" << frameCount << " time=" << seconds << "s"
+        << " rate=" << static_cast<unsigned long>(frameCount / seconds) << " pps" << std::endl;
+}
+
+int RunSendToBenchmark(const std::string& ifaceName, const Frame& frame, const unsigned long frameCount)
+{
+    const int sock = socket(PF_PACKET, SOCK_RAW, htons(ETH_P_ALL));
+    if (sock == -1) {
+        perror("socket");
+        return EXIT_FAILURE;
+    }
+
+    posnet::utils::ScopedLock socketLock([sock] {
+        (void)close(sock);
+    });
+
+    struct sockaddr_ll sockAddr;
+    std::memset(&sockAddr, 0, sizeof(sockAddr));
+    sockAddr.sll_family = AF_PACKET;
+    sockAddr.sll_protocol = htons(ETH_P_IP);
+    sockAddr.sll_ifindex = static_cast<int>(if_nametoindex(ifaceName.c_str()));
+
+    const auto startTime = std::chrono::steady_clock::now();
+    for (unsigned long i = 0; i < frameCount; ++i) {
+        std::array<posnet::def::ByteType, 1024> buffer;
+        posnet::def::SizeType bufferSize = 0;
+
+        std::memcpy(buffer.data() + bufferSize, frame.ethernetBuilder.getStart(), frame.ethernetBuilder.getSize());
+        bufferSize += frame.ethernetBuilder.getSize();
+        std::memcpy(buffer.data() + bufferSize, frame.ipBuilder.getStart(), frame.ipBuilder.getSize());
+        bufferSize += frame.ipBuilder.getSize();
+        std::memcpy(buffer.data() + bufferSize, frame.udpBuilder.getStart(), frame.udpBuilder.getSize());
+        bufferSize += frame.udpBuilder.getSize();
+        std::memcpy(buffer.data() + bufferSize, PAYLOAD.data(), PAYLOAD.size());
+        bufferSize += PAYLOAD.size();
+
+        if (sendto(sock, buffer.data(), bufferSize, 0, reinterpret_cast<struct sockaddr*>(&sockAddr), sizeof(sockAddr)) == -1) {
+            perror("sendto");
+            return EXIT_FAILURE;
+        }
+    }
+    PrintResult("sendto", frameCount, std::chrono::steady_clock::now() - startTime);
+    return EXIT_SUCCESS;
+}
+
+int RunTxRingBenchmark(const std::string& ifaceName, const Frame& frame, const unsigned long frameCount, const unsigned long batchSize)
+{
+    posnet::PacketTxRing ring(ifaceName);
+    const auto payload = posnet::PacketTxRing::ConstRawFrameViewType{
+        reinterpret_cast<const posnet::def::ByteType*>(PAYLOAD.data()), PAYLOAD.size()
+    };
+
+    const auto startTime = std::chrono::steady_clock::now();
+    for (unsigned long i = 0; i < frameCount; ++i) {
+        auto slot = ring.acquireSlot(posnet::PacketTxRing::INFINITE_TIMEOUT);
+        slot->append(frame.ethernetBuilder).append(frame.ipBuilder).append(frame.udpBuilder).append(payload);
+        ring.commitSlot(*slot);
+
+        if (ring.getPendingFrameCount() >= batchSize) {
+            (void)ring.send();
+        }
+    }
+    (void)ring.send(true);
+    PrintResult("tx-ring", frameCount, std::chrono::steady_clock::now() - startTime);
+    std::cout << "tx-ring: send calls=" << ring.getStatistics().sendCalls
+        << " ring full=" << ring.getStatistics().ringFullCount << std::endl;
+    return EXIT_SUCCESS;
+}
+
+int RunTxRingTemplateBenchmark(const std::string& ifaceName, const Frame& frame, const unsigned long frameCount, const unsigned long batchSize)
+{
+    posnet::PacketTxRing ring(ifaceName);
+    const posnet::FrameTemplate frameTemplate(frame.ethernetBuilder, frame.ipBuilder, frame.udpBuilder, posnet::FrameTemplate::ConstRawFrameViewType{
+        reinterpret_cast<const posnet::def::ByteType*>(PAYLOAD.data()), PAYLOAD.size()
+    });
+
+    const auto startTime = std::chrono::steady_clock::now();
+    for (unsigned long i = 0; i < frameCount; ++i) {
+        auto slot = ring.acquireSlot(posnet::PacketTxRing::INFINITE_TIMEOUT);
+        frameTemplate.stamp(slot->reserve(frameTemplate.getSize()), posnet::FrameTemplate::Stamp{
+            .ipId = static_cast<std::uint16_t>(i),
+            .sourcePort = static_cast<std::uint16_t>(PORT + 1 + i % 1024),
+        });
+        ring.commitSlot(*slot);
+
+        if (ring.getPendingFrameCount() >= batchSize) {
+            (void)ring.send();
+        }
+    }
+    (void)ring.send(true);
+    PrintResult("tx-ring template", frameCount, std::chrono::steady_clock::now() - startTime);
+    return EXIT_SUCCESS;
+}
+
+int main(int argc, char** argv) {
+    const std::string ifaceName = argc > 1 ? argv[1] : "lo";
+    const unsigned long frameCount = argc > 2 ? std::stoul(argv[2]) : 1000000;
+    const unsigned long batchSize = argc > 3 ? std::stoul(argv[3]) : 256;
+
+    try {
+        Frame frame;
+        BuildFrame(frame);
+
+        if (RunSendToBenchmark(ifaceName, frame, frameCount) != EXIT_SUCCESS) {
+            return EXIT_FAILURE;
+        }
+        if (RunTxRingBenchmark(ifaceName, frame, frameCount, batchSize) != EXIT_SUCCESS) {
+            return EXIT_FAILURE;
+        }
+        return RunTxRingTemplateBenchmark(ifaceName, frame, frameCount, batchSize);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}
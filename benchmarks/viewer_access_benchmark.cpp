@@ -0,0 +1,149 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <string_view>
+#include <type_traits>
+#include <cstring>
+#include <cstdint>
+#include <cstdlib>
+
+#include <net/ethernet.h>
+#include <netinet/ip.h>
+#include <netinet/udp.h>
+#include <arpa/inet.h>
+
+#include "include/frame-viewers/ethernet_viewer.h"
+#include "include/frame-viewers/ip_viewer.h"
+#include "include/frame-viewers/udp_viewer.h"
+
+/**
+ * Measures the cost of reading one field of the frame by the viewers: the viewers are constructed one from another
+ * (Ethernet -> IP -> UDP) and one getter is called per frame. The frames are synthetic UDP frames, which fit in L1/L2 cache,
+ * so the result is the cost of the viewer code itself. The "raw" line reads the same fields directly from the header structs
+ * and it is the lower bound of the cost. The "validated" lines construct the viewers by TryView, which checks the lengths
+ * of every header against the frame.
+ * Usage: viewer_access_benchmark [pass-count(2000)]
+ */
+
+constexpr std::size_t FRAME_COUNT = 1024;
+constexpr std::size_t FRAME_SIZE = 128;
+
+using ConstRawFrameViewType = posnet::EthernetViewer::ConstRawFrameViewType;
+
+std::vector<std::uint8_t> MakeFrames()
+{
+    std::mt19937 generator(42);
+    std::vector<std::uint8_t> buffer(FRAME_COUNT * FRAME_SIZE, 0);
+    for (std::size_t i = 0; i < FRAME_COUNT; ++i) {
+        auto frame = buffer.data() + i * FRAME_SIZE;
+        auto ethernetHeader = reinterpret_cast<struct ethhdr*>(frame);
+        ethernetHeader->h_proto = htons(ETH_P_IP);
+
+        auto ipHeader = reinterpret_cast<struct iphdr*>(frame + sizeof(struct ethhdr));
+        ipHeader->version = 4;
+        ipHeader->ihl = 5;
+        ipHeader->ttl = generator() % 256;
+        ipHeader->protocol = IPPROTO_UDP;
+        ipHeader->tot_len = htons(FRAME_SIZE - sizeof(struct ethhdr));
+        ipHeader->saddr = generator();
+        ipHeader->daddr = generator();
+
+        auto udpHeader = reinterpret_cast<struct udphdr*>(frame + sizeof(struct ethhdr) + sizeof(struct iphdr));
+        udpHeader->source = htons(generator() % 65536);
+        udpHeader->dest = htons(generator() % 65536);
+        udpHeader->len = htons(FRAME_SIZE - sizeof(struct ethhdr) - sizeof(struct iphdr));
+    }
+    return buffer;
+}
+
+template<typename F>
+void RunBenchmark(const std::string_view name, const std::vector<std::uint8_t>& frames, const unsigned long passCount, F&& readField)
+{
+    std::uint64_t checksum = 0;
+    const auto startTime = std::chrono::steady_clock::now();
+    for (unsigned long pass = 0; pass < passCount; ++pass) {
+        for (std::size_t i = 0; i < FRAME_COUNT; ++i) {
+            checksum += readField(ConstRawFrameViewType{ frames.data() + i * FRAME_SIZE, FRAME_SIZE });
+        }
+    }
+    const auto nanoseconds = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - startTime).count();
+    std::cout << std::left << std::setw(24) << name << std::right << std::fixed << std::setprecision(2)
+        << std::setw(8) << nanoseconds / (static_cast<double>(passCount) * FRAME_COUNT) << " ns/frame"
+        << " (checksum=" << checksum << ")" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    const unsigned long passCount = argc > 1 ? std::stoul(argv[1]) : 2000;
+    const auto frames = MakeFrames();
+
+    std::cout << "sizeof(EthernetViewer)=" << sizeof(posnet::EthernetViewer)
+        << " sizeof(IpViewer)=" << sizeof(posnet::IpViewer)
+        << " sizeof(UdpViewer)=" << sizeof(posnet::UdpViewer)
+        << " trivially copyable=" << std::is_trivially_copyable_v<posnet::UdpViewer> << std::endl;
+
+    RunBenchmark("raw: ip source address", frames, passCount, [](const ConstRawFrameViewType frame) -> std::uint64_t {
+        return reinterpret_cast<const struct iphdr*>(frame.data() + sizeof(struct ethhdr))->saddr;
+    });
+    RunBenchmark("raw: udp dest port", frames, passCount, [](const ConstRawFrameViewType frame) -> std::uint64_t {
+        return ntohs(reinterpret_cast<const struct udphdr*>(frame.data() + sizeof(struct ethhdr) + sizeof(struct iphdr))->dest);
+    });
+
+    RunBenchmark("ethernet protocol", frames, passCount, [](const ConstRawFrameViewType frame) -> std::uint64_t {
+        return static_cast<std::uint64_t>(posnet::EthernetViewer(frame).getProtocol());
+    });
+    RunBenchmark("ip source address", frames, passCount, [](const ConstRawFrameViewType frame) -> std::uint64_t {
+        return posnet::IpViewer(posnet::EthernetViewer(frame)).getSourceIpAddress();
+    });
+    RunBenchmark("ip ttl", frames, passCount, [](const ConstRawFrameViewType frame) -> std::uint64_t {
+        return posnet::IpViewer(posnet::EthernetViewer(frame)).getTTL();
+    });
+    RunBenchmark("ip total length", frames, passCount, [](const ConstRawFrameViewType frame) -> std::uint64_t {
+        return posnet::IpViewer(posnet::EthernetViewer(frame)).getTotalLength();
+    });
+    RunBenchmark("udp dest port", frames, passCount, [](const ConstRawFrameViewType frame) -> std::uint64_t {
+        return posnet::UdpViewer(posnet::IpViewer(posnet::EthernetViewer(frame))).getDestPort();
+    });
+    RunBenchmark("udp 5-tuple", frames, passCount, [](const ConstRawFrameViewType frame) -> std::uint64_t {
+        const posnet::IpViewer ipViewer(posnet::EthernetViewer{ frame });
+        const posnet::UdpViewer udpViewer(ipViewer);
+        return ipViewer.getSourceIpAddress() + ipViewer.getDestIpAddress() + static_cast<std::uint64_t>(ipViewer.getProtocol()) +
+            udpViewer.getSourcePort() + udpViewer.getDestPort();
+    });
+    RunBenchmark("validated udp dest port", frames, passCount, [](const ConstRawFrameViewType frame) -> std::uint64_t {
+        const auto ethernetViewer = posnet::EthernetViewer::TryView(frame);
+        if (!ethernetViewer) {
+            return 0;
+        }
+
+        const auto ipPacket = ethernetViewer->getPayload(frame);
+        const auto ipViewer = posnet::IpViewer::TryView(ipPacket);
+        if (!ipViewer) {
+            return 0;
+        }
+
+        const auto udpViewer = posnet::UdpViewer::TryView(ipViewer->getPayload(ipPacket));
+        return udpViewer ? udpViewer->getDestPort() : 0;
+    });
+    RunBenchmark("validated udp 5-tuple", frames, passCount, [](const ConstRawFrameViewType frame) -> std::uint64_t {
+        const auto ethernetViewer = posnet::EthernetViewer::TryView(frame);
+        if (!ethernetViewer) {
+            return 0;
+        }
+
+        const auto ipPacket = ethernetViewer->getPayload(frame);
+        const auto ipViewer = posnet::IpViewer::TryView(ipPacket);
+        if (!ipViewer) {
+            return 0;
+        }
+
+        const auto udpViewer = posnet::UdpViewer::TryView(ipViewer->getPayload(ipPacket));
+        if (!udpViewer) {
+            return 0;
+        }
+        return ipViewer->getSourceIpAddress() + ipViewer->getDestIpAddress() + static_cast<std::uint64_t>(ipViewer->getProtocol()) +
+            udpViewer->getSourcePort() + udpViewer->getDestPort();
+    });
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,96 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <array>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <optional>
+#include <algorithm>
+#include <cassert>
+
+#include "include/net-iface/iface_manager.h"
+#include "include/net-io/capture_group.h"
+
+#include "include/frame-viewers/ethernet_viewer.h"
+
+using ConstRawFrameViewType = posnet::CaptureGroup::ConstRawFrameViewType;
+using SizeType = posnet::CaptureGroup::SizeType;
+
+struct alignas(64) WorkerCounters {
+    std::atomic<std::uint64_t> ipFrames = 0;
+    std::atomic<std::uint64_t> arpFrames = 0;
+    std::atomic<std::uint64_t> otherFrames = 0;
+};
+
+std::optional<std::string> GetDefaultIFaceName(const posnet::IFaceManager& ifaceManager)
+{
+    const auto configs = ifaceManager.getConfigs();
+    const auto it = std::find_if(configs.cbegin(), configs.cend(), [](const posnet::IFaceConfiguration& config) {
+        return (config.getName() && *config.getName() != posnet::IFaceConfiguration::LOOP_BACK_INTERFACE_NAME);
+    });
+
+    return it != configs.cend() ? std::make_optional<std::string>(*(it->getName())) : std::nullopt;
+}
+
+void PrintStatistics(posnet::CaptureGroup& group, const std::vector<WorkerCounters>& counters, std::ostream& os)
+{
+    const auto statistics = group.getStatistics();
+    for (SizeType i = 0; i < statistics.size(); ++i) {
+        os << "worker=" << i
+            << "\thandled=" << statistics[i].handledFrames
+            << "\tdropped=" << statistics[i].ringStatistics.droppedFrames
+            << "\tip=" << counters[i].ipFrames.load(std::memory_order_relaxed)
+            << "\tarp=" << counters[i].arpFrames.load(std::memory_order_relaxed)
+            << "\tother=" << counters[i].otherFrames.load(std::memory_order_relaxed) << "\n";
+    }
+    os << std::endl;
+}
+
+int main(int argc, char** argv) {
+    try {
+        posnet::IFaceManager ifaceManager;
+        const auto defaultIfaceName(GetDefaultIFaceName(ifaceManager));
+        assert(defaultIfaceName);
+        ifaceManager.enablePromiscuousMode(*defaultIfaceName);
+
+        posnet::CaptureGroup::Configuration config;
+        config.mode = posnet::CaptureGroup::FanoutMode::Hash;
+        if (argc > 1) {
+            config.workerCount = std::stoul(argv[1]);
+        }
+
+        posnet::CaptureGroup group(*defaultIfaceName, config);
+        std::vector<WorkerCounters> counters(group.getWorkerCount());
+
+        group.start([&counters](const SizeType workerIndex, const ConstRawFrameViewType frame) {
+            auto& workerCounters = counters[workerIndex];
+            switch (posnet::EthernetViewer(frame).getProtocol()) {
+                using ProtocolType = posnet::EthernetViewer::ProtocolType;
+                case ProtocolType::IP: {
+                    workerCounters.ipFrames.fetch_add(1, std::memory_order_relaxed);
+                    break;
+                }
+                case ProtocolType::ARP: {
+                    workerCounters.arpFrames.fetch_add(1, std::memory_order_relaxed);
+                    break;
+                }
+                default: {
+                    workerCounters.otherFrames.fetch_add(1, std::memory_order_relaxed);
+                    break;
+                }
+            }
+        });
+
+        while (true) {
+            std::this_thread::sleep_for(std::chrono::seconds(1));
+            PrintStatistics(group, counters, std::cout);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    } catch (...) {
+        std::cerr << "Throw unknown exception" << std::endl;
+        return EXIT_FAILURE;
+    }
+}
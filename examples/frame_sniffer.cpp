@@ -2,18 +2,30 @@
 #include <ostream>
 #include <fstream>
 #include <span>
-#include <array>
 #include <optional>
 #include <algorithm>
+#include <chrono>
 #include <stdexcept>
 #include <cstring>
 #include <cassert>
 
+#include <linux/if_packet.h>
 #include <sys/socket.h>
+#include <net/ethernet.h>
+#include <net/if.h>
+#include <arpa/inet.h>
 #include <unistd.h>
 
 #include "include/net-iface/iface_manager.h"
+#include "include/net-io/packet_rx_ring.h"
+#include "include/net-io/batch_receiver.h"
+#include "include/packet-buffer/frame_pool.h"
+#include "include/capture-file/pcap_writer.h"
+#include "include/packet-filter/packet_filter.h"
 #include "include/utils/system_error.h"
+#include "include/utils/scoped_lock.h"
+
+#include "include/frame-dissector/frame_dissector.h"
 
 #include "include/frame-viewers/ethernet_viewer.h"
 #include "include/frame-viewers/ip_viewer.h"
@@ -25,83 +37,109 @@
 using ConstRawFrameViewType = posnet::EthernetViewer::ConstRawFrameViewType;
 using RawFrameViewType = posnet::EthernetViewer::RawFrameViewType;
 
-void PrintTcpFrameInfo(const ConstRawFrameViewType rawFrameBuffer, std::ostream& os) {
-    posnet::TcpViewer tcpViewer(rawFrameBuffer);
+constexpr int REPORT_INTERVAL_IN_MS = 1000;
+
+void PrintTcpFrameInfo(const posnet::ParsedFrame& parsedFrame, std::ostream& os) {
+    posnet::TcpViewer tcpViewer(parsedFrame);
     os << tcpViewer << "\n";
 }
 
-void PrintUdpFrameInfo(const ConstRawFrameViewType rawFrameBuffer, std::ostream& os) {
-    posnet::UdpViewer udpViewer(rawFrameBuffer);
+void PrintUdpFrameInfo(const posnet::ParsedFrame& parsedFrame, std::ostream& os) {
+    posnet::UdpViewer udpViewer(parsedFrame);
     os << udpViewer << "\n";
 }
 
-void PrintIcmpFrameInfo(const ConstRawFrameViewType rawFrameBuffer, std::ostream& os) {
-    posnet::IcmpViewer icmpViewer(rawFrameBuffer);
+void PrintIcmpFrameInfo(const posnet::ParsedFrame& parsedFrame, std::ostream& os) {
+    posnet::IcmpViewer icmpViewer(parsedFrame);
     os << icmpViewer << "\n";
 }
 
-void PrintArpFrameInfo(const ConstRawFrameViewType rawFrameBuffer, std::ostream& os) {
-    posnet::ArpViewer arpViewer(rawFrameBuffer);
+void PrintArpFrameInfo(const posnet::ParsedFrame& parsedFrame, std::ostream& os) {
+    posnet::ArpViewer arpViewer(parsedFrame);
+    if (parsedFrame.etherType == ETHERTYPE_REVARP) {
+        os << "(!RARP frame)";
+    }
     os << arpViewer << "\n";
 }
 
-void PrintRArpFrameInfo(const ConstRawFrameViewType rawFrameBuffer, std::ostream& os) {
-    posnet::ArpViewer arpViewer(rawFrameBuffer);
-    os << "(!RARP frame)" << arpViewer << "\n";
+void PrintIpFrameInfo(const posnet::ParsedFrame& parsedFrame, std::ostream& os) {
+    posnet::IpViewer ipViewer(parsedFrame);
+    os << ipViewer << "\n";
+    if (parsedFrame.hasFlag(posnet::ParsedFrame::Flag::Tcp)) {
+        PrintTcpFrameInfo(parsedFrame, os);
+    } else if (parsedFrame.hasFlag(posnet::ParsedFrame::Flag::Udp)) {
+        PrintUdpFrameInfo(parsedFrame, os);
+    } else if (parsedFrame.hasFlag(posnet::ParsedFrame::Flag::Icmp)) {
+        PrintIcmpFrameInfo(parsedFrame, os);
+    } else {
+        os << "Unknown frame" << "\n";
+    }
 }
 
-void PrintIpFrameInfo(const ConstRawFrameViewType rawFrameBuffer, std::ostream& os) {
-    posnet::IpViewer ipViewer(rawFrameBuffer);
-    os << ipViewer << "\n";
-    switch (ipViewer.getProtocol()) {
-        using ProtocolType = posnet::IpViewer::ProtocolType;
-        case ProtocolType::TCP: {
-            PrintTcpFrameInfo(rawFrameBuffer, os);
-            break;
-        }
-        case ProtocolType::UDP: {
-            PrintUdpFrameInfo(rawFrameBuffer, os);
-            break;
-        }
-        case ProtocolType::ICMP: {
-            PrintIcmpFrameInfo(rawFrameBuffer, os);
-            break;
-        }
-        default: {
-            os << "Unknown frame" << "\n";
-            break;
-        }
+void PrintFrameInfo(const posnet::FrameDissector& dissector, const ConstRawFrameViewType rawFrameBuffer, std::ostream& os) {
+    // The frame is parsed once, the viewers are constructed from the descriptor
+    const auto parsedFrame = dissector.dissect(rawFrameBuffer);
+    os << "----------------------------- RECEIVED A NEW FRAME HEADER START -----------------------------" << "\n";
+    if (parsedFrame.hasFlag(posnet::ParsedFrame::Flag::Truncated)) {
+        os << "(!Truncated frame)" << "\n";
     }
+
+    if (parsedFrame.frameSize >= posnet::EthernetViewer::DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES) {
+        os << posnet::EthernetViewer(parsedFrame) << "\n";
+    }
+
+    if (parsedFrame.hasFlag(posnet::ParsedFrame::Flag::Arp)) {
+        PrintArpFrameInfo(parsedFrame, os);
+    } else if (parsedFrame.hasFlag(posnet::ParsedFrame::Flag::Ip)) {
+        PrintIpFrameInfo(parsedFrame, os);
+    } else {
+        os << "Unknown frame" << "\n";
+    }
+    os << "-----------------------------  RECEIVED A NEW FRAME HEADER END -----------------------------" << "\n\n";
 }
 
+int ParseFrames(const std::string_view ifaceName, const posnet::PacketFilter& filter)
+{
+    posnet::PacketRxRing ring(ifaceName);
+    filter.attachTo(ring.getSocket());
+    const posnet::FrameDissector dissector;
+    while (true) {
+        ring.dispatch([&dissector](const ConstRawFrameViewType frame) {
+            PrintFrameInfo(dissector, frame, std::cout);
+        });
+    }
+}
 
-void PrintFrameInfo(const ConstRawFrameViewType rawFrameBuffer, std::ostream& os) {
-    os << "----------------------------- RECEIVED A NEW FRAME HEADER START -----------------------------" << "\n";
-    posnet::EthernetViewer ethernetViewer(rawFrameBuffer);
-    os << ethernetViewer << "\n";
-    switch (ethernetViewer.getProtocol()) {
-        using ProtocolType = posnet::EthernetViewer::ProtocolType;
-        case ProtocolType::ARP: {
-            PrintArpFrameInfo(rawFrameBuffer, os);
-            break;
-        }
-        case ProtocolType::IP: {
-            PrintIpFrameInfo(rawFrameBuffer, os);
-            break;
-        }
-        case ProtocolType::RARP: {
-            PrintRArpFrameInfo(rawFrameBuffer, os);
-            break;
-        }
-        default: {
-            os << "Unknown frame" << "\n";
-            break;
+int WriteFrames(const std::string_view ifaceName, const std::string_view path, const posnet::PacketFilter& filter)
+{
+    posnet::PcapWriter::Configuration config;
+    if (path.ends_with(".pcapng")) {
+        config.format = posnet::PcapWriter::FormatType::PcapNg;
+    }
+
+    posnet::PacketRxRing ring(ifaceName);
+    filter.attachTo(ring.getSocket());
+    posnet::PcapWriter writer(path, config);
+    auto reportTime = std::chrono::steady_clock::now();
+    while (true) {
+        // The kernel timestamps and the original lengths of the frames are taken from the ring
+        ring.dispatch([&writer](const ConstRawFrameViewType frame, const posnet::PacketRxRing::FrameInfo& info) {
+            (void)writer.write(frame, info.timestamp, info.originalLength);
+        }, REPORT_INTERVAL_IN_MS);
+
+        if (std::chrono::steady_clock::now() - reportTime >= std::chrono::milliseconds(REPORT_INTERVAL_IN_MS)) {
+            // The staged frames reach the disk at least once per report interval
+            writer.flush();
+            const auto statistics = writer.getStatistics();
+            std::cerr << "written frames=" << statistics.writtenFrames << " dropped frames=" << statistics.droppedFrames
+                << " written bytes=" << statistics.writtenBytes << " max flush latency="
+                << std::chrono::duration_cast<std::chrono::microseconds>(statistics.maxFlushLatency).count() << "us" << std::endl;
+            reportTime = std::chrono::steady_clock::now();
         }
     }
-    os << "-----------------------------  RECEIVED A NEW FRAME HEADER END -----------------------------" << "\n\n";
 }
 
-int ParseFrames()
+int ParseFramesByBatches(const std::string_view ifaceName, const posnet::PacketFilter& filter)
 {
     const auto sockfd = socket(AF_PACKET, SOCK_RAW, htons(ETH_P_ALL));
     if (sockfd < 0) {
@@ -109,19 +147,31 @@ int ParseFrames()
         return EXIT_FAILURE;
     }
 
-    std::array<std::uint8_t, 65536> buffer = {0};
-    struct sockaddr sockaddr;
-    socklen_t sockaddrSize = sizeof(sockaddr);
-    std::memset(&sockaddr, 0, sockaddrSize);
-    
+    posnet::utils::ScopedLock socketLock([sockfd] {
+        (void)close(sockfd);
+    });
+
+    // The filter is attached before the socket is bound, so no unfiltered frames are queued
+    filter.attachTo(sockfd);
+
+    const std::string name(ifaceName);
+    struct sockaddr_ll sockAddr;
+    std::memset(&sockAddr, 0, sizeof(sockAddr));
+    sockAddr.sll_family = AF_PACKET;
+    sockAddr.sll_protocol = htons(ETH_P_ALL);
+    sockAddr.sll_ifindex = static_cast<int>(if_nametoindex(name.c_str()));
+    if (sockAddr.sll_ifindex == 0 || bind(sockfd, reinterpret_cast<struct sockaddr*>(&sockAddr), sizeof(sockAddr)) < 0) {
+        perror("Bind Error");
+        return EXIT_FAILURE;
+    }
+
+    posnet::FramePool framePool(posnet::FramePool::Configuration{ .frameCount = posnet::BatchReceiver::DEFAULT_BATCH_SIZE });
+    posnet::BatchReceiver receiver(sockfd, posnet::BatchReceiver::DEFAULT_BATCH_SIZE, framePool);
+    const posnet::FrameDissector dissector;
     while (true) {
-        const std::size_t bufferSize = recvfrom(sockfd, buffer.data(), buffer.size(), 0, &sockaddr, &sockaddrSize);
-        if (bufferSize < 0) {
-            std::cerr << "Failed to get packets" << std::endl;
-            return EXIT_FAILURE;
+        for (const auto frame : receiver.receive()) {
+            PrintFrameInfo(dissector, frame, std::cout);
         }
-
-        PrintFrameInfo(ConstRawFrameViewType{ buffer.data(), bufferSize}, std::cout);
     }
 }
 
@@ -137,7 +187,11 @@ std::optional<std::string> GetDefaultIFaceName(const posnet::IFaceManager& iface
 
 void PrintHelpInfo()
 {
-    
+    std::cout << "Usage: frame_sniffer [--batch | --write <file>] [--filter <expression>]\n"
+        << "\t--batch - receive frames by recvmmsg batches instead of the memory-mapped ring\n"
+        << "\t--write - write frames to the capture file instead of printing them(pcapng if the file has .pcapng extension, pcap otherwise)\n"
+        << "\t--filter - capture only the frames matched by the expression, e.g. \"ip and udp and dst port 53\""
+        << std::endl;
 }
 
 int main(int argc, char** argv) {
@@ -147,7 +201,39 @@ int main(int argc, char** argv) {
         assert(defaultIfaceName);
         ifaceManager.enablePromiscuousMode(*defaultIfaceName);
 
-        return ParseFrames();
+        bool isBatchMode = false;
+        std::optional<std::string_view> path = std::nullopt;
+        std::string_view expression;
+        for (int i = 1; i < argc; ++i) {
+            const std::string_view arg(argv[i]);
+            if (arg == "--batch") {
+                isBatchMode = true;
+            } else if (arg == "--write" && i + 1 < argc) {
+                path = argv[++i];
+            } else if (arg == "--filter" && i + 1 < argc) {
+                expression = argv[++i];
+            } else {
+                PrintHelpInfo();
+                return EXIT_FAILURE;
+            }
+        }
+
+        const auto filter = posnet::PacketFilter::Compile(expression);
+        if (!filter) {
+            std::cerr << "Invalid filter: " << filter.error().message << " at position " << filter.error().position << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        if (isBatchMode && path) {
+            PrintHelpInfo();
+            return EXIT_FAILURE;
+        } else if (isBatchMode) {
+            return ParseFramesByBatches(*defaultIfaceName, *filter);
+        } else if (path) {
+            return WriteFrames(*defaultIfaceName, *path, *filter);
+        }
+
+        return ParseFrames(*defaultIfaceName, *filter);
     } catch (const std::exception& e) {
         std::cerr << e.what() << std::endl;
         return EXIT_FAILURE;
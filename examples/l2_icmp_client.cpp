@@ -13,6 +13,8 @@
 #include "include/frame-builder/ip_builder.h"
 #include "include/frame-builder/icmp_builder.h"
 
+#include "include/packet-buffer/packet_buffer_pool.h"
+
 #include "include/utils/algorithms.h"
 #include "include/utils/scoped_lock.h"
 
@@ -32,9 +34,6 @@ int main() {
     // public ip address 
     constexpr std::string_view GOOG_DNS_SERVER_IP_ADDR("8.8.8.8");
 
-    std::array<posnet::def::ByteType, 1024> buffer = {0};
-    posnet::def::SizeType bufferSize = 0;
-    
     std::string myMacAddr;
     std::string myIpAddr;
 
@@ -64,7 +63,13 @@ int main() {
         myIpAddr = *it->getIpAddress();
     }
 
-    // Building frame
+    // Building frame, the headers are prepended layer by layer into the headroom of one buffer
+    posnet::PacketBufferPool pool(posnet::PacketBufferPool::Configuration{ .bufferCount = 1 });
+    auto buffer = pool.acquire();
+    if (!buffer) {
+        std::cerr << "Could not acquire packet buffer" << std::endl;
+        return EXIT_FAILURE;
+    }
     {
         posnet::EthernetBuilder ethernetBuilder;
         ethernetBuilder.setProtocol(posnet::EthernetBuilder::ProtocolType::IP)
@@ -88,19 +93,10 @@ int main() {
             .setSequenceNumber(1)
             .setCheckSum(posnet::utils::CalcChecksum(icmpBuilder.getAsRawFrameView()));
 
-        ipBuilder.setTotalLength(posnet::IpBuilder::DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES + 
-                                    posnet::IcmpBuilder::DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES);
-        ipBuilder.setCheckSum(posnet::utils::CalcChecksum(ipBuilder.getAsRawFrameView()));
-
-        // filling the buffer
-        std::memcpy(buffer.data() + bufferSize, ethernetBuilder.getStart(), ethernetBuilder.getSize());
-        bufferSize += ethernetBuilder.getSize();
-
-        std::memcpy(buffer.data() + bufferSize, ipBuilder.getStart(), ipBuilder.getSize());
-        bufferSize += ipBuilder.getSize();
-
-        std::memcpy(buffer.data() + bufferSize, icmpBuilder.getStart(), icmpBuilder.getSize());
-        bufferSize += icmpBuilder.getSize();
+        // The total length and the checksum of ip header are set by prependTo
+        icmpBuilder.prependTo(*buffer);
+        ipBuilder.prependTo(*buffer);
+        ethernetBuilder.prependTo(*buffer);
 
 #ifdef DEBUG
         std::cout << ethernetBuilder << std::endl;
@@ -121,7 +117,7 @@ int main() {
     }
     
     // Send the packet
-    if (sendto(sock, buffer.data(), bufferSize, 0, (struct sockaddr*)&sockAddr, sizeof(sockAddr)) == -1) {
+    if (sendto(sock, buffer->getData().data(), buffer->getSize(), 0, (struct sockaddr*)&sockAddr, sizeof(sockAddr)) == -1) {
         perror("sendto");
         return EXIT_FAILURE;
     }
@@ -9,12 +9,16 @@
 
 #include "include/net-iface/iface_manager.h"
 
-#include "include/frame-builder/ethernet_builder.h"
-#include "include/frame-builder/ip_builder.h"
-#include "include/frame-builder/udp_builder.h"
+#include "include/frame-builder/frame_layout.h"
+
+#include "include/frame-viewers/ethernet_viewer.h"
+#include "include/frame-viewers/ip_viewer.h"
+#include "include/frame-viewers/udp_viewer.h"
 
 #include "include/utils/algorithms.h"
 #include "include/utils/scoped_lock.h"
+#include "include/utils/sock_addr_convertor.h"
+#include "include/utils/byte_order.h"
 
 #include <linux/if_packet.h>
 #include <sys/socket.h>
@@ -30,9 +34,6 @@ int main() {
     constexpr std::string_view PAYLOAD("Hello, UDP server!");
     constexpr auto PORT = 12345;
 
-    std::array<posnet::def::ByteType, 1024> buffer = {0};
-    posnet::def::SizeType bufferSize = 0;
-    
     std::string myMacAddr;
     std::string myIpAddr;
 
@@ -62,51 +63,36 @@ int main() {
         myIpAddr = *it->getIpAddress();
     }
 
-    // Building frame
+    // Building frame, the headers are written in place at the offsets computed at compile time
+    posnet::EthernetIpv4UdpLayout::Frame<PAYLOAD.size()> frame;
     {
-        posnet::EthernetBuilder ethernetBuilder;
-        ethernetBuilder.setProtocol(posnet::EthernetBuilder::ProtocolType::IP)
-                .setDestMacAddress(myMacAddr)
-                .setSourceMacAddress(myMacAddr);
-
-        posnet::IpBuilder ipBuilder;
-        ipBuilder.setHeaderLengthInBytes(posnet::IpBuilder::DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES)
-                .setVersion(posnet::IpBuilder::VersionType::V4)
-                .setTypeOfService(0)
-                .setId(0)
-                .setTTL(64)
-                .setProtocol(posnet::IpBuilder::ProtocolType::UDP)
-                .setSourceIpAddress(myIpAddr)
-                .setDestIpAddress(myIpAddr);
-
-        posnet::UdpBuilder udpBuilder;
-        udpBuilder.setSourcePort(PORT + 1)
-                .setDestPort(PORT)
-                .setCheckSum(0)
-                .setUdpDataGramLength(posnet::UdpBuilder::DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES + PAYLOAD.size());
-
-        ipBuilder.setTotalLength(posnet::IpBuilder::DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES + 
-                                    posnet::UdpBuilder::DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES + PAYLOAD.size());
-        ipBuilder.setCheckSum(posnet::utils::CalcChecksum(ipBuilder.getAsRawFrameView()));
-
+        const auto macAddr = posnet::utils::StrToMacAddr(myMacAddr);
+        const auto ipAddr = posnet::utils::StrToIpAddr(myIpAddr);
+        if (!macAddr || !ipAddr) {
+            return EXIT_FAILURE;
+        }
 
-        // filling the buffer
-        std::memcpy(buffer.data() + bufferSize, ethernetBuilder.getStart(), ethernetBuilder.getSize());
-        bufferSize += ethernetBuilder.getSize();
+        auto& ethernetHeader = frame.getHeader<posnet::layer::Ethernet>();
+        std::memcpy(ethernetHeader.h_dest, macAddr->data(), macAddr->size());
+        std::memcpy(ethernetHeader.h_source, macAddr->data(), macAddr->size());
 
-        std::memcpy(buffer.data() + bufferSize, ipBuilder.getStart(), ipBuilder.getSize());
-        bufferSize += ipBuilder.getSize();
+        auto& ipHeader = frame.getHeader<posnet::layer::Ipv4>();
+        ipHeader.saddr = *ipAddr;
+        ipHeader.daddr = *ipAddr;
 
-        std::memcpy(buffer.data() + bufferSize, udpBuilder.getStart(), udpBuilder.getSize());
-        bufferSize += udpBuilder.getSize();
+        auto& udpHeader = frame.getHeader<posnet::layer::Udp>();
+        udpHeader.source = posnet::utils::HostToNetwork16(PORT + 1);
+        udpHeader.dest = posnet::utils::HostToNetwork16(PORT);
 
-        std::memcpy(buffer.data() + bufferSize, PAYLOAD.data(), PAYLOAD.size());
-        bufferSize += PAYLOAD.size();
+        std::memcpy(frame.getPayload().data(), PAYLOAD.data(), PAYLOAD.size());
+        ipHeader.check = posnet::utils::HostToNetwork16(posnet::utils::CalcChecksum(frame.getHeaderView<posnet::layer::Ipv4>()));
 
 #ifdef DEBUG
-        std::cout << ethernetBuilder << std::endl;
-        std::cout << ipBuilder << std::endl;
-        std::cout << udpBuilder << std::endl;
+        const posnet::EthernetViewer ethernetViewer(frame.getAsRawFrameView());
+        const posnet::IpViewer ipViewer(ethernetViewer);
+        std::cout << ethernetViewer << std::endl;
+        std::cout << ipViewer << std::endl;
+        std::cout << posnet::UdpViewer(ipViewer) << std::endl;
 #endif //! DEBUG
     }
 
@@ -122,7 +108,7 @@ int main() {
     }
     
     // Send the packet
-    if (sendto(sock, buffer.data(), bufferSize, 0, (struct sockaddr*)&sockAddr, sizeof(sockAddr)) == -1) {
+    if (sendto(sock, frame.getStart(), frame.getSize(), 0, (struct sockaddr*)&sockAddr, sizeof(sockAddr)) == -1) {
         perror("sendto");
         return EXIT_FAILURE;
     }
@@ -14,6 +14,7 @@
 
 #include "include/frame-builder/ip_builder.h"
 #include "include/frame-builder/udp_builder.h"
+#include "include/frame-builder/frame_chain.h"
 
 #include "include/frame-viewers/ip_viewer.h"
 #include "include/frame-viewers/udp_viewer.h"
@@ -27,8 +28,6 @@ int main() {
     constexpr auto PORT = 12345;
     constexpr std::string_view PAYLOAD("Hello, UDP server!");
 
-    std::array<posnet::def::ByteType, 1024> buffer = {0};
-    posnet::def::SizeType bufferSize = 0;
     struct sockaddr_in sockAddr;
 
     std::string myIpAddr;
@@ -54,43 +53,36 @@ int main() {
         sockAddr.sin_port = htons(PORT);
     }  
 
-    // Building frame
-    {
-        posnet::IpBuilder ipBuilder;
-        ipBuilder.setHeaderLengthInBytes(posnet::IpBuilder::DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES)
-                .setVersion(posnet::IpBuilder::VersionType::V4)
-                .setTypeOfService(0)
-                .setId(0)
-                .setTTL(64)
-                .setProtocol(posnet::IpBuilder::ProtocolType::UDP)
-                .setSourceIpAddress(myIpAddr)
-                .setDestIpAddress(myIpAddr);
-
-        posnet::UdpBuilder udpBuilder;
-        udpBuilder.setSourcePort(PORT + 1)
-                .setDestPort(PORT)
-                .setCheckSum(0)
-                .setUdpDataGramLength(posnet::UdpBuilder::DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES + PAYLOAD.size());
-
-        ipBuilder.setTotalLength(posnet::IpBuilder::DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES + 
-                                    posnet::UdpBuilder::DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES + PAYLOAD.size());
-        ipBuilder.setCheckSum(posnet::utils::CalcChecksum(ipBuilder.getAsRawFrameView()));
-
-        // filling the buffer
-        std:memcpy(buffer.data() + bufferSize, ipBuilder.getStart(), ipBuilder.getSize());
-        bufferSize += ipBuilder.getSize();
-
-        std::memcpy(buffer.data() + bufferSize, udpBuilder.getStart(), udpBuilder.getSize());
-        bufferSize += udpBuilder.getSize();
-
-        std::memcpy(buffer.data() + bufferSize, PAYLOAD.data(), PAYLOAD.size());
-        bufferSize += PAYLOAD.size();
+    // Building frame, the headers stay in the builders and the payload is not copied, they are sent as one iovec chain
+    const posnet::FrameChain::ConstRawFrameViewType payload{ reinterpret_cast<const posnet::def::ByteType*>(PAYLOAD.data()), PAYLOAD.size() };
+
+    posnet::IpBuilder ipBuilder;
+    ipBuilder.setHeaderLengthInBytes(posnet::IpBuilder::DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES)
+            .setVersion(posnet::IpBuilder::VersionType::V4)
+            .setTypeOfService(0)
+            .setId(0)
+            .setTTL(64)
+            .setProtocol(posnet::IpBuilder::ProtocolType::UDP)
+            .setSourceIpAddress(myIpAddr)
+            .setDestIpAddress(myIpAddr)
+            .setTotalLength(posnet::IpBuilder::DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES +
+                            posnet::UdpBuilder::DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES + PAYLOAD.size());
+    ipBuilder.setCheckSum(posnet::utils::CalcChecksum(ipBuilder.getAsRawFrameView()));
+
+    posnet::UdpBuilder udpBuilder;
+    udpBuilder.setSourcePort(PORT + 1)
+            .setDestPort(PORT)
+            .setUdpDataGramLength(posnet::UdpBuilder::DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES + PAYLOAD.size());
+    // The checksum is summed over the header and the payload segments in place
+    udpBuilder.setCheckSum(udpBuilder.calcCheckSum(ipBuilder, std::span(&payload, 1)));
+
+    posnet::FrameChain chain;
+    chain.append(ipBuilder).append(udpBuilder).append(payload);
 
 #ifdef DEBUG
-        std::cout << ipBuilder << std::endl;
-        std::cout << udpBuilder << std::endl;
+    std::cout << ipBuilder << std::endl;
+    std::cout << udpBuilder << std::endl;
 #endif //! DEBUG
-    }
 
     // Create a raw socket
     int sock = socket(AF_INET, SOCK_RAW, IPPROTO_RAW);
@@ -114,8 +106,10 @@ int main() {
     
     
     // Send the packet
-    if (sendto(sock, buffer.data(), bufferSize, 0, (struct sockaddr*)&sockAddr, sizeof(sockAddr)) == -1) {
-        perror("sendto");
+    try {
+        (void)chain.sendTo(sock, reinterpret_cast<const struct sockaddr*>(&sockAddr), sizeof(sockAddr));
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
         return EXIT_FAILURE;
     }
 
@@ -0,0 +1,195 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <optional>
+#include <algorithm>
+#include <cassert>
+#include <csignal>
+
+#include "include/net-iface/iface_manager.h"
+#include "include/net-io/packet_rx_ring.h"
+#include "include/packet-buffer/frame_pool.h"
+#include "include/packet-filter/packet_filter.h"
+#include "include/capture-file/pcap_writer.h"
+#include "include/frame-dissector/frame_dissector.h"
+#include "include/pipeline/pipeline.h"
+
+constexpr int CAPTURE_TIMEOUT_IN_MS = 100;
+constexpr int REPORT_INTERVAL_IN_MS = 1000;
+
+std::atomic<bool> gIsInterrupted = false;
+
+struct alignas(64) ProtocolCounters {
+    std::atomic<std::uint64_t> tcpFrames = 0;
+    std::atomic<std::uint64_t> udpFrames = 0;
+    std::atomic<std::uint64_t> icmpFrames = 0;
+    std::atomic<std::uint64_t> arpFrames = 0;
+    std::atomic<std::uint64_t> otherFrames = 0;
+};
+
+std::optional<std::string> GetDefaultIFaceName(const posnet::IFaceManager& ifaceManager)
+{
+    const auto configs = ifaceManager.getConfigs();
+    const auto it = std::find_if(configs.cbegin(), configs.cend(), [](const posnet::IFaceConfiguration& config) {
+        return (config.getName() && *config.getName() != posnet::IFaceConfiguration::LOOP_BACK_INTERFACE_NAME);
+    });
+
+    return it != configs.cend() ? std::make_optional<std::string>(*(it->getName())) : std::nullopt;
+}
+
+void PrintStatistics(const posnet::Pipeline& pipeline, const ProtocolCounters& counters, std::ostream& os)
+{
+    for (const auto& statistics : pipeline.getStatistics()) {
+        os << std::left << std::setw(10) << statistics.name << std::right
+            << "\tstate=" << posnet::StageStateToStr(statistics.state)
+            << "\tthreads=" << statistics.threadCount
+            << "\tframes=" << statistics.processedFrames
+            << "\tbatches=" << statistics.processedBatches
+            << "\tdropped=" << statistics.droppedFrames
+            << "\tqueue=" << statistics.queueDepth
+            << "\tstall=" << std::chrono::duration_cast<std::chrono::milliseconds>(statistics.stallTime).count() << "ms\n";
+    }
+    os << "tcp=" << counters.tcpFrames.load(std::memory_order_relaxed)
+        << "\tudp=" << counters.udpFrames.load(std::memory_order_relaxed)
+        << "\ticmp=" << counters.icmpFrames.load(std::memory_order_relaxed)
+        << "\tarp=" << counters.arpFrames.load(std::memory_order_relaxed)
+        << "\tother=" << counters.otherFrames.load(std::memory_order_relaxed) << "\n" << std::endl;
+}
+
+void CountProtocol(const posnet::ParsedFrame& parsedFrame, ProtocolCounters& counters)
+{
+    using Flag = posnet::ParsedFrame::Flag;
+    if (parsedFrame.hasFlag(Flag::Tcp)) {
+        counters.tcpFrames.fetch_add(1, std::memory_order_relaxed);
+    } else if (parsedFrame.hasFlag(Flag::Udp)) {
+        counters.udpFrames.fetch_add(1, std::memory_order_relaxed);
+    } else if (parsedFrame.hasFlag(Flag::Icmp)) {
+        counters.icmpFrames.fetch_add(1, std::memory_order_relaxed);
+    } else if (parsedFrame.hasFlag(Flag::Arp)) {
+        counters.arpFrames.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        counters.otherFrames.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void PrintHelpInfo()
+{
+    std::cout << "Usage: pipeline_sniffer [--dissect-threads <count>] [--filter <expression>] [--write <file>]\n"
+        << "\t--dissect-threads - count of the threads of the dissect stage(2 by default)\n"
+        << "\t--filter - pass only the frames matched by the expression to the aggregate and sink stages\n"
+        << "\t--write - write the passed frames to the capture file(pcapng if the file has .pcapng extension, pcap otherwise)\n"
+        << "The pipeline is drained on SIGINT, so all captured frames reach the sink."
+        << std::endl;
+}
+
+int main(int argc, char** argv) {
+    try {
+        posnet::Pipeline::SizeType dissectThreadCount = 2;
+        std::string_view expression;
+        std::optional<std::string_view> path;
+        for (int i = 1; i < argc; ++i) {
+            const std::string_view arg(argv[i]);
+            if (arg == "--dissect-threads" && i + 1 < argc) {
+                dissectThreadCount = std::stoul(argv[++i]);
+            } else if (arg == "--filter" && i + 1 < argc) {
+                expression = argv[++i];
+            } else if (arg == "--write" && i + 1 < argc) {
+                path = argv[++i];
+            } else {
+                PrintHelpInfo();
+                return EXIT_FAILURE;
+            }
+        }
+
+        const auto filter = posnet::PacketFilter::Compile(expression);
+        if (!filter) {
+            std::cerr << "Invalid filter: " << filter.error().message << " at position " << filter.error().position << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        posnet::IFaceManager ifaceManager;
+        const auto defaultIfaceName(GetDefaultIFaceName(ifaceManager));
+        assert(defaultIfaceName);
+        ifaceManager.enablePromiscuousMode(*defaultIfaceName);
+
+        std::optional<posnet::PcapWriter> writer;
+        if (path) {
+            posnet::PcapWriter::Configuration config;
+            if (path->ends_with(".pcapng")) {
+                config.format = posnet::PcapWriter::FormatType::PcapNg;
+            }
+            writer.emplace(*path, config);
+        }
+
+        posnet::PacketRxRing ring(*defaultIfaceName);
+        posnet::FramePool framePool(posnet::FramePool::Configuration{});
+        const posnet::FrameDissector dissector;
+        ProtocolCounters counters;
+
+        posnet::Pipeline pipeline(posnet::Pipeline::Configuration{}, framePool,
+            posnet::Pipeline::CaptureStage{ .handler = [&ring](posnet::Pipeline::CaptureContext& context) {
+                ring.dispatch([&context](const auto frame, const posnet::PacketRxRing::FrameInfo& info) {
+                    (void)context.emit(frame, info);
+                }, CAPTURE_TIMEOUT_IN_MS);
+            } },
+            {
+                posnet::Pipeline::ProcessingStage{ .name = "dissect", .threadCount = dissectThreadCount,
+                    .processor = [&dissector](const std::span<posnet::PipelineFrame> frames) {
+                        for (auto& frame : frames) {
+                            dissector.dissect(frame.descriptor.getAsRawFrameView(), frame.parsedFrame);
+                        }
+                    } },
+                posnet::Pipeline::ProcessingStage{ .name = "filter",
+                    .processor = [&filter](const std::span<posnet::PipelineFrame> frames) {
+                        for (auto& frame : frames) {
+                            frame.isDropped = !filter->match(frame.descriptor.getAsRawFrameView());
+                        }
+                    } },
+                posnet::Pipeline::ProcessingStage{ .name = "aggregate",
+                    .processor = [&counters](const std::span<posnet::PipelineFrame> frames) {
+                        for (const auto& frame : frames) {
+                            CountProtocol(frame.parsedFrame, counters);
+                        }
+                    } },
+                posnet::Pipeline::ProcessingStage{ .name = "sink",
+                    .processor = [&writer](const std::span<posnet::PipelineFrame> frames) {
+                        if (!writer) {
+                            return;
+                        }
+
+                        for (const auto& frame : frames) {
+                            const auto& info = frame.descriptor.info;
+                            (void)writer->write(frame.descriptor.getAsRawFrameView(), info.timestamp, info.originalLength);
+                        }
+                    } },
+            });
+
+        std::signal(SIGINT, [](int) {
+            gIsInterrupted.store(true);
+        });
+
+        pipeline.start();
+        while (!gIsInterrupted.load() && !pipeline.isStopped()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(REPORT_INTERVAL_IN_MS));
+            PrintStatistics(pipeline, counters, std::cout);
+        }
+
+        pipeline.drain();
+        if (writer) {
+            writer->flush();
+        }
+        PrintStatistics(pipeline, counters, std::cout);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    } catch (...) {
+        std::cerr << "Throw unknown exception" << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
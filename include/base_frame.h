@@ -5,6 +5,8 @@
 
 #include <span>
 #include <optional>
+#include <chrono>
+#include <cstdint>
 
 namespace posnet {
 
@@ -15,7 +17,31 @@ public:
     using RawFrameViewType = def::RawFrameViewType;
     using ConstRawFrameViewType = def::ConstRawFrameViewType;
 
-    struct FrameInfo {};
+    /**
+     * @brief The metadata of the received frame, which is reported by the capture backend together with the frame
+     * (tpacket3_hdr of PacketRxRing, PACKET_AUXDATA and SO_TIMESTAMPNS control messages of BatchReceiver).
+     * The fields, which are not reported by the backend, keep their default values.
+     */
+    struct FrameInfo {
+        // The values are equal to sll_pkttype of sockaddr_ll(PACKET_HOST, PACKET_BROADCAST, ...)
+        enum class DirectionType : std::uint8_t {
+            Host = 0,
+            Broadcast = 1,
+            Multicast = 2,
+            OtherHost = 3,
+            Outgoing = 4,
+            Unknown = 0xFF,
+        };
+
+        // Time since the epoch when the kernel received the frame
+        std::chrono::nanoseconds timestamp = std::chrono::nanoseconds::zero();
+        // The length of the frame on the wire, it may be greater than the captured length
+        SizeType originalLength = 0;
+        int ifIndex = 0;
+        // The flow hash computed by the NIC(RSS) or by the kernel
+        std::uint32_t rxHash = 0;
+        DirectionType direction = DirectionType::Unknown;
+    };
 
     explicit BaseFrame(const ByteType* frameStart, SizeType frameSize, std::optional<FrameInfo> info = std::nullopt);
     virtual ~BaseFrame() = 0;
@@ -29,8 +55,7 @@ public:
     ConstRawFrameViewType getAsRawFrameView() const;
     ConstRawFrameViewType getAsRawFrameView();
 
-    std::optional<FrameInfo> getFrameInfo() const;
-    std::optional<FrameInfo> getFrameInfo();
+    const std::optional<FrameInfo>& getFrameInfo() const;
 protected:
     void setFrameSize(SizeType size);
 
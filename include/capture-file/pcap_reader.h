@@ -0,0 +1,129 @@
+#ifndef VS_PCAP_READER_H
+#define VS_PCAP_READER_H
+
+#include "include/base_frame.h"
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <optional>
+#include <chrono>
+#include <cstdint>
+
+namespace posnet {
+
+/**
+ * @brief This class reads the frames from the capture file in pcap or pcapng format.
+ * @details The file is mapped into memory, and the frames are returned as ConstRawFrameViewType pointing directly
+ * into the mapping, so there is no copy per frame. The format, the byte order and the timestamp resolution
+ * are detected by the magic numbers of the file. The timestamps are converted to nanoseconds since the epoch.
+ * For pcapng the Enhanced Packet Blocks and the Simple Packet Blocks are returned, all other blocks are skipped.
+ * @example {
+ *              PcapReader reader("capture.pcap");
+ *              while (const auto record = reader.next()) {
+ *                  EthernetViewer ethernetViewer(record->frame);
+ *                  ...
+ *              }
+ *          }
+ * @warning The frames are valid until the reader is destroyed.
+ * @warning This class IS NOT THREAD SAFE.
+ */
+class PcapReader final {
+public:
+    using ByteType = BaseFrame::ByteType;
+    using SizeType = BaseFrame::SizeType;
+    using ConstRawFrameViewType = BaseFrame::ConstRawFrameViewType;
+    // Time since the epoch
+    using TimestampType = std::chrono::nanoseconds;
+
+    enum class FormatType {
+        Pcap,
+        PcapNg,
+    };
+
+    struct Record {
+        // The captured part of the frame, it may be shorter than the original frame(see snap length)
+        ConstRawFrameViewType frame;
+        TimestampType timestamp;
+        SizeType originalLength;
+        // The index of the interface of pcapng file, it is always zero for pcap
+        std::uint32_t interfaceId;
+    };
+
+    /**
+     * @brief Maps the file and reads its header.
+     * @throw std::runtime_error if the file could not be mapped or it is not a pcap/pcapng file.
+     */
+    explicit PcapReader(std::string_view path);
+    ~PcapReader();
+
+    PcapReader(const PcapReader&) = delete;
+    PcapReader(PcapReader&&) = delete;
+    PcapReader& operator=(const PcapReader&) = delete;
+    PcapReader& operator=(PcapReader&&) = delete;
+
+    /**
+     * @brief Returns the next frame of the file.
+     * @return std::nullopt if the end of the file is reached.
+     * @throw std::runtime_error if the record is malformed.
+     */
+    std::optional<Record> next();
+
+    /**
+     * @brief Calls the callback for every remaining frame of the file.
+     * @return count of the handled frames.
+     */
+    template<typename F>
+    SizeType forEach(F&& callback);
+
+    /**
+     * @brief Rewinds the reader to the first frame of the file.
+     */
+    void reset();
+
+    FormatType getFormat() const;
+    // The link type of the first interface(LINKTYPE_ETHERNET is 1)
+    std::uint16_t getLinkType() const;
+    std::size_t getFileSize() const;
+
+private:
+    struct Interface {
+        std::uint16_t linkType;
+        // The timestamp is converted to nanoseconds as: timestamp * multiplier / divider
+        std::uint64_t multiplier;
+        std::uint64_t divider;
+    };
+
+    void parseFileHeader();
+    std::optional<Record> nextPcapRecord();
+    std::optional<Record> nextPcapNgRecord();
+    void parseInterfaceDescriptionBlock(std::size_t offset, std::uint32_t blockLength);
+
+    std::uint16_t read16(std::size_t offset) const;
+    std::uint32_t read32(std::size_t offset) const;
+
+    std::string m_path;
+    const ByteType* m_data;
+    std::size_t m_size;
+    std::size_t m_offset;
+    std::size_t m_firstRecordOffset;
+    FormatType m_format;
+    bool m_isSwapped;
+    std::uint16_t m_linkType;
+    std::vector<Interface> m_interfaces;
+};
+
+template<typename F>
+inline PcapReader::SizeType PcapReader::forEach(F&& callback)
+{
+    SizeType count = 0;
+    while (const auto record = next()) {
+        callback(*record);
+        ++count;
+    }
+    return count;
+}
+
+} //! namespace posnet
+
+#endif //! VS_PCAP_READER_H
@@ -0,0 +1,155 @@
+#ifndef VS_PCAP_WRITER_H
+#define VS_PCAP_WRITER_H
+
+#include "include/base_frame.h"
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <cstdint>
+
+namespace posnet {
+
+/**
+ * @brief This class writes the frames to the capture file in pcap or pcapng format.
+ * @details The records are staged into large page-aligned buffers by the capture thread. The full buffer is handed over
+ * to the dedicated I/O thread, which writes it to the file by one syscall, while the capture thread continues to fill
+ * the next free buffer. So the capture thread never waits for the disk: if all buffers are waiting for the disk,
+ * the frame is dropped and counted in Statistics::droppedFrames.
+ * The frames longer than the snap length are truncated, the original length is kept in the record.
+ * @example {
+ *              PcapWriter writer("capture.pcapng", PcapWriter::Configuration{ .format = PcapWriter::FormatType::PcapNg });
+ *              ring.dispatch([&writer](const auto frame) {
+ *                  writer.write(frame);
+ *              });
+ *              writer.close();
+ *          }
+ * @warning The methods write, flush and close ARE NOT THREAD SAFE, they have to be called from one capture thread.
+ * getStatistics can be called from any thread.
+ */
+class PcapWriter final {
+public:
+    static constexpr unsigned int DEFAULT_SNAP_LENGTH = 1 << 18;
+    static constexpr unsigned int DEFAULT_BUFFER_SIZE_IN_BYTES = 1 << 22;
+    static constexpr unsigned int DEFAULT_BUFFER_COUNT = 8;
+    static constexpr unsigned int BUFFER_ALIGNMENT_IN_BYTES = 1 << 12;
+    // LINKTYPE_ETHERNET
+    static constexpr std::uint16_t DEFAULT_LINK_TYPE = 1;
+
+    using ByteType = BaseFrame::ByteType;
+    using SizeType = BaseFrame::SizeType;
+    using ConstRawFrameViewType = BaseFrame::ConstRawFrameViewType;
+    // Time since the epoch
+    using TimestampType = std::chrono::nanoseconds;
+
+    enum class FormatType {
+        // Classic pcap with nanosecond timestamps
+        Pcap,
+        // pcapng with one section and one interface, the timestamps are in nanoseconds
+        PcapNg,
+    };
+
+    struct Configuration {
+        FormatType format = FormatType::Pcap;
+        SizeType snapLength = DEFAULT_SNAP_LENGTH;
+        SizeType bufferSizeInBytes = DEFAULT_BUFFER_SIZE_IN_BYTES;
+        SizeType bufferCount = DEFAULT_BUFFER_COUNT;
+        std::uint16_t linkType = DEFAULT_LINK_TYPE;
+    };
+
+    struct Statistics {
+        std::uint64_t writtenFrames = 0;
+        std::uint64_t droppedFrames = 0;
+        std::uint64_t truncatedFrames = 0;
+        // The bytes, which are written to the file(including the headers of the file and the records)
+        std::uint64_t writtenBytes = 0;
+        std::uint64_t flushCount = 0;
+        std::chrono::nanoseconds lastFlushLatency{};
+        std::chrono::nanoseconds maxFlushLatency{};
+        std::chrono::nanoseconds totalFlushLatency{};
+    };
+
+    /**
+     * @brief Creates(or truncates) the file, writes the file header and starts the I/O thread.
+     * @throw std::runtime_error if the file could not be created or the configuration is invalid.
+     */
+    explicit PcapWriter(std::string_view path);
+    explicit PcapWriter(std::string_view path, Configuration config);
+    ~PcapWriter();
+
+    PcapWriter(const PcapWriter&) = delete;
+    PcapWriter(PcapWriter&&) = delete;
+    PcapWriter& operator=(const PcapWriter&) = delete;
+    PcapWriter& operator=(PcapWriter&&) = delete;
+
+    /**
+     * @brief Stages the frame into the current buffer.
+     * @param originalLength - the length of the frame on the wire, it is equal to the frame size if it is zero.
+     * @return false if the frame is dropped because all buffers are waiting for the disk or the writer is closed.
+     */
+    bool write(ConstRawFrameViewType frame, TimestampType timestamp, SizeType originalLength = 0);
+    // The frame is stamped by the current time
+    bool write(ConstRawFrameViewType frame);
+
+    /**
+     * @brief Hands over the current buffer to the I/O thread, it does not wait for the disk. It does nothing after close.
+     */
+    void flush();
+
+    /**
+     * @brief Writes all staged frames, stops the I/O thread and closes the file.
+     * @throw std::runtime_error if the I/O thread could not write the file.
+     */
+    void close();
+
+    Statistics getStatistics() const;
+    const Configuration& getConfiguration() const;
+
+private:
+    struct Buffer {
+        ByteType* data = nullptr;
+        SizeType size = 0;
+    };
+
+    void stageFileHeader();
+    bool reserveRecord(SizeType recordSize);
+    void submitBuffer();
+    void runIOThread();
+    void writeBuffer(const Buffer& buffer);
+
+    Configuration m_config;
+    int m_fd;
+    std::vector<ByteType*> m_storage;
+    Buffer m_current;
+    bool m_hasCurrent;
+    bool m_isClosed;
+
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::deque<Buffer> m_freeBuffers;
+    std::deque<Buffer> m_fullBuffers;
+    bool m_stopRequested;
+    std::exception_ptr m_error;
+    std::thread m_ioThread;
+
+    // The frame counters have the only writer(the capture thread), so they are updated without the atomic read-modify-write
+    std::atomic<std::uint64_t> m_writtenFrames;
+    std::atomic<std::uint64_t> m_droppedFrames;
+    std::atomic<std::uint64_t> m_truncatedFrames;
+    std::atomic<std::uint64_t> m_writtenBytes;
+    std::atomic<std::uint64_t> m_flushCount;
+    std::atomic<std::int64_t> m_lastFlushLatency;
+    std::atomic<std::int64_t> m_maxFlushLatency;
+    std::atomic<std::int64_t> m_totalFlushLatency;
+};
+
+} //! namespace posnet
+
+#endif //! VS_PCAP_WRITER_H
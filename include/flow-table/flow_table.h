@@ -0,0 +1,265 @@
+#ifndef VS_FLOW_TABLE_H
+#define VS_FLOW_TABLE_H
+
+#include "include/base_frame.h"
+#include "include/frame-dissector/parsed_frame.h"
+
+#include <span>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <chrono>
+#include <optional>
+#include <functional>
+#include <cstdint>
+#include <cstddef>
+
+namespace posnet {
+
+class IpViewer;
+class UdpViewer;
+class TcpViewer;
+
+/**
+ * @brief The key of the unidirectional flow: (source ip, dest ip, source port, dest port, ip protocol).
+ * @details Ip-addresses are in network byte order(as IpViewer returns them), the ports are in host byte order.
+ * The ports are zero for the protocols without ports(ICMP, ...).
+ */
+struct FlowKey {
+    using ConstRawFrameViewType = BaseFrame::ConstRawFrameViewType;
+
+    FlowKey() = default;
+    explicit FlowKey(const IpViewer& ipViewer) noexcept;
+    explicit FlowKey(const IpViewer& ipViewer, const UdpViewer& udpViewer) noexcept;
+    explicit FlowKey(const IpViewer& ipViewer, const TcpViewer& tcpViewer) noexcept;
+    /**
+     * @brief The key of the frame, which was parsed by FrameDissector, the frame has to have IP layer.
+     */
+    explicit FlowKey(const ParsedFrame& parsedFrame) noexcept;
+
+    /**
+     * @brief Extracts the key from the whole frame, which starts with Ethernet header, every layer is checked by TryView.
+     * @return std::nullopt if the frame is not IPv4 or it is malformed.
+     */
+    static std::optional<FlowKey> FromFrame(ConstRawFrameViewType frame) noexcept;
+
+    std::uint64_t getHash() const noexcept;
+    // The key of the opposite direction of the flow
+    FlowKey getReversed() const noexcept;
+
+    bool operator==(const FlowKey& other) const noexcept = default;
+
+    std::uint32_t sourceIpAddress = 0;
+    std::uint32_t destIpAddress = 0;
+    std::uint16_t sourcePort = 0;
+    std::uint16_t destPort = 0;
+    std::uint8_t protocol = 0;
+};
+
+static_assert(sizeof(FlowKey) == 16);
+
+/**
+ * @brief The counters of the flow.
+ */
+struct FlowRecord {
+    using TimestampType = std::chrono::nanoseconds;
+
+    FlowKey key;
+    std::uint64_t packetCount = 0;
+    std::uint64_t byteCount = 0;
+    TimestampType firstSeen = TimestampType::zero();
+    TimestampType lastSeen = TimestampType::zero();
+    // The union of the flags of all TCP segments of the flow(FIN, SYN, RST, PSH, ACK, URG, ECE, CWR)
+    std::uint8_t tcpFlags = 0;
+};
+
+/**
+ * @brief This class accounts the packets and the bytes of every flow in the bounded table.
+ * @details The table uses the open addressing with the linear probing. Every flow takes exactly one cache line(the record
+ * and its links of LRU list), and the probing reads the separate array of one byte tags(7 bits of the hash + occupied bit)
+ * first, so the slots of the other flows are not touched during the lookup. The deleted slots are refilled by shifting
+ * the next slots of the probe sequence back(no tombstones), so the lookup does not degrade after many evictions.
+ * The flows are kept in LRU order: the flow, which was not updated for the idle timeout, is evicted by evictIdle,
+ * and the least recently updated flow is evicted when the table is full and a new flow arrives.
+ * The evicted flow is passed to the eviction handler(e.g. to export it).
+ * @example {
+ *              FlowTable table(FlowTable::Configuration{ .maxFlowCount = 1 << 20 }, [](const FlowRecord& record, auto reason) {
+ *                  // export the record
+ *              });
+ *              ring.dispatch([&table](const auto frame, const auto& info) {
+ *                  table.update(frame, info.timestamp, info.originalLength);
+ *              });
+ *              table.evictIdle(now);
+ *          }
+ * @warning This class IS NOT THREAD SAFE: the table has to be updated from one thread(see ShardedFlowTable),
+ * only getStatistics and getFlowCount can be called from any thread.
+ */
+class FlowTable final {
+public:
+    static constexpr unsigned int DEFAULT_MAX_FLOW_COUNT = 1 << 16;
+    static constexpr std::chrono::seconds DEFAULT_IDLE_TIMEOUT = std::chrono::seconds(30);
+
+    using SizeType = BaseFrame::SizeType;
+    using ConstRawFrameViewType = BaseFrame::ConstRawFrameViewType;
+    using TimestampType = FlowRecord::TimestampType;
+
+    struct Configuration {
+        // The memory of the table is allocated once for this count of the flows
+        SizeType maxFlowCount = DEFAULT_MAX_FLOW_COUNT;
+        TimestampType idleTimeout = DEFAULT_IDLE_TIMEOUT;
+    };
+
+    enum class EvictionReason {
+        // The flow was not updated for the idle timeout
+        Idle,
+        // The table was full and the flow was the least recently updated one
+        Capacity,
+        // The table was cleared
+        Clear,
+    };
+
+    struct Statistics {
+        SizeType flowCount = 0;
+        std::uint64_t createdFlows = 0;
+        std::uint64_t idleEvictions = 0;
+        std::uint64_t capacityEvictions = 0;
+        // The frames, which were not accounted by update(frame), because they are not IPv4 or malformed
+        std::uint64_t skippedFrames = 0;
+    };
+
+    using EvictionHandlerType = std::function<void(const FlowRecord&, EvictionReason)>;
+
+    /**
+     * @brief Allocates the table.
+     * @throw std::runtime_error if maxFlowCount is zero or too large.
+     */
+    explicit FlowTable(Configuration config, EvictionHandlerType evictionHandler = EvictionHandlerType{});
+
+    FlowTable(const FlowTable&) = delete;
+    FlowTable(FlowTable&&) = delete;
+    FlowTable& operator=(const FlowTable&) = delete;
+    FlowTable& operator=(FlowTable&&) = delete;
+
+    /**
+     * @brief Accounts the packet of the flow. The flow is created if it is not in the table.
+     * @return the record of the flow, which is valid until the next non-const call.
+     */
+    const FlowRecord& update(const FlowKey& key, SizeType byteCount, TimestampType timestamp, std::uint8_t tcpFlags = 0);
+    /**
+     * @brief Accounts the frame, which starts with Ethernet header.
+     * @param originalLength - the length of the frame on the wire, the size of the frame is used if it is zero.
+     * @return false if the frame was skipped, because it is not IPv4 or it is malformed.
+     */
+    bool update(ConstRawFrameViewType frame, TimestampType timestamp, SizeType originalLength = 0);
+    /**
+     * @brief Accounts the frame, which was parsed by FrameDissector.
+     * @return false if the frame was skipped, because it has no IP layer.
+     */
+    bool update(const ParsedFrame& parsedFrame, TimestampType timestamp);
+
+    // nullptr if the flow is not in the table, the pointer is valid until the next non-const call
+    const FlowRecord* find(const FlowKey& key) const noexcept;
+
+    /**
+     * @brief Evicts all flows, which were not updated since now - idleTimeout.
+     * @return the count of the evicted flows.
+     */
+    SizeType evictIdle(TimestampType now);
+    // Evicts all flows(EvictionReason::Clear)
+    void clear();
+
+    /**
+     * @brief Calls the callback for every flow from the most recently updated one.
+     */
+    template<typename F>
+    void forEachFlow(F&& callback) const;
+
+    SizeType getFlowCount() const noexcept;
+    SizeType getMaxFlowCount() const noexcept;
+    const Configuration& getConfiguration() const noexcept;
+    Statistics getStatistics() const noexcept;
+
+private:
+    static constexpr std::uint32_t NULL_INDEX = UINT32_MAX;
+    static constexpr std::uint8_t EMPTY_TAG = 0;
+
+    struct alignas(64) Slot {
+        FlowRecord record;
+        // The links of LRU list
+        std::uint32_t prev = NULL_INDEX;
+        std::uint32_t next = NULL_INDEX;
+    };
+
+    static_assert(sizeof(Slot) == 64, "The slot has to take exactly one cache line");
+
+    static std::uint8_t GetTag(std::uint64_t hash) noexcept;
+
+    std::uint32_t findIndex(const FlowKey& key, std::uint64_t hash) const noexcept;
+    std::uint32_t insert(const FlowKey& key, std::uint64_t hash, TimestampType timestamp);
+    void evict(std::uint32_t index, EvictionReason reason);
+    void erase(std::uint32_t index) noexcept;
+    void linkFront(std::uint32_t index) noexcept;
+    void unlink(std::uint32_t index) noexcept;
+    void moveSlot(std::uint32_t from, std::uint32_t to) noexcept;
+
+    Configuration m_config;
+    EvictionHandlerType m_evictionHandler;
+    std::uint32_t m_mask;
+    std::vector<std::uint8_t> m_tags;
+    std::vector<Slot> m_slots;
+    // The most recently and the least recently updated flows
+    std::uint32_t m_lruHead;
+    std::uint32_t m_lruTail;
+    // The counters are written only by the owner thread, so they are updated without read-modify-write operations
+    std::atomic<SizeType> m_flowCount;
+    std::atomic<std::uint64_t> m_createdFlows;
+    std::atomic<std::uint64_t> m_idleEvictions;
+    std::atomic<std::uint64_t> m_capacityEvictions;
+    std::atomic<std::uint64_t> m_skippedFrames;
+};
+
+template<typename F>
+inline void FlowTable::forEachFlow(F&& callback) const
+{
+    for (auto index = m_lruHead; index != NULL_INDEX; index = m_slots[index].next) {
+        callback(m_slots[index].record);
+    }
+}
+
+/**
+ * @brief The set of FlowTable, one per capture thread.
+ * @details Every thread updates only its own shard, so the shards do not share any cache line and need no synchronization.
+ * All packets of the flow have to reach the same thread, e.g. the threads serve the sockets of PACKET_FANOUT group
+ * in Hash mode(CaptureGroup with FanoutMode::Hash), otherwise the flow is accounted in several shards.
+ * @example {
+ *              ShardedFlowTable flowTable(group.getWorkerCount(), FlowTable::Configuration{});
+ *              group.start([&flowTable](CaptureGroup::SizeType workerIndex, CaptureGroup::ConstRawFrameViewType frame) {
+ *                  flowTable.getShard(workerIndex).update(frame, timestamp);
+ *              });
+ *          }
+ * @warning The eviction handler is called from the thread, which owns the shard.
+ */
+class ShardedFlowTable final {
+public:
+    using SizeType = FlowTable::SizeType;
+
+    /**
+     * @param configPerShard - the configuration of every shard, the table holds up to shardCount * maxFlowCount flows.
+     * @throw std::runtime_error if shardCount is zero or the configuration is invalid.
+     */
+    explicit ShardedFlowTable(SizeType shardCount, FlowTable::Configuration configPerShard,
+        FlowTable::EvictionHandlerType evictionHandler = FlowTable::EvictionHandlerType{});
+
+    FlowTable& getShard(SizeType index) noexcept;
+    const FlowTable& getShard(SizeType index) const noexcept;
+    SizeType getShardCount() const noexcept;
+    // The sum of the statistics of all shards, it can be called from any thread
+    FlowTable::Statistics getStatistics() const noexcept;
+
+private:
+    std::vector<std::unique_ptr<FlowTable>> m_shards;
+};
+
+} //! namespace posnet
+
+#endif //! VS_FLOW_TABLE_H
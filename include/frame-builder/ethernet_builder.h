@@ -11,7 +11,9 @@
 #include <netinet/ether.h>
 
 namespace posnet {
-    
+
+class PacketBuffer;
+
 class EthernetBuilder final : public BaseFrame {
 public:
     static constexpr unsigned int DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES = EthernetViewer::DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES;
@@ -31,6 +33,12 @@ public:
     EthernetBuilder& setSourceMacAddress(std::string_view macAddr) &;
     EthernetBuilder& setProtocol(ProtocolType protocol) &;
 
+    /**
+     * @brief Writes the header into the headroom of the buffer right before its data.
+     * @throw std::runtime_error if the headroom of the buffer is less than the header.
+     */
+    void prependTo(PacketBuffer& buffer) const;
+
     std::ostream& operator<<(std::ostream& os) const;
     std::ostream& operator<<(std::ostream& os);
 
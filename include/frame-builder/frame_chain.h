@@ -0,0 +1,88 @@
+#ifndef VS_FRAME_CHAIN_H
+#define VS_FRAME_CHAIN_H
+
+#include "include/base_frame.h"
+
+#include <array>
+#include <span>
+#include <cstdint>
+
+#include <sys/uio.h>
+#include <sys/socket.h>
+
+namespace posnet {
+
+/**
+ * @brief This class composes the frame as the chain of iovec segments: the headers are taken from the storage of
+ * the builders(EthernetBuilder, IpBuilder, UdpBuilder, ...) and the payload from the spans owned by the caller,
+ * so the frame is sent by sendmsg/sendmmsg without copying the headers and the payload into one buffer.
+ * @details The segments are kept in the fixed array, so the chain does not allocate memory and it may be
+ * rebuilt for every frame. The checksum of the transport layer can be calculated over the segments by
+ * ChecksumAccumulator(see UdpBuilder::calcCheckSum).
+ * @example {
+ *              udpBuilder.setCheckSum(udpBuilder.calcCheckSum(ipBuilder, payloadSegments));
+ *
+ *              FrameChain chain;
+ *              chain.append(ethernetBuilder).append(ipBuilder).append(udpBuilder);
+ *              for (const auto segment : payloadSegments) {
+ *                  chain.append(segment);
+ *              }
+ *              chain.sendTo(sock, reinterpret_cast<const struct sockaddr*>(&sockAddr), sizeof(sockAddr));
+ *          }
+ * @warning The chain does not own the segments, the builders and the payload have to outlive the sending of the chain.
+ */
+class FrameChain final {
+public:
+    static constexpr unsigned int MAX_SEGMENT_COUNT = 16;
+    // The count of messages, which are passed to one sendmmsg syscall by SendBatch
+    static constexpr unsigned int SEND_BATCH_SIZE = 64;
+
+    using ByteType = BaseFrame::ByteType;
+    using SizeType = BaseFrame::SizeType;
+    using ConstRawFrameViewType = BaseFrame::ConstRawFrameViewType;
+
+    explicit FrameChain() = default;
+
+    FrameChain& append(const BaseFrame& frame) && = delete;
+    FrameChain& append(ConstRawFrameViewType data) && = delete;
+
+    /**
+     * @brief Appends the header of the builder(or any other frame) as the next segment.
+     * @throw std::runtime_error if the chain already has MAX_SEGMENT_COUNT segments.
+     */
+    FrameChain& append(const BaseFrame& frame) &;
+    FrameChain& append(ConstRawFrameViewType data) &;
+
+    /**
+     * @brief Sends the chain as one datagram by sendmsg.
+     * @param address - the destination address, it may be nullptr for the connected socket.
+     * @return count of the sent bytes.
+     * @throw std::runtime_error if sendmsg failed.
+     */
+    SizeType sendTo(int socket, const struct sockaddr* address, socklen_t addressLength, int flags = 0) const;
+
+    /**
+     * @brief Sends the chains as the datagrams to the same address by sendmmsg, SEND_BATCH_SIZE chains per syscall.
+     * @return count of the sent chains, it is less than chains.size() if the non-blocking socket is full.
+     * @throw std::runtime_error if sendmmsg failed.
+     */
+    static SizeType SendBatch(int socket, std::span<const FrameChain> chains, const struct sockaddr* address,
+        socklen_t addressLength, int flags = 0);
+
+    std::span<const struct iovec> getIoVectors() const noexcept;
+    SizeType getSegmentCount() const noexcept;
+    // The total size of all segments
+    SizeType getSize() const noexcept;
+    void clear() noexcept;
+
+private:
+    void fillMessage(struct msghdr& message, const struct sockaddr* address, socklen_t addressLength) const noexcept;
+
+    std::array<struct iovec, MAX_SEGMENT_COUNT> m_ioVectors = {};
+    SizeType m_segmentCount = 0;
+    SizeType m_size = 0;
+};
+
+} //! namespace posnet
+
+#endif //! VS_FRAME_CHAIN_H
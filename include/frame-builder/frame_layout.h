@@ -0,0 +1,382 @@
+#ifndef VS_FRAME_LAYOUT_H
+#define VS_FRAME_LAYOUT_H
+
+#include "include/base_frame.h"
+#include "include/frame-viewers/ethernet_viewer.h"
+#include "include/frame-viewers/ip_viewer.h"
+#include "include/frame-viewers/udp_viewer.h"
+#include "include/frame-viewers/tcp_viewer.h"
+#include "include/frame-viewers/icmp_viewer.h"
+#include "include/utils/byte_order.h"
+
+#include <array>
+#include <tuple>
+#include <utility>
+#include <type_traits>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <cstring>
+#include <cstdint>
+
+#include <net/ethernet.h>
+#include <netinet/in.h>
+
+namespace posnet {
+
+/**
+ * @brief The layers of FrameLayout. Every layer describes the header struct, how the header is initialized
+ * with the protocol of the next layer and which length field of the header covers the rest of the frame.
+ */
+namespace layer {
+
+using SizeType = BaseFrame::SizeType;
+
+// The next layer of the last layer of the layout
+struct None {};
+
+struct Ethernet {
+    using HeaderStructType = EthernetViewer::HeaderStructType;
+
+    template<typename Next>
+    static constexpr void Init(HeaderStructType& header) noexcept
+    {
+        if constexpr (requires { Next::ETHER_TYPE; }) {
+            header.h_proto = utils::HostToNetwork16(Next::ETHER_TYPE);
+        }
+    }
+
+    // Ethernet header has no length field
+    static constexpr void SetLength(HeaderStructType&, SizeType) noexcept {}
+};
+
+struct Ipv4 {
+    using HeaderStructType = IpViewer::HeaderStructType;
+
+    static constexpr std::uint16_t ETHER_TYPE = ETH_P_IP;
+
+    template<typename Next>
+    static constexpr void Init(HeaderStructType& header) noexcept
+    {
+        header.version = 4;
+        header.ihl = sizeof(HeaderStructType) / 4;
+        header.ttl = IpViewer::DEFAULT_FRAME_TTL_VALUE;
+        if constexpr (requires { Next::IP_PROTOCOL; }) {
+            header.protocol = Next::IP_PROTOCOL;
+        }
+    }
+
+    // The total length covers the header and the payload
+    static constexpr void SetLength(HeaderStructType& header, const SizeType length) noexcept
+    {
+        header.tot_len = utils::HostToNetwork16(static_cast<std::uint16_t>(length));
+    }
+};
+
+struct Udp {
+    using HeaderStructType = UdpViewer::HeaderStructType;
+
+    static constexpr std::uint8_t IP_PROTOCOL = IPPROTO_UDP;
+
+    template<typename Next>
+    static constexpr void Init(HeaderStructType&) noexcept {}
+
+    static constexpr void SetLength(HeaderStructType& header, const SizeType length) noexcept
+    {
+        header.len = utils::HostToNetwork16(static_cast<std::uint16_t>(length));
+    }
+};
+
+struct Tcp {
+    using HeaderStructType = TcpViewer::HeaderStructType;
+
+    static constexpr std::uint8_t IP_PROTOCOL = IPPROTO_TCP;
+
+    template<typename Next>
+    static constexpr void Init(HeaderStructType& header) noexcept
+    {
+        header.doff = sizeof(HeaderStructType) / 4;
+    }
+
+    // The length of TCP segment is derived from the total length of ip header
+    static constexpr void SetLength(HeaderStructType&, SizeType) noexcept {}
+};
+
+struct Icmp {
+    using HeaderStructType = IcmpViewer::HeaderStructType;
+
+    static constexpr std::uint8_t IP_PROTOCOL = IPPROTO_ICMP;
+
+    template<typename Next>
+    static constexpr void Init(HeaderStructType&) noexcept {}
+
+    static constexpr void SetLength(HeaderStructType&, SizeType) noexcept {}
+};
+
+} //! namespace layer
+
+template<typename T>
+concept FrameLayer = requires(typename T::HeaderStructType& header) {
+    T::template Init<layer::None>(header);
+    T::SetLength(header, layer::SizeType{});
+};
+
+/**
+ * @brief This class describes the fixed stack of headers(e.g. FrameLayout<layer::Ethernet, layer::Ipv4, layer::Udp>)
+ * and computes the offsets of the headers and the size of the frame at compile time.
+ * @details The headers are written in place into one buffer(FrameLayout::Frame), so building of the frame does not need
+ * the builders of every layer and the copying of their headers at the offsets computed by hand.
+ * The buffer is shifted by FRAME_START_OFFSET_IN_BYTES, so every header is aligned to the alignment of its struct
+ * (for Ethernet + IPv4 it is the same 2 bytes as NET_IP_ALIGN of the kernel).
+ * The constructor of the frame initializes the protocol fields of every layer by the next layer(ether type, ip protocol,
+ * version and header length of ip), and setPayloadLength sets the length fields of all layers at once.
+ * @example {
+ *              using UdpLayout = FrameLayout<layer::Ethernet, layer::Ipv4, layer::Udp>;
+ *              static_assert(UdpLayout::HEADERS_LENGTH_IN_BYTES == 42);
+ *
+ *              UdpLayout::Frame<1458> frame(payload.size());
+ *              frame.getHeader<layer::Udp>().dest = utils::HostToNetwork16(53);
+ *              std::memcpy(frame.getPayload().data(), payload.data(), payload.size());
+ *              auto& ipHeader = frame.getHeader<layer::Ipv4>();
+ *              ipHeader.check = utils::HostToNetwork16(utils::CalcChecksum(frame.getHeaderView<layer::Ipv4>()));
+ *              send(frame.getAsRawFrameView());
+ *          }
+ * @warning The checksums are not calculated by the frame, they depend on the fields set by the caller.
+ */
+template<FrameLayer... Layers>
+class FrameLayout final {
+public:
+    static_assert(sizeof...(Layers) > 0, "The layout has to contain at least one layer");
+
+    using ByteType = BaseFrame::ByteType;
+    using SizeType = BaseFrame::SizeType;
+    using RawFrameViewType = BaseFrame::RawFrameViewType;
+    using ConstRawFrameViewType = BaseFrame::ConstRawFrameViewType;
+
+    static constexpr SizeType LAYER_COUNT = sizeof...(Layers);
+
+    template<SizeType I>
+    using LayerType = std::tuple_element_t<I, std::tuple<Layers...>>;
+
+    template<SizeType I>
+    using HeaderStructType = typename LayerType<I>::HeaderStructType;
+
+private:
+    static constexpr std::array<SizeType, LAYER_COUNT> HEADER_LENGTHS = { sizeof(typename Layers::HeaderStructType)... };
+    static constexpr std::array<SizeType, LAYER_COUNT> HEADER_ALIGNMENTS = { alignof(typename Layers::HeaderStructType)... };
+
+    static constexpr SizeType CalcOffset(const SizeType index) noexcept
+    {
+        SizeType offset = 0;
+        for (SizeType i = 0; i < index; ++i) {
+            offset += HEADER_LENGTHS[i];
+        }
+        return offset;
+    }
+
+    static constexpr SizeType CalcFrameStartOffset() noexcept
+    {
+        for (SizeType startOffset = 0; startOffset < ALIGNMENT_IN_BYTES; ++startOffset) {
+            bool isAligned = true;
+            for (SizeType i = 0; i < LAYER_COUNT; ++i) {
+                isAligned = isAligned && ((startOffset + CalcOffset(i)) % HEADER_ALIGNMENTS[i] == 0);
+            }
+            if (isAligned) {
+                return startOffset;
+            }
+        }
+        return ALIGNMENT_IN_BYTES;
+    }
+
+    template<typename Layer>
+    static constexpr SizeType CalcIndexOf() noexcept
+    {
+        constexpr std::array<bool, LAYER_COUNT> matches = { std::is_same_v<Layer, Layers>... };
+        static_assert(std::count(matches.begin(), matches.end(), true) == 1, "The layer has to be in the layout exactly once");
+        return static_cast<SizeType>(std::find(matches.begin(), matches.end(), true) - matches.begin());
+    }
+
+public:
+    // The buffer of the frame is aligned to the biggest alignment of the header structs
+    static constexpr SizeType ALIGNMENT_IN_BYTES = *std::max_element(HEADER_ALIGNMENTS.begin(), HEADER_ALIGNMENTS.end());
+    static constexpr SizeType HEADERS_LENGTH_IN_BYTES = CalcOffset(LAYER_COUNT);
+    // The offset of the first header from the start of the buffer, which makes every header aligned
+    static constexpr SizeType FRAME_START_OFFSET_IN_BYTES = CalcFrameStartOffset();
+
+    static_assert(FRAME_START_OFFSET_IN_BYTES < ALIGNMENT_IN_BYTES, "The headers of the layout could not be aligned");
+
+    // The offset of the header from the start of the frame
+    template<SizeType I>
+    static constexpr SizeType OFFSET_IN_BYTES = CalcOffset(I);
+
+    template<typename Layer>
+    static constexpr SizeType INDEX_OF = CalcIndexOf<Layer>();
+
+    static constexpr SizeType GetFrameLength(const SizeType payloadLength) noexcept
+    {
+        return HEADERS_LENGTH_IN_BYTES + payloadLength;
+    }
+
+    // The value of the length field of the layer, it covers the header of the layer and everything after it
+    template<SizeType I>
+    static constexpr SizeType GetLayerLength(const SizeType payloadLength) noexcept
+    {
+        return GetFrameLength(payloadLength) - OFFSET_IN_BYTES<I>;
+    }
+
+    /**
+     * @brief The frame of the layout with the room for PAYLOAD_CAPACITY_IN_BYTES bytes of the payload.
+     * @details The frame is a plain buffer without pointers into itself, so it may be copied and moved as a value.
+     */
+    template<SizeType PAYLOAD_CAPACITY_IN_BYTES>
+    class Frame final {
+    public:
+        static constexpr SizeType CAPACITY_IN_BYTES = GetFrameLength(PAYLOAD_CAPACITY_IN_BYTES);
+
+        /**
+         * @brief Zeroes the buffer, initializes the headers and sets the length fields for the payload length.
+         * @throw std::runtime_error if the payload length is greater than the capacity.
+         */
+        explicit Frame(const SizeType payloadLength = PAYLOAD_CAPACITY_IN_BYTES):
+        m_buffer(),
+        m_payloadLength(0)
+        {
+            initHeaders(std::make_index_sequence<LAYER_COUNT>{});
+            setPayloadLength(payloadLength);
+        }
+
+        template<SizeType I>
+        HeaderStructType<I>& getHeader() noexcept
+        {
+            return *reinterpret_cast<HeaderStructType<I>*>(getStart() + OFFSET_IN_BYTES<I>);
+        }
+
+        template<SizeType I>
+        const HeaderStructType<I>& getHeader() const noexcept
+        {
+            return *reinterpret_cast<const HeaderStructType<I>*>(getStart() + OFFSET_IN_BYTES<I>);
+        }
+
+        template<typename Layer>
+        typename Layer::HeaderStructType& getHeader() noexcept
+        {
+            return getHeader<INDEX_OF<Layer>>();
+        }
+
+        template<typename Layer>
+        const typename Layer::HeaderStructType& getHeader() const noexcept
+        {
+            return getHeader<INDEX_OF<Layer>>();
+        }
+
+        // The bytes of the header only(e.g. for the checksum of ip header)
+        template<typename Layer>
+        RawFrameViewType getHeaderView() noexcept
+        {
+            return RawFrameViewType{ getStart() + OFFSET_IN_BYTES<INDEX_OF<Layer>>, sizeof(typename Layer::HeaderStructType) };
+        }
+
+        // The header of the layer and everything after it up to the end of the payload
+        template<typename Layer>
+        RawFrameViewType getLayerView() noexcept
+        {
+            constexpr auto index = INDEX_OF<Layer>;
+            return RawFrameViewType{ getStart() + OFFSET_IN_BYTES<index>, GetLayerLength<index>(m_payloadLength) };
+        }
+
+        RawFrameViewType getPayload() noexcept
+        {
+            return RawFrameViewType{ getStart() + HEADERS_LENGTH_IN_BYTES, m_payloadLength };
+        }
+
+        ConstRawFrameViewType getPayload() const noexcept
+        {
+            return ConstRawFrameViewType{ getStart() + HEADERS_LENGTH_IN_BYTES, m_payloadLength };
+        }
+
+        /**
+         * @brief Sets the length of the payload and the length fields of all layers.
+         * @throw std::runtime_error if the payload length is greater than the capacity.
+         */
+        void setPayloadLength(const SizeType payloadLength)
+        {
+            if (payloadLength > PAYLOAD_CAPACITY_IN_BYTES) {
+                throw std::runtime_error("Payload length=" + std::to_string(payloadLength) +
+                    " is greater than the capacity of the frame=" + std::to_string(PAYLOAD_CAPACITY_IN_BYTES));
+            }
+
+            m_payloadLength = payloadLength;
+            setLengths(std::make_index_sequence<LAYER_COUNT>{});
+        }
+
+        SizeType getPayloadLength() const noexcept
+        {
+            return m_payloadLength;
+        }
+
+        ByteType* getStart() noexcept
+        {
+            return m_buffer.data() + FRAME_START_OFFSET_IN_BYTES;
+        }
+
+        const ByteType* getStart() const noexcept
+        {
+            return m_buffer.data() + FRAME_START_OFFSET_IN_BYTES;
+        }
+
+        SizeType getSize() const noexcept
+        {
+            return GetFrameLength(m_payloadLength);
+        }
+
+        RawFrameViewType getAsRawFrameView() noexcept
+        {
+            return RawFrameViewType{ getStart(), getSize() };
+        }
+
+        ConstRawFrameViewType getAsRawFrameView() const noexcept
+        {
+            return ConstRawFrameViewType{ getStart(), getSize() };
+        }
+
+    private:
+        template<std::size_t... I>
+        void initHeaders(std::index_sequence<I...>) noexcept
+        {
+            (initHeader<I>(), ...);
+        }
+
+        template<SizeType I>
+        void initHeader() noexcept
+        {
+            if constexpr (I + 1 < LAYER_COUNT) {
+                LayerType<I>::template Init<LayerType<I + 1>>(getHeader<I>());
+            } else {
+                LayerType<I>::template Init<layer::None>(getHeader<I>());
+            }
+        }
+
+        template<std::size_t... I>
+        void setLengths(std::index_sequence<I...>) noexcept
+        {
+            (LayerType<I>::SetLength(getHeader<I>(), GetLayerLength<I>(m_payloadLength)), ...);
+        }
+
+        alignas(ALIGNMENT_IN_BYTES) std::array<ByteType, FRAME_START_OFFSET_IN_BYTES + CAPACITY_IN_BYTES> m_buffer;
+        SizeType m_payloadLength;
+    };
+};
+
+using EthernetIpv4UdpLayout = FrameLayout<layer::Ethernet, layer::Ipv4, layer::Udp>;
+using EthernetIpv4IcmpLayout = FrameLayout<layer::Ethernet, layer::Ipv4, layer::Icmp>;
+using Ipv4UdpLayout = FrameLayout<layer::Ipv4, layer::Udp>;
+using Ipv4IcmpLayout = FrameLayout<layer::Ipv4, layer::Icmp>;
+
+static_assert(EthernetIpv4UdpLayout::HEADERS_LENGTH_IN_BYTES == 42);
+static_assert(EthernetIpv4UdpLayout::OFFSET_IN_BYTES<2> == 34);
+static_assert(EthernetIpv4UdpLayout::GetLayerLength<1>(18) == 46);
+static_assert(EthernetIpv4UdpLayout::FRAME_START_OFFSET_IN_BYTES == 2);
+
+} //! namespace posnet
+
+#endif //! VS_FRAME_LAYOUT_H
@@ -0,0 +1,146 @@
+#ifndef VS_FRAME_TEMPLATE_H
+#define VS_FRAME_TEMPLATE_H
+
+#include "include/base_frame.h"
+#include "include/frame-builder/ethernet_builder.h"
+#include "include/frame-builder/ip_builder.h"
+#include "include/frame-builder/udp_builder.h"
+#include "include/frame-builder/icmp_builder.h"
+
+#include <vector>
+#include <span>
+#include <optional>
+#include <type_traits>
+#include <stdexcept>
+#include <string>
+#include <cstdint>
+
+namespace posnet {
+
+/**
+ * @brief This class represents of the frame(Ethernet/IP/UDP, Ethernet/IP/ICMP or the same without Ethernet), which is
+ * serialized once from the builders and then stamped into the copies with a few per-packet fields(ip id, ports, icmp id
+ * and sequence number, the counter in the payload).
+ * @details The constructor concatenates the headers of the builders and the payload, sets the total length of ip header,
+ * the length of udp header and the protocol of ip header, and calculates all checksums over the whole frame.
+ * stamp() copies the frame into the destination and rewrites only the fields of Stamp, which are set. The checksums
+ * of ip and transport layer are fixed by the incremental update(RFC 1624), so the cost of the stamping does not depend
+ * on the size of the payload except the copying.
+ * stampBatch() writes N stamped frames one after another into one contiguous buffer with the stride getStride(),
+ * the frames are ready to be passed to sendmmsg(one iovec per frame, see getBatchFrame) or to be copied into a TX ring.
+ * @example {
+ *              FrameTemplate frameTemplate(ethernetBuilder, ipBuilder, udpBuilder, payload);
+ *              frameTemplate.setPayloadCounterOffset(0);
+ *
+ *              std::vector<FrameTemplate::ByteType> buffer(frameTemplate.getStride() * 64);
+ *              frameTemplate.stampBatch(buffer, 64, [&](FrameTemplate::SizeType i) {
+ *                  return FrameTemplate::Stamp{ .ipId = i, .sourcePort = 10000 + i, .payloadCounter = counter++ };
+ *              });
+ *
+ *              // or directly into the slot of the TX ring
+ *              frameTemplate.stamp(slot->reserve(frameTemplate.getSize()), FrameTemplate::Stamp{ .destPort = 53 });
+ *          }
+ * @warning The fields of the builders are read once by the constructor, the later changes of the builders
+ * do not affect the template.
+ */
+class FrameTemplate final {
+public:
+    // The frames of the batch start at the boundary of the cache line
+    static constexpr unsigned int BATCH_STRIDE_ALIGNMENT_IN_BYTES = 64;
+    static constexpr unsigned int PAYLOAD_COUNTER_LENGTH_IN_BYTES = sizeof(std::uint32_t);
+
+    using ByteType = BaseFrame::ByteType;
+    using SizeType = BaseFrame::SizeType;
+    using RawFrameViewType = BaseFrame::RawFrameViewType;
+    using ConstRawFrameViewType = BaseFrame::ConstRawFrameViewType;
+
+    enum class TransportType {
+        UDP,
+        ICMP,
+    };
+
+    /**
+     * @brief The per-packet fields, the fields, which are not set, keep the values of the template.
+     * The values are in host byte order.
+     */
+    struct Stamp {
+        std::optional<std::uint16_t> ipId = std::nullopt;
+        std::optional<std::uint16_t> sourcePort = std::nullopt;
+        std::optional<std::uint16_t> destPort = std::nullopt;
+        std::optional<std::uint16_t> icmpId = std::nullopt;
+        std::optional<std::uint16_t> icmpSequence = std::nullopt;
+        // It is written at the offset set by setPayloadCounterOffset
+        std::optional<std::uint32_t> payloadCounter = std::nullopt;
+    };
+
+    /**
+     * @brief Serializes the frame from the builders and calculates its checksums.
+     * @throw std::runtime_error if the frame is longer than the total length of ip header allows.
+     */
+    explicit FrameTemplate(const EthernetBuilder& ethernetBuilder, const IpBuilder& ipBuilder, const UdpBuilder& udpBuilder,
+        ConstRawFrameViewType payload);
+    explicit FrameTemplate(const EthernetBuilder& ethernetBuilder, const IpBuilder& ipBuilder, const IcmpBuilder& icmpBuilder,
+        ConstRawFrameViewType payload);
+    // The frames without Ethernet header(e.g. for the raw ip socket)
+    explicit FrameTemplate(const IpBuilder& ipBuilder, const UdpBuilder& udpBuilder, ConstRawFrameViewType payload);
+    explicit FrameTemplate(const IpBuilder& ipBuilder, const IcmpBuilder& icmpBuilder, ConstRawFrameViewType payload);
+
+    FrameTemplate& setPayloadCounterOffset(SizeType offset) && = delete;
+
+    /**
+     * @brief Sets the offset of Stamp::payloadCounter from the start of the payload.
+     * @throw std::runtime_error if the offset is odd(the checksum is updated by 16-bit words) or the counter
+     * does not fit in the payload.
+     */
+    FrameTemplate& setPayloadCounterOffset(SizeType offset) &;
+
+    /**
+     * @brief Copies the template into the frame and stamps the fields of the stamp.
+     * @throw std::runtime_error if the frame is shorter than the template or the stamp has the field,
+     * which the template does not have(e.g. ports of ICMP template).
+     */
+    void stamp(RawFrameViewType frame, const Stamp& stamp) const;
+
+    /**
+     * @brief Writes count stamped frames into the buffer, the frame with index i starts at i * getStride().
+     * @param makeStamp - returns the stamp of the frame with index i.
+     * @throw std::runtime_error if the buffer is shorter than count * getStride().
+     */
+    template<typename F>
+        requires std::is_invocable_r_v<Stamp, F, SizeType>
+    void stampBatch(RawFrameViewType buffer, SizeType count, F&& makeStamp) const
+    {
+        checkBatchBuffer(buffer, count);
+        for (SizeType i = 0; i < count; ++i) {
+            stamp(getBatchFrame(buffer, i), makeStamp(i));
+        }
+    }
+
+    void stampBatch(RawFrameViewType buffer, std::span<const Stamp> stamps) const;
+
+    // The view of the frame with the index in the buffer of stampBatch
+    RawFrameViewType getBatchFrame(RawFrameViewType buffer, SizeType index) const noexcept;
+
+    ConstRawFrameViewType getAsRawFrameView() const noexcept;
+    SizeType getSize() const noexcept;
+    SizeType getStride() const noexcept;
+    TransportType getTransportType() const noexcept;
+    bool hasEthernetHeader() const noexcept;
+
+private:
+    explicit FrameTemplate(const EthernetBuilder* ethernetBuilder, const IpBuilder& ipBuilder, const BaseFrame& transportBuilder,
+        TransportType transportType, ConstRawFrameViewType payload);
+
+    void checkBatchBuffer(RawFrameViewType buffer, SizeType count) const;
+
+    std::vector<ByteType> m_frame;
+    TransportType m_transportType;
+    SizeType m_ipOffset;
+    SizeType m_transportOffset;
+    SizeType m_payloadOffset;
+    std::optional<SizeType> m_payloadCounterOffset;
+};
+
+} //! namespace posnet
+
+#endif //! VS_FRAME_TEMPLATE_H
@@ -7,7 +7,9 @@
 #include <ostream>
 
 namespace posnet {
-    
+
+class PacketBuffer;
+
 class IcmpBuilder final : public BaseFrame {
 public:
     static constexpr auto DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES = IcmpViewer::DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES;
@@ -31,6 +33,12 @@ public:
     IcmpBuilder& setId(unsigned int id) &;
     IcmpBuilder& setSequenceNumber(unsigned int seqNumber) &;
 
+    /**
+     * @brief Writes the header into the headroom of the buffer right before its data.
+     * @throw std::runtime_error if the headroom of the buffer is less than the header.
+     */
+    void prependTo(PacketBuffer& buffer) const;
+
     std::ostream& operator<<(std::ostream& os) const;
     std::ostream& operator<<(std::ostream& os);
 
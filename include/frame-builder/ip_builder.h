@@ -3,12 +3,25 @@
 
 #include "include/base_frame.h"
 #include "include/frame-viewers/ip_viewer.h"
+#include "include/utils/algorithms.h"
 
 #include <string_view>
 #include <ostream>
+#include <cstddef>
+#include <cstdint>
 
 namespace posnet {
-    
+
+class PacketBuffer;
+
+/**
+ * @brief This class builds the header of ip frame.
+ * @details After calcCheckSum every setter keeps the checksum valid by the incremental update(RFC 1624), so the header
+ * does not have to be summed again after rewriting its fields. The checksum, which is set by setCheckSum(e.g. the wrong
+ * one on purpose) or cleared by resetCheckSum, is not tracked: it is written as is until the next calcCheckSum.
+ * @warning The checksum of the transport layer(UDP, TCP) covers the ip-addresses too(pseudo header),
+ * it is not updated by this class.
+ */
 class IpBuilder final : public BaseFrame {
 public:
     static constexpr unsigned int DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES = IpViewer::DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES;
@@ -41,6 +54,8 @@ public:
     ) && = delete;
     IpBuilder& setTTL(unsigned int ttl) && = delete;
     IpBuilder& setCheckSum(unsigned int checkSum) && = delete;
+    IpBuilder& calcCheckSum() && = delete;
+    IpBuilder& resetCheckSum() && = delete;
     IpBuilder& setSourceIpAddress(std::string_view ipAddr) && = delete;
     IpBuilder& setDestIpAddress(std::string_view ipAddr) && = delete;
 
@@ -56,17 +71,49 @@ public:
     ) &;
     IpBuilder& setTTL(unsigned int ttl = DEFAULT_FRAME_TTL_VALUE) &;
     IpBuilder& setCheckSum(unsigned int checkSum) &;
+    // Calculates the checksum over the current fields, it is kept valid by the setters after that
+    IpBuilder& calcCheckSum() &;
+    // Sets the zero checksum, it is not tracked by the setters
+    IpBuilder& resetCheckSum() &;
     IpBuilder& setSourceIpAddress(std::string_view ipAddr) &;
     IpBuilder& setDestIpAddress(std::string_view ipAddr) &;
 
     unsigned int getDefaultCheckSum();
     unsigned int getDefaultCheckSum() const;
 
+    /**
+     * @brief Writes the header into the headroom of the buffer right before its data, which is the payload of the datagram.
+     * @details The total length of the written header is set to the size of the header plus the size of the data.
+     * The checksum of the written header is calculated over its final fields.
+     * The fields of the builder are not changed.
+     * @throw std::runtime_error if the headroom of the buffer is less than the header or the total length exceeds 65535 bytes.
+     */
+    void prependTo(PacketBuffer& buffer) const;
+
     std::ostream& operator<<(std::ostream& os) const;
     std::ostream& operator<<(std::ostream& os);
 
 private:
+    // Returns the 16-bit word of the header, which contains the byte at the offset, in host byte order
+    std::uint16_t getHeaderWord(std::size_t offsetInBytes) const noexcept;
+
+    // Sets the field by the setter and applies the change of its 16-bit word to the checksum
+    template<typename F>
+    void setHeaderField(std::size_t offsetInBytes, F&& setter)
+    {
+        const auto oldWord = getHeaderWord(offsetInBytes);
+        setter();
+        if (m_isCheckSumSet) {
+            m_frame.check = htons(utils::UpdateChecksum16(ntohs(m_frame.check), oldWord, getHeaderWord(offsetInBytes)));
+        }
+    }
+
+    // Ip-addresses are in network byte order
+    void updateCheckSum(std::uint32_t oldIpAddr, std::uint32_t newIpAddr);
+
     HeaderStructType m_frame;
+    // The checksum was calculated by calcCheckSum, so the setters update it
+    bool m_isCheckSumSet;
 };
 
 std::ostream& operator<<(std::ostream& os, const IpBuilder& ipBuilder);
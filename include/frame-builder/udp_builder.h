@@ -5,13 +5,23 @@
 #include "include/frame-viewers/udp_viewer.h"
 
 #include <ostream>
+#include <span>
 #include <sstream>
 #include <stdexcept>
 #include <cstring>
 #include <cstdint>
 
 namespace posnet {
-    
+
+class IpBuilder;
+class PacketBuffer;
+
+/**
+ * @brief This class builds the header of udp frame.
+ * @details If the checksum is already set(non-zero), setSourcePort and setDestPort keep it valid
+ * by the incremental update(RFC 1624), so the payload does not have to be summed again after rewriting the ports.
+ * The zero checksum means that the checksum is not used, so it is left as is.
+ */
 class UdpBuilder final : public BaseFrame {
 public:
     static constexpr auto DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES = UdpViewer::DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES;
@@ -36,10 +46,30 @@ public:
     unsigned int getDefaultCheckSum();
     unsigned int getDefaultCheckSum() const;
 
+    /**
+     * @brief Calculates the checksum of the datagram over the pseudo header(ip-addresses of ipBuilder), this header
+     * and the payload segments, the segments are not copied(see FrameChain).
+     * @details The checksum field of this header is taken as zero and the length of the pseudo header is
+     * the length of this header plus the size of all segments.
+     * @return checksum in host byte order for setCheckSum, the zero checksum is returned as 0xFFFF(RFC 768).
+     */
+    unsigned int calcCheckSum(const IpBuilder& ipBuilder, std::span<const ConstRawFrameViewType> payload) const;
+
+    /**
+     * @brief Writes the header into the headroom of the buffer right before its data, which is the payload of the datagram.
+     * @details The length of the written header is set to the size of the header plus the size of the data.
+     * The checksum is written as is, it has to be calculated by calcCheckSum for the same payload.
+     * @throw std::runtime_error if the headroom of the buffer is less than the header or the length exceeds 65535 bytes.
+     */
+    void prependTo(PacketBuffer& buffer) const;
+
     std::ostream& operator<<(std::ostream& os) const;
     std::ostream& operator<<(std::ostream& os);
 
 private:
+    // Ports are in network byte order
+    void updateCheckSum(std::uint16_t oldPort, std::uint16_t newPort);
+
     HeaderStructType m_frame;
 };
 
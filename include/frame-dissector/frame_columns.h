@@ -0,0 +1,68 @@
+#ifndef VS_FRAME_COLUMNS_H
+#define VS_FRAME_COLUMNS_H
+
+#include "include/frame-dissector/parsed_frame.h"
+
+#include <span>
+#include <vector>
+#include <cstdint>
+
+namespace posnet {
+
+/**
+ * @brief This class represents of the protocol fields of the batch of frames in struct-of-arrays layout.
+ * @details Every field is kept in its own contiguous column, the i-th element of all columns belongs to the i-th frame
+ * of the batch. The analytics, which scan one or two fields over the whole batch, touch only these columns instead of
+ * the whole descriptors. The columns are filled by FrameDissector::dissectBatch.
+ * The fields have the same semantics as the fields of the viewers:
+ * ip-addresses are in network byte order(IpViewer::HeaderStructType::saddr/daddr),
+ * ports are in host byte order(UdpViewer::getSourcePort, TcpViewer::getSourcePort).
+ * The value of the field is zero if the frame has no corresponding layer, see getFlags.
+ * @example {
+ *              FrameColumns columns(batchSize);
+ *              dissector.dissectBatch(frames, columns);
+ *              for (auto i = 0; i < columns.size(); ++i) {
+ *                  bytesPerPort[columns.getDestPorts()[i]] += columns.getPayloadLengths()[i];
+ *              }
+ *          }
+ */
+class FrameColumns final {
+public:
+    using SizeType = ParsedFrame::SizeType;
+
+    explicit FrameColumns();
+    explicit FrameColumns(SizeType capacity);
+
+    void append(const ParsedFrame& parsedFrame);
+    void reserve(SizeType capacity);
+    void clear();
+
+    SizeType size() const;
+    bool empty() const;
+
+    std::span<const std::uint32_t> getSourceIpAddresses() const;
+    std::span<const std::uint32_t> getDestIpAddresses() const;
+    std::span<const std::uint16_t> getSourcePorts() const;
+    std::span<const std::uint16_t> getDestPorts() const;
+    std::span<const std::uint8_t> getIpProtocols() const;
+    std::span<const std::uint8_t> getTcpFlags() const;
+    std::span<const SizeType> getFrameLengths() const;
+    std::span<const std::uint16_t> getPayloadLengths() const;
+    // ParsedFrame::Flag bit masks
+    std::span<const std::uint16_t> getFlags() const;
+
+private:
+    std::vector<std::uint32_t> m_sourceIpAddresses;
+    std::vector<std::uint32_t> m_destIpAddresses;
+    std::vector<std::uint16_t> m_sourcePorts;
+    std::vector<std::uint16_t> m_destPorts;
+    std::vector<std::uint8_t> m_ipProtocols;
+    std::vector<std::uint8_t> m_tcpFlags;
+    std::vector<SizeType> m_frameLengths;
+    std::vector<std::uint16_t> m_payloadLengths;
+    std::vector<std::uint16_t> m_flags;
+};
+
+} //! namespace posnet
+
+#endif //! VS_FRAME_COLUMNS_H
@@ -0,0 +1,57 @@
+#ifndef VS_FRAME_DISSECTOR_H
+#define VS_FRAME_DISSECTOR_H
+
+#include "include/frame-dissector/parsed_frame.h"
+#include "include/frame-dissector/frame_columns.h"
+
+#include <span>
+
+namespace posnet {
+
+/**
+ * @brief This class walks the Ethernet frame once and fills ParsedFrame descriptor.
+ * @details Supported layers: Ethernet(with optional 802.1Q/802.1ad tags), ARP/RARP, IPv4, TCP, UDP, ICMP.
+ * Every header is read exactly once and the length of every header is checked against the size of the frame,
+ * so the descriptor is safe to use even for the truncated frames(see ParsedFrame::Flag::Truncated).
+ * @example {
+ *              FrameDissector dissector;
+ *              ring.dispatch([&dissector](const auto frame) {
+ *                  const auto parsedFrame = dissector.dissect(frame);
+ *                  if (parsedFrame.hasFlag(ParsedFrame::Flag::Udp)) {
+ *                      UdpViewer udpViewer(parsedFrame);
+ *                      ...
+ *                  }
+ *              });
+ *          }
+ */
+class FrameDissector final {
+public:
+    using ConstRawFrameViewType = ParsedFrame::ConstRawFrameViewType;
+
+    struct Configuration {
+        // If it is false, the tagged frames are not parsed beyond Ethernet layer
+        bool parseVlan = true;
+    };
+
+    explicit FrameDissector();
+    explicit FrameDissector(Configuration config);
+
+    ParsedFrame dissect(ConstRawFrameViewType frame) const;
+    void dissect(ConstRawFrameViewType frame, ParsedFrame& parsedFrame) const;
+
+    /**
+     * @brief Dissects the batch of frames and appends their fields to the columns.
+     * @details The headers of the upcoming frames are prefetched while the current frame is parsed,
+     * so the cache misses of the batch are overlapped.
+     */
+    void dissectBatch(std::span<const ConstRawFrameViewType> frames, FrameColumns& columns) const;
+
+    const Configuration& getConfiguration() const;
+
+private:
+    Configuration m_config;
+};
+
+} //! namespace posnet
+
+#endif //! VS_FRAME_DISSECTOR_H
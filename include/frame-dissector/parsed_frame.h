@@ -0,0 +1,85 @@
+#ifndef VS_PARSED_FRAME_H
+#define VS_PARSED_FRAME_H
+
+#include "include/definitions.h"
+
+#include <cstdint>
+
+namespace posnet {
+
+/**
+ * @brief This struct represents of the descriptor of the frame, which is filled by FrameDissector in one pass.
+ * @details The descriptor takes exactly one cache line. It keeps the offsets of all layers from the start of
+ * the frame and the most used fields of the headers, so the viewers are constructed from it in O(1) and
+ * the hot path does not have to parse the headers again.
+ * The offset(and the fields) of the layer is valid only if the corresponding flag is set.
+ * @warning The descriptor does not own the frame, the frame has to outlive it.
+ */
+struct alignas(64) ParsedFrame {
+    using ByteType = def::ByteType;
+    using SizeType = def::SizeType;
+    using ConstRawFrameViewType = def::ConstRawFrameViewType;
+
+    enum class Flag : std::uint16_t {
+        Vlan = 1 << 0,
+        Ip = 1 << 1,
+        Arp = 1 << 2,
+        Tcp = 1 << 3,
+        Udp = 1 << 4,
+        Icmp = 1 << 5,
+        // The frame is a fragment of ip datagram, l4 layer is parsed only for the first fragment
+        Fragment = 1 << 6,
+        // The frame is shorter than its headers claim, the parsing was stopped on the truncated layer
+        Truncated = 1 << 7,
+    };
+
+    bool hasFlag(const Flag flag) const
+    {
+        return (flags & static_cast<std::uint16_t>(flag)) != 0;
+    }
+
+    void setFlag(const Flag flag)
+    {
+        flags |= static_cast<std::uint16_t>(flag);
+    }
+
+    const ByteType* getL2Start() const { return frame + l2Offset; }
+    const ByteType* getL3Start() const { return frame + l3Offset; }
+    const ByteType* getL4Start() const { return frame + l4Offset; }
+
+    ConstRawFrameViewType getFrame() const
+    {
+        return ConstRawFrameViewType{ frame, frameSize };
+    }
+
+    ConstRawFrameViewType getPayload() const
+    {
+        return ConstRawFrameViewType{ frame + payloadOffset, payloadLength };
+    }
+
+    const ByteType* frame = nullptr;
+    SizeType frameSize = 0;
+    // Ip-addresses are in network byte order
+    std::uint32_t sourceIpAddress = 0;
+    std::uint32_t destIpAddress = 0;
+    std::uint16_t l2Offset = 0;
+    std::uint16_t l3Offset = 0;
+    std::uint16_t l4Offset = 0;
+    std::uint16_t payloadOffset = 0;
+    // The payload does not include the padding of Ethernet frame
+    std::uint16_t payloadLength = 0;
+    // All fields below are in host byte order
+    std::uint16_t etherType = 0;
+    std::uint16_t vlanId = 0;
+    std::uint16_t sourcePort = 0;
+    std::uint16_t destPort = 0;
+    std::uint16_t flags = 0;
+    std::uint8_t ipProtocol = 0;
+    std::uint8_t tcpFlags = 0;
+};
+
+static_assert(sizeof(ParsedFrame) == 64, "ParsedFrame has to take exactly one cache line");
+
+} //! namespace posnet
+
+#endif //! VS_PARSED_FRAME_H
@@ -1,12 +1,15 @@
 #ifndef VS_ARP_VIEWER_H
 #define VS_ARP_VIEWER_H
 
-#include "include/base_frame.h"
+#include "include/frame-viewers/base_viewer.h"
+#include "include/frame-dissector/parsed_frame.h"
 #include "include/frame-viewers/ethernet_viewer.h"
+#include "include/utils/byte_order.h"
 
 #include <string>
 #include <string_view>
 #include <ostream>
+#include <stdexcept>
 
 namespace posnet {
 
@@ -29,23 +32,21 @@ namespace posnet {
  * The tha (Target Hardware Address) field contains the hardware address of the intended receiver, and the tpa (Target Protocol Address) 
  * field contains the protocol address of the intended receiver.
  */
-class ArpViewer final : public BaseFrame {
+struct ArpHeader {
+    uint16_t hardwareType;
+    uint16_t protoType;
+    uint8_t hardwareLen;
+    uint8_t protoLen;
+    uint16_t opcode;
+    uint8_t senderMac[6];
+    uint8_t senderIp[4];
+    uint8_t targetMac[6];
+    uint8_t targetIp[4];
+};
+
+class ArpViewer final : public BaseViewer<ArpViewer, struct ArpHeader> {
 public:
-    struct ArpHeader {
-        uint16_t hardwareType;
-        uint16_t protoType;
-        uint8_t hardwareLen;
-        uint8_t protoLen;
-        uint16_t opcode;
-        uint8_t senderMac[6];
-        uint8_t senderIp[4];
-        uint8_t targetMac[6];
-        uint8_t targetIp[4];
-    };
     static constexpr unsigned int DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES = sizeof(struct ArpHeader);
-    using RawFrameViewType = EthernetViewer::RawFrameViewType;
-    using ConstRawFrameViewType = EthernetViewer::ConstRawFrameViewType;
-    using HeaderStructType = struct ArpHeader;
 
     enum class HardwareType {
         ARP, 
@@ -67,39 +68,103 @@ public:
         Undefined,
     };
 
-    explicit ArpViewer(EthernetViewer ethernetViewer);
-    explicit ArpViewer(RawFrameViewType rawFrame);
-    explicit ArpViewer(ConstRawFrameViewType rawFrame);
-
-    HardwareType getHardwareType();
-    std::string_view getHardwareTypeAsStr();
-    ProtocolType getProtocolType();
-    std::string_view getProtocolTypeAsStr();
-    OpcodeType getOpcode();
-    std::string_view getOpcodeAsStr();
-    std::string getSenderMacAddressAsStr();
-    std::string getTargetMacAddressAsStr();
-    std::string getSenderIpAddressAsStr();
-    std::string getTargetIpAddressAsStr();
-    std::uint8_t* getFrameHeaderStart();
-    
-    HardwareType getHardwareType() const;
+    using TryViewResultType = utils::Result<ArpViewer, ParseError>;
+
+    /**
+     * @brief Constructs the viewer after checking the view, the view starts with the header.
+     * @return the viewer or the reason why the view is malformed.
+     */
+    static TryViewResultType TryView(ConstRawFrameViewType view) noexcept;
+
+    explicit ArpViewer(EthernetViewer ethernetViewer) noexcept;
+    explicit ArpViewer(ConstRawFrameViewType rawFrame) noexcept;
+    /**
+     * @brief Constructs the viewer from the descriptor of FrameDissector in O(1).
+     * @throw std::runtime_error if the frame has no ARP layer.
+     */
+    explicit ArpViewer(const ParsedFrame& parsedFrame);
+
+    HardwareType getHardwareType() const noexcept;
     std::string_view getHardwareTypeAsStr() const;
-    ProtocolType getProtocolType() const;
+    ProtocolType getProtocolType() const noexcept;
     std::string_view getProtocolTypeAsStr() const;
-    OpcodeType getOpcode() const;
+    OpcodeType getOpcode() const noexcept;
     std::string_view getOpcodeAsStr() const;
     std::string getSenderMacAddressAsStr() const;
     std::string getTargetMacAddressAsStr() const;
     std::string getSenderIpAddressAsStr() const;
     std::string getTargetIpAddressAsStr() const;
+    unsigned int getHeaderLengthInBytes() const noexcept;
 
     std::ostream& operator<<(std::ostream& os) const;
-
-private:
-    HeaderStructType* m_frame;
 };
 
+static_assert(FrameViewer<ArpViewer>);
+
+inline ArpViewer::TryViewResultType ArpViewer::TryView(const ConstRawFrameViewType view) noexcept
+{
+    if (view.size() < DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES) {
+        return TryViewResultType::onError(ParseError::TooShort);
+    }
+
+    // Only Ethernet/IPv4 addresses are described by ArpHeader
+    const auto header = reinterpret_cast<const HeaderStructType*>(view.data());
+    if ((header->hardwareLen != sizeof(header->senderMac)) | (header->protoLen != sizeof(header->senderIp))) {
+        return TryViewResultType::onError(ParseError::InvalidHeaderLength);
+    }
+    return TryViewResultType::onOk(ArpViewer(view));
+}
+
+inline ArpViewer::ArpViewer(const EthernetViewer ethernetViewer) noexcept:
+BaseViewer(ethernetViewer.getPayloadStart(), ethernetViewer.getFrameInfo())
+{}
+
+inline ArpViewer::ArpViewer(const ConstRawFrameViewType rawFrame) noexcept:
+BaseViewer(rawFrame.data(), nullptr)
+{}
+
+inline ArpViewer::ArpViewer(const ParsedFrame& parsedFrame):
+BaseViewer(parsedFrame.getL3Start(), nullptr)
+{
+    if (!parsedFrame.hasFlag(ParsedFrame::Flag::Arp)) {
+        throw std::runtime_error("Could not view ARP frame: the frame has no ARP layer");
+    }
+}
+
+inline ArpViewer::HardwareType ArpViewer::getHardwareType() const noexcept
+{
+    switch (utils::NetworkToHost16(getHeader()->hardwareType)) {
+        case 1: return HardwareType::ARP;
+        case 0: return HardwareType::RARP;
+        default:
+            return HardwareType::Undefined;
+    }
+}
+
+inline ArpViewer::ProtocolType ArpViewer::getProtocolType() const noexcept
+{
+    return (utils::NetworkToHost16(getHeader()->protoType) == 0x0800 ? ProtocolType::V4 : ProtocolType::V6);
+}
+
+inline ArpViewer::OpcodeType ArpViewer::getOpcode() const noexcept
+{
+    switch (utils::NetworkToHost16(getHeader()->opcode)) {
+        case 1: return OpcodeType::ArpRequest;
+        case 2: return OpcodeType::ArpReply;
+        case 3: return OpcodeType::RArpRequest;
+        case 4: return OpcodeType::RArpReply;
+        case 8: return OpcodeType::InArpRequest;
+        case 9: return OpcodeType::InArpReply;
+        default:
+            return OpcodeType::Undefined;
+    }
+}
+
+inline unsigned int ArpViewer::getHeaderLengthInBytes() const noexcept
+{
+    return DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES;
+}
+
 std::ostream& operator<<(std::ostream& os, const ArpViewer& arpViewer);
 
 } //! namespace posnet
@@ -0,0 +1,127 @@
+#ifndef VS_BASE_VIEWER_H
+#define VS_BASE_VIEWER_H
+
+#include "include/base_frame.h"
+#include "include/utils/result.h"
+
+#include <string_view>
+#include <type_traits>
+#include <concepts>
+#include <cstdint>
+
+namespace posnet {
+
+/**
+ * @brief The reason why TryView of the viewer rejected the view.
+ */
+enum class ParseError : std::uint8_t {
+    // The view is shorter than the fixed part of the header
+    TooShort,
+    // The version of IP header is not 4
+    InvalidVersion,
+    // IHL of IP header or doff of TCP header is too small, or the header does not fit in the view
+    InvalidHeaderLength,
+    // The total length of IP header or the length of UDP header does not match the view
+    InvalidLength,
+};
+
+constexpr std::string_view ParseErrorToStr(const ParseError error) noexcept
+{
+    switch (error) {
+        case ParseError::TooShort: return "TooShort";
+        case ParseError::InvalidVersion: return "InvalidVersion";
+        case ParseError::InvalidHeaderLength: return "InvalidHeaderLength";
+        case ParseError::InvalidLength: return "InvalidLength";
+        default:
+            return "Undefined";
+    }
+}
+
+/**
+ * @brief This class is the base of the viewers(CRTP), it holds only the pointer to the header and the pointer to the metadata
+ * of the frame, so every viewer is a trivially copyable object of two pointers, which is passed in registers.
+ * @details The base has no virtual functions, and the numeric accessors of the viewers are defined inline in their headers,
+ * so the chain like UdpViewer(IpViewer(EthernetViewer(frame))).getDestPort() is compiled to a few loads.
+ * The derived viewer provides getHeaderLengthInBytes(), which is used to find the start of the next layer(getPayloadStart).
+ * The constructors trust the view, the frames from the wire have to be viewed by TryView of the viewer, which checks
+ * the lengths of the header against the view and returns ParseError instead of reading out of bounds.
+ * @example {
+ *              const auto ethernetViewer = EthernetViewer::TryView(frame);
+ *              if (!ethernetViewer) {
+ *                  return;
+ *              }
+ *              const auto ipPacket = ethernetViewer->getPayload(frame);
+ *              const auto ipViewer = IpViewer::TryView(ipPacket);
+ *              if (ipViewer) {
+ *                  const auto udpViewer = UdpViewer::TryView(ipViewer->getPayload(ipPacket));
+ *              }
+ *          }
+ * @warning The viewer does not own the frame and the metadata, they have to outlive the viewer.
+ */
+template<typename Derived, typename HeaderStruct>
+class BaseViewer {
+public:
+    using ByteType = BaseFrame::ByteType;
+    using SizeType = BaseFrame::SizeType;
+    using RawFrameViewType = BaseFrame::RawFrameViewType;
+    using ConstRawFrameViewType = BaseFrame::ConstRawFrameViewType;
+    using FrameInfo = BaseFrame::FrameInfo;
+    using HeaderStructType = HeaderStruct;
+
+    const ByteType* getFrameHeaderStart() const noexcept
+    {
+        return reinterpret_cast<const ByteType*>(m_header);
+    }
+
+    // The start of the header of the next layer
+    const ByteType* getPayloadStart() const noexcept
+    {
+        return getFrameHeaderStart() + static_cast<const Derived&>(*this).getHeaderLengthInBytes();
+    }
+
+    /**
+     * @brief Returns the part of the view after the header.
+     * @param view - the view, which starts with the header of this viewer and which was checked by TryView.
+     */
+    ConstRawFrameViewType getPayload(const ConstRawFrameViewType view) const noexcept
+    {
+        return view.subspan(static_cast<const Derived&>(*this).getHeaderLengthInBytes());
+    }
+
+    // nullptr if the viewer was constructed without the metadata
+    const FrameInfo* getFrameInfo() const noexcept
+    {
+        return m_info;
+    }
+
+protected:
+    BaseViewer(const ByteType* const headerStart, const FrameInfo* const info) noexcept:
+    m_header(reinterpret_cast<const HeaderStructType*>(headerStart)),
+    m_info(info)
+    {}
+
+    ~BaseViewer() = default;
+
+    const HeaderStructType* getHeader() const noexcept
+    {
+        return m_header;
+    }
+
+private:
+    const HeaderStructType* m_header;
+    const FrameInfo* m_info;
+};
+
+/**
+ * @brief The requirements of the viewer, every viewer is checked by static_assert in its header.
+ */
+template<typename T>
+concept FrameViewer = std::is_trivially_copyable_v<T> && sizeof(T) == 2 * sizeof(void*) &&
+    requires(const T viewer) {
+        { viewer.getFrameHeaderStart() } -> std::same_as<const BaseFrame::ByteType*>;
+        { viewer.getHeaderLengthInBytes() } -> std::convertible_to<unsigned int>;
+    };
+
+} //! namespace posnet
+
+#endif //! VS_BASE_VIEWER_H
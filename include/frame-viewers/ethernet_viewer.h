@@ -1,11 +1,14 @@
 #ifndef VS_ETHERNET_VIEWER_H
 #define VS_ETHERNET_VIEWER_H
 
-#include "include/base_frame.h"
+#include "include/frame-viewers/base_viewer.h"
+#include "include/frame-dissector/parsed_frame.h"
+#include "include/utils/byte_order.h"
 
 #include <string>
 #include <string_view>
 #include <ostream>
+#include <stdexcept>
 
 #include <netinet/ether.h>
 
@@ -25,12 +28,9 @@ namespace posnet {
  * For example, if the value is 0x0800, it indicates that the payload is an IP packet. If the value is 0x0806, it indicates that the payload is an ARP packet. 
  * Other values are used for other types of encapsulated protocols.
  */
-class EthernetViewer final : public BaseFrame {
+class EthernetViewer final : public BaseViewer<EthernetViewer, struct ethhdr> {
 public:
     static constexpr unsigned int DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES = sizeof(struct ethhdr);
-    using RawFrameViewType = BaseFrame::RawFrameViewType; 
-    using ConstRawFrameViewType = BaseFrame::ConstRawFrameViewType;
-    using HeaderStructType = struct ethhdr;
 
     enum class ProtocolType {
         IP,
@@ -39,26 +39,83 @@ public:
         Undefined,
     };
 
-    explicit EthernetViewer(ConstRawFrameViewType rawFrame);
+    using TryViewResultType = utils::Result<EthernetViewer, ParseError>;
 
-    std::string getDestMacAddressAsStr();
-    std::string getSourceMacAddressAsStr();
-    ProtocolType getProtocol();
-    std::string_view getProtocolAsStr();
+    /**
+     * @brief Constructs the viewer after checking the view, the view starts with the header.
+     * @return the viewer or the reason why the view is malformed.
+     */
+    static TryViewResultType TryView(ConstRawFrameViewType view) noexcept;
+
+    explicit EthernetViewer(ConstRawFrameViewType rawFrame) noexcept;
+    /**
+     * @brief Constructs the viewer with the metadata of the frame, the metadata is passed to the viewers of upper layers.
+     */
+    explicit EthernetViewer(ConstRawFrameViewType rawFrame, const FrameInfo& info) noexcept;
+    /**
+     * @brief Constructs the viewer from the descriptor of FrameDissector in O(1).
+     * @throw std::runtime_error if the frame is shorter than Ethernet header.
+     */
+    explicit EthernetViewer(const ParsedFrame& parsedFrame);
 
     std::string getDestMacAddressAsStr() const;
     std::string getSourceMacAddressAsStr() const;
-    ProtocolType getProtocol() const;
+    ProtocolType getProtocol() const noexcept;
     std::string_view getProtocolAsStr() const;
-
-    std::uint8_t* getFrameHeaderStart();
+    // The raw ether type in host byte order
+    std::uint16_t getEtherType() const noexcept;
+    unsigned int getHeaderLengthInBytes() const noexcept;
 
     std::ostream& operator<<(std::ostream& os) const;
-
-private:
-    HeaderStructType *m_frame;
 };
 
+static_assert(FrameViewer<EthernetViewer>);
+
+inline EthernetViewer::TryViewResultType EthernetViewer::TryView(const ConstRawFrameViewType view) noexcept
+{
+    if (view.size() < DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES) {
+        return TryViewResultType::onError(ParseError::TooShort);
+    }
+    return TryViewResultType::onOk(EthernetViewer(view));
+}
+
+inline EthernetViewer::EthernetViewer(const ConstRawFrameViewType rawFrame) noexcept:
+BaseViewer(rawFrame.data(), nullptr)
+{}
+
+inline EthernetViewer::EthernetViewer(const ConstRawFrameViewType rawFrame, const FrameInfo& info) noexcept:
+BaseViewer(rawFrame.data(), &info)
+{}
+
+inline EthernetViewer::EthernetViewer(const ParsedFrame& parsedFrame):
+BaseViewer(parsedFrame.frame, nullptr)
+{
+    if (parsedFrame.frameSize < DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES) {
+        throw std::runtime_error("Could not view Ethernet frame: frame size=" + std::to_string(parsedFrame.frameSize));
+    }
+}
+
+inline EthernetViewer::ProtocolType EthernetViewer::getProtocol() const noexcept
+{
+    switch (getEtherType()) {
+        case ETH_P_IP: return ProtocolType::IP;
+        case ETH_P_ARP: return ProtocolType::ARP;
+        case ETH_P_RARP: return ProtocolType::RARP;
+        default:
+            return ProtocolType::Undefined;
+    }
+}
+
+inline std::uint16_t EthernetViewer::getEtherType() const noexcept
+{
+    return utils::NetworkToHost16(getHeader()->h_proto);
+}
+
+inline unsigned int EthernetViewer::getHeaderLengthInBytes() const noexcept
+{
+    return DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES;
+}
+
 std::ostream& operator<<(std::ostream& os, const EthernetViewer& ethernetViewer);
 
 } //! namespace posnet
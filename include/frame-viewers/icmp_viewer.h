@@ -1,10 +1,13 @@
 #ifndef VS_ICMP_VIEWER_H
 #define VS_ICMP_VIEWER_H
 
-#include "include/base_frame.h"
+#include "include/frame-viewers/base_viewer.h"
+#include "include/frame-dissector/parsed_frame.h"
 #include "include/frame-viewers/ip_viewer.h"
+#include "include/utils/byte_order.h"
 
 #include <ostream>
+#include <stdexcept>
 #include <string>
 #include <string_view>
 
@@ -24,12 +27,9 @@ namespace posnet {
  * un: A union that contains various fields depending on the type of the ICMP message. 
  * For example, for ICMP_ECHO and ICMP_ECHOREPLY, it contains the identifier and sequence number.
  */
-class IcmpViewer final : public BaseFrame {
+class IcmpViewer final : public BaseViewer<IcmpViewer, struct icmphdr> {
 public:
     static constexpr unsigned int DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES = sizeof(struct icmphdr);
-    using RawFrameViewType = IpViewer::RawFrameViewType;
-    using ConstRawFrameViewType = IpViewer::ConstRawFrameViewType;
-    using HeaderStructType = struct icmphdr;
 
     enum class PackageType {
         EchoRequest,
@@ -74,32 +74,80 @@ public:
         Undefined
     };
 
-    explicit IcmpViewer(IpViewer ipViewer);
-    explicit IcmpViewer(RawFrameViewType rawFrame);
-    explicit IcmpViewer(ConstRawFrameViewType rawFrame);
+    using TryViewResultType = utils::Result<IcmpViewer, ParseError>;
 
-    PackageType getType();
-    std::string_view getTypeAsStr();
-    PackageCode getCode();
-    std::string_view getCodeAsStr();
-    unsigned int getCheckSum();
-    unsigned int getId();
-    unsigned int getSequenceNumber();
+    /**
+     * @brief Constructs the viewer after checking the view, the view starts with the header.
+     * @return the viewer or the reason why the view is malformed.
+     */
+    static TryViewResultType TryView(ConstRawFrameViewType view) noexcept;
+
+    explicit IcmpViewer(IpViewer ipViewer) noexcept;
+    explicit IcmpViewer(ConstRawFrameViewType rawFrame) noexcept;
+    /**
+     * @brief Constructs the viewer from the descriptor of FrameDissector in O(1).
+     * @throw std::runtime_error if the frame has no ICMP layer.
+     */
+    explicit IcmpViewer(const ParsedFrame& parsedFrame);
 
     PackageType getType() const;
     std::string_view getTypeAsStr() const;
     PackageCode getCode() const;
     std::string_view getCodeAsStr() const;
-    unsigned int getCheckSum() const;
-    unsigned int getId() const;
-    unsigned int getSequenceNumber() const;
+    unsigned int getCheckSum() const noexcept;
+    unsigned int getId() const noexcept;
+    unsigned int getSequenceNumber() const noexcept;
+    unsigned int getHeaderLengthInBytes() const noexcept;
 
     std::ostream& operator<<(std::ostream& os) const;
-
-private:
-    HeaderStructType* m_frame;
 };
 
+static_assert(FrameViewer<IcmpViewer>);
+
+inline IcmpViewer::TryViewResultType IcmpViewer::TryView(const ConstRawFrameViewType view) noexcept
+{
+    if (view.size() < DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES) {
+        return TryViewResultType::onError(ParseError::TooShort);
+    }
+    return TryViewResultType::onOk(IcmpViewer(view));
+}
+
+inline IcmpViewer::IcmpViewer(const IpViewer ipViewer) noexcept:
+BaseViewer(ipViewer.getPayloadStart(), ipViewer.getFrameInfo())
+{}
+
+inline IcmpViewer::IcmpViewer(const ConstRawFrameViewType rawFrame) noexcept:
+BaseViewer(rawFrame.data(), nullptr)
+{}
+
+inline IcmpViewer::IcmpViewer(const ParsedFrame& parsedFrame):
+BaseViewer(parsedFrame.getL4Start(), nullptr)
+{
+    if (!parsedFrame.hasFlag(ParsedFrame::Flag::Icmp)) {
+        throw std::runtime_error("Could not view ICMP frame: the frame has no ICMP layer");
+    }
+}
+
+inline unsigned int IcmpViewer::getCheckSum() const noexcept
+{
+    return utils::NetworkToHost16(getHeader()->checksum);
+}
+
+inline unsigned int IcmpViewer::getId() const noexcept
+{
+    return utils::NetworkToHost16(getHeader()->un.echo.id);
+}
+
+inline unsigned int IcmpViewer::getSequenceNumber() const noexcept
+{
+    return utils::NetworkToHost16(getHeader()->un.echo.sequence);
+}
+
+inline unsigned int IcmpViewer::getHeaderLengthInBytes() const noexcept
+{
+    return DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES;
+}
+
 std::ostream& operator<<(std::ostream& os, const IcmpViewer& icmpViewer);
 
 } // namespace posnet
@@ -1,12 +1,15 @@
 #ifndef VS_IP_VIEWER_H
 #define VS_IP_VIEWER_H
 
-#include "include/base_frame.h"
+#include "include/frame-viewers/base_viewer.h"
+#include "include/frame-dissector/parsed_frame.h"
 #include "include/frame-viewers/ethernet_viewer.h"
+#include "include/utils/byte_order.h"
 
 #include <string>
 #include <string_view>
 #include <ostream>
+#include <stdexcept>
 
 #include <netinet/ip.h>
 
@@ -42,7 +45,7 @@ namespace posnet {
  * 
  * daddr: This is a 32-bit field that specifies the destination IP address.
  */
-class IpViewer final : public BaseFrame {
+class IpViewer final : public BaseViewer<IpViewer, struct iphdr> {
 public:
     static constexpr unsigned int DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES = sizeof(struct iphdr);
     static constexpr unsigned int DEFAULT_FRAME_TOS_VALUE = 0;
@@ -53,10 +56,6 @@ public:
     static constexpr unsigned int DEFAULT_FRAME_ID_VALUE = 0;
 
     static constexpr std::string_view LOCAL_HOST_IP_ADDRESS = "127.0.0.1";
-
-    using RawFrameViewType = EthernetViewer::RawFrameViewType;
-    using ConstRawFrameViewType = EthernetViewer::ConstRawFrameViewType;
-    using HeaderStructType = struct iphdr;
     
     enum class ProtocolType {
         TCP,
@@ -69,45 +68,155 @@ public:
         V4, V6
     };
 
-    explicit IpViewer(EthernetViewer ethernetViewer);
-    explicit IpViewer(RawFrameViewType rawFrame);
-    explicit IpViewer(ConstRawFrameViewType rawFrame);
-
-    VersionType getVersion();
-    ProtocolType getProtocol();
-    std::string_view getProtocolAsStr();
-    unsigned int getTypeOfService();
-    unsigned int getHeaderLengthInBytes();
-    unsigned int getTotalLength();
-    unsigned int getId();
-    unsigned int getFragmentOffset();
-    unsigned int getTTL();
-    unsigned int getCheckSum();
-    std::string getSourceIpAddressAsStr();
-    std::string getDestIpAddressAsStr();
-  
-    VersionType getVersion() const;
-    ProtocolType getProtocol() const;
+    using TryViewResultType = utils::Result<IpViewer, ParseError>;
+
+    /**
+     * @brief Constructs the viewer after checking the view, the view starts with the header.
+     * @return the viewer or the reason why the view is malformed.
+     */
+    static TryViewResultType TryView(ConstRawFrameViewType view) noexcept;
+
+    explicit IpViewer(EthernetViewer ethernetViewer) noexcept;
+    explicit IpViewer(ConstRawFrameViewType rawFrame) noexcept;
+    /**
+     * @brief Constructs the viewer from the descriptor of FrameDissector in O(1).
+     * @throw std::runtime_error if the frame has no IP layer.
+     */
+    explicit IpViewer(const ParsedFrame& parsedFrame);
+
+    VersionType getVersion() const noexcept;
+    ProtocolType getProtocol() const noexcept;
     std::string_view getProtocolAsStr() const;
-    unsigned int getTypeOfService() const;
-    unsigned int getHeaderLength() const;
-    unsigned int getHeaderLengthInBytes() const;
-    unsigned int getTotalLength() const;
-    unsigned int getId() const;
-    unsigned int getFragmentOffset() const;
-    unsigned int getTTL() const;
-    unsigned int getCheckSum() const;
+    unsigned int getTypeOfService() const noexcept;
+    unsigned int getHeaderLengthInBytes() const noexcept;
+    unsigned int getTotalLength() const noexcept;
+    unsigned int getId() const noexcept;
+    unsigned int getFragmentOffset() const noexcept;
+    unsigned int getTTL() const noexcept;
+    unsigned int getCheckSum() const noexcept;
     std::string getSourceIpAddressAsStr() const;
     std::string getDestIpAddressAsStr() const;
-    
-    std::uint8_t* getFrameHeaderStart();
+    // Ip-addresses are in network byte order
+    std::uint32_t getSourceIpAddress() const noexcept;
+    std::uint32_t getDestIpAddress() const noexcept;
+    /**
+     * @brief Returns the payload of the datagram, which is limited by the total length of the datagram.
+     * @param view - the view, which starts with IP header and which was checked by TryView.
+     */
+    ConstRawFrameViewType getPayload(ConstRawFrameViewType view) const noexcept;
 
     std::ostream& operator<<(std::ostream& os) const;
-    
-private:
-    HeaderStructType* m_frame;
 };
 
+static_assert(FrameViewer<IpViewer>);
+
+inline IpViewer::TryViewResultType IpViewer::TryView(const ConstRawFrameViewType view) noexcept
+{
+    if (view.size() < DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES) {
+        return TryViewResultType::onError(ParseError::TooShort);
+    }
+
+    // All checks are combined into one branch, the error is classified only for the malformed packets
+    const auto header = reinterpret_cast<const HeaderStructType*>(view.data());
+    const unsigned int headerLength = static_cast<unsigned int>(header->ihl) * 4;
+    const unsigned int totalLength = utils::NetworkToHost16(header->tot_len);
+    const bool isValid = (header->version == 4) & (headerLength >= DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES) &
+        (headerLength <= totalLength) & (totalLength <= view.size());
+    if (isValid) {
+        return TryViewResultType::onOk(IpViewer(view));
+    }
+
+    if (header->version != 4) {
+        return TryViewResultType::onError(ParseError::InvalidVersion);
+    } else if (headerLength < DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES || headerLength > view.size()) {
+        return TryViewResultType::onError(ParseError::InvalidHeaderLength);
+    }
+    return TryViewResultType::onError(ParseError::InvalidLength);
+}
+
+inline IpViewer::ConstRawFrameViewType IpViewer::getPayload(const ConstRawFrameViewType view) const noexcept
+{
+    // The padding of Ethernet frame after the datagram is not the payload
+    return view.subspan(getHeaderLengthInBytes(), getTotalLength() - getHeaderLengthInBytes());
+}
+
+inline IpViewer::IpViewer(const EthernetViewer ethernetViewer) noexcept:
+BaseViewer(ethernetViewer.getPayloadStart(), ethernetViewer.getFrameInfo())
+{}
+
+inline IpViewer::IpViewer(const ConstRawFrameViewType rawFrame) noexcept:
+BaseViewer(rawFrame.data(), nullptr)
+{}
+
+inline IpViewer::IpViewer(const ParsedFrame& parsedFrame):
+BaseViewer(parsedFrame.getL3Start(), nullptr)
+{
+    if (!parsedFrame.hasFlag(ParsedFrame::Flag::Ip)) {
+        throw std::runtime_error("Could not view IP frame: the frame has no IP layer");
+    }
+}
+
+inline IpViewer::VersionType IpViewer::getVersion() const noexcept
+{
+    return (getHeader()->version == 4 ? VersionType::V4 : VersionType::V6);
+}
+
+inline IpViewer::ProtocolType IpViewer::getProtocol() const noexcept
+{
+    switch (getHeader()->protocol) {
+        case IPPROTO_ICMP: return ProtocolType::ICMP;
+        case IPPROTO_TCP: return ProtocolType::TCP;
+        case IPPROTO_UDP: return ProtocolType::UDP;
+        default:
+            return ProtocolType::Undefined;
+    }
+}
+
+inline unsigned int IpViewer::getTypeOfService() const noexcept
+{
+    return getHeader()->tos;
+}
+
+inline unsigned int IpViewer::getHeaderLengthInBytes() const noexcept
+{
+    return static_cast<unsigned int>(getHeader()->ihl) * 4;
+}
+
+inline unsigned int IpViewer::getTotalLength() const noexcept
+{
+    return utils::NetworkToHost16(getHeader()->tot_len);
+}
+
+inline unsigned int IpViewer::getId() const noexcept
+{
+    return utils::NetworkToHost16(getHeader()->id);
+}
+
+inline unsigned int IpViewer::getFragmentOffset() const noexcept
+{
+    return (getHeader()->frag_off);
+}
+
+inline unsigned int IpViewer::getTTL() const noexcept
+{
+    return (getHeader()->ttl);
+}
+
+inline unsigned int IpViewer::getCheckSum() const noexcept
+{
+    return utils::NetworkToHost16(getHeader()->check);
+}
+
+inline std::uint32_t IpViewer::getSourceIpAddress() const noexcept
+{
+    return getHeader()->saddr;
+}
+
+inline std::uint32_t IpViewer::getDestIpAddress() const noexcept
+{
+    return getHeader()->daddr;
+}
+
 std::ostream& operator<<(std::ostream& os, const IpViewer& ipViewer);
 
 } //! namespace posnet
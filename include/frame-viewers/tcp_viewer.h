@@ -1,9 +1,14 @@
 #ifndef VS_TCP_VIEWER_H
 #define VS_TCP_VIEWER_H
 
-#include "ip_viewer.h"
+#include "include/frame-viewers/base_viewer.h"
+#include "include/frame-dissector/parsed_frame.h"
+#include "include/frame-viewers/ethernet_viewer.h"
+#include "include/frame-viewers/ip_viewer.h"
+#include "include/utils/byte_order.h"
 
 #include <ostream>
+#include <stdexcept>
 
 #include <netinet/tcp.h>
 
@@ -44,52 +49,159 @@ namespace posnet {
  * 
  * urg_ptr: This field is only used if the urgent pointer (URG) flag is set.
  */  
-class TcpViewer final {
+class TcpViewer final : public BaseViewer<TcpViewer, struct tcphdr> {
 public:
-    using RawFrameViewType = IpViewer::RawFrameViewType;
-    using ConstRawFrameViewType = IpViewer::ConstRawFrameViewType;
-    using HeaderStructType = struct tcphdr;
+    static constexpr unsigned int DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES = sizeof(struct tcphdr);
+
     using PortType = int;
 
-    explicit TcpViewer(IpViewer ipViewer);
-    explicit TcpViewer(RawFrameViewType rawFrame);
-    explicit TcpViewer(ConstRawFrameViewType rawFrame);
-
-    PortType getSourcePort();
-    PortType getDestPort();
-    unsigned int getSequenceNumber();
-    unsigned int getAcknowledgeNumber();
-    unsigned int getHeaderLengthInBytes();
-    unsigned int getWindowSize();
-    unsigned int getCheckSum();
-    bool getUrgentFlag();
-    bool getAcknowledgmentFlag();
-    bool getPushFlag();
-    bool getResetFlag();
-    bool getSynchronizeFlag();
-    bool getFinishFlag();
-    std::uint8_t* getFrameHeaderStart();
-
-    PortType getSourcePort() const;
-    PortType getDestPort() const;
-    unsigned int getSequenceNumber() const;
-    unsigned int getAcknowledgeNumber() const;
-    unsigned int getHeaderLengthInBytes() const;
-    unsigned int getWindowSize() const;
-    unsigned int getCheckSum() const;
-    bool getUrgentFlag() const;
-    bool getAcknowledgmentFlag() const;
-    bool getPushFlag() const;
-    bool getResetFlag() const;
-    bool getSynchronizeFlag() const;
-    bool getFinishFlag() const;
+    using TryViewResultType = utils::Result<TcpViewer, ParseError>;
+
+    /**
+     * @brief Constructs the viewer after checking the view, the view starts with the header.
+     * @return the viewer or the reason why the view is malformed.
+     */
+    static TryViewResultType TryView(ConstRawFrameViewType view) noexcept;
+
+    explicit TcpViewer(IpViewer ipViewer) noexcept;
+    /**
+     * @brief Constructs the viewer from the whole frame, which starts with Ethernet header.
+     */
+    explicit TcpViewer(ConstRawFrameViewType rawFrame) noexcept;
+    /**
+     * @brief Constructs the viewer from the descriptor of FrameDissector in O(1).
+     * @throw std::runtime_error if the frame has no TCP layer.
+     */
+    explicit TcpViewer(const ParsedFrame& parsedFrame);
+
+    PortType getSourcePort() const noexcept;
+    PortType getDestPort() const noexcept;
+    unsigned int getSequenceNumber() const noexcept;
+    unsigned int getAcknowledgeNumber() const noexcept;
+    unsigned int getHeaderLengthInBytes() const noexcept;
+    unsigned int getWindowSize() const noexcept;
+    unsigned int getCheckSum() const noexcept;
+    bool getUrgentFlag() const noexcept;
+    bool getAcknowledgmentFlag() const noexcept;
+    bool getPushFlag() const noexcept;
+    bool getResetFlag() const noexcept;
+    bool getSynchronizeFlag() const noexcept;
+    bool getFinishFlag() const noexcept;
+    // All flags(FIN, SYN, RST, PSH, ACK, URG, ECE, CWR) as the 13-th byte of the header, the same as ParsedFrame::tcpFlags
+    std::uint8_t getFlags() const noexcept;
 
     std::ostream& operator<<(std::ostream& os) const;
 
 private:
-    HeaderStructType* m_frame;
+    // The constructor from the start of TCP header
+    explicit TcpViewer(const ByteType* headerStart) noexcept;
 };
 
+static_assert(FrameViewer<TcpViewer>);
+
+inline TcpViewer::TryViewResultType TcpViewer::TryView(const ConstRawFrameViewType view) noexcept
+{
+    if (view.size() < DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES) {
+        return TryViewResultType::onError(ParseError::TooShort);
+    }
+
+    const unsigned int headerLength = static_cast<unsigned int>(reinterpret_cast<const HeaderStructType*>(view.data())->doff) * 4;
+    if ((headerLength < DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES) | (headerLength > view.size())) {
+        return TryViewResultType::onError(ParseError::InvalidHeaderLength);
+    }
+    return TryViewResultType::onOk(TcpViewer(view.data()));
+}
+
+inline TcpViewer::TcpViewer(const IpViewer ipViewer) noexcept:
+BaseViewer(ipViewer.getPayloadStart(), ipViewer.getFrameInfo())
+{}
+
+inline TcpViewer::TcpViewer(const ConstRawFrameViewType rawFrame) noexcept:
+BaseViewer(IpViewer(EthernetViewer(rawFrame)).getPayloadStart(), nullptr)
+{}
+
+inline TcpViewer::TcpViewer(const ByteType* const headerStart) noexcept:
+BaseViewer(headerStart, nullptr)
+{}
+
+inline TcpViewer::TcpViewer(const ParsedFrame& parsedFrame):
+BaseViewer(parsedFrame.getL4Start(), nullptr)
+{
+    if (!parsedFrame.hasFlag(ParsedFrame::Flag::Tcp)) {
+        throw std::runtime_error("Could not view TCP frame: the frame has no TCP layer");
+    }
+}
+
+inline TcpViewer::PortType TcpViewer::getSourcePort() const noexcept
+{
+    return utils::NetworkToHost16(getHeader()->source);
+}
+
+inline TcpViewer::PortType TcpViewer::getDestPort() const noexcept
+{
+    return utils::NetworkToHost16(getHeader()->dest);
+}
+
+inline unsigned int TcpViewer::getSequenceNumber() const noexcept
+{
+    return utils::NetworkToHost32(getHeader()->seq);
+}
+
+inline unsigned int TcpViewer::getAcknowledgeNumber() const noexcept
+{
+    return utils::NetworkToHost32(getHeader()->ack_seq);
+}
+
+inline unsigned int TcpViewer::getHeaderLengthInBytes() const noexcept
+{
+    return static_cast<unsigned int>(getHeader()->doff) * 4;
+}
+
+inline unsigned int TcpViewer::getWindowSize() const noexcept
+{
+    return utils::NetworkToHost16(getHeader()->window);
+}
+
+inline unsigned int TcpViewer::getCheckSum() const noexcept
+{
+    return utils::NetworkToHost16(getHeader()->check);
+}
+
+inline bool TcpViewer::getUrgentFlag() const noexcept
+{
+    return getHeader()->urg != 0;
+}
+
+inline bool TcpViewer::getAcknowledgmentFlag() const noexcept
+{
+    return getHeader()->ack != 0;
+}
+
+inline bool TcpViewer::getPushFlag() const noexcept
+{
+    return getHeader()->psh != 0;
+}
+
+inline bool TcpViewer::getResetFlag() const noexcept
+{
+    return getHeader()->rst != 0;
+}
+
+inline bool TcpViewer::getSynchronizeFlag() const noexcept
+{
+    return getHeader()->syn != 0;
+}
+
+inline bool TcpViewer::getFinishFlag() const noexcept
+{
+    return getHeader()->fin != 0;
+}
+
+inline std::uint8_t TcpViewer::getFlags() const noexcept
+{
+    return getFrameHeaderStart()[13];
+}
+
 std::ostream& operator<<(std::ostream& os, const TcpViewer& tcpViewer);
 
 } //! namespace posnet
@@ -1,10 +1,13 @@
 #ifndef VS_UPD_VIEWER_H
 #define VS_UPD_VIEWER_H
 
-#include "include/base_frame.h"
+#include "include/frame-viewers/base_viewer.h"
+#include "include/frame-dissector/parsed_frame.h"
 #include "include/frame-viewers/ip_viewer.h"
+#include "include/utils/byte_order.h"
 
 #include <ostream>
+#include <stdexcept>
 
 #include <netinet/udp.h>
 
@@ -21,37 +24,93 @@ namespace posnet {
  * 
  * check: This is the checksum of the UDP header and data. It is used for error-checking of the UDP header and data.
  */
-class UdpViewer final : public BaseFrame {
+class UdpViewer final : public BaseViewer<UdpViewer, struct udphdr> {
 public:
     static constexpr auto DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES = sizeof(struct udphdr);
 
-    using RawFrameViewType = IpViewer::RawFrameViewType;
-    using ConstRawFrameViewType = IpViewer::ConstRawFrameViewType;
-    using HeaderStructType = struct udphdr;
     using PortType = int;
 
-    explicit UdpViewer(IpViewer ipViewer);
-    explicit UdpViewer(RawFrameViewType rawFrame);
-    explicit UdpViewer(ConstRawFrameViewType rawFrame);
+    using TryViewResultType = utils::Result<UdpViewer, ParseError>;
 
-    PortType getSourcePort();
-    PortType getDestPort();
-    unsigned int getUdpDataGramLength();
-    unsigned int getCheckSum();
+    /**
+     * @brief Constructs the viewer after checking the view, the view starts with the header.
+     * @return the viewer or the reason why the view is malformed.
+     */
+    static TryViewResultType TryView(ConstRawFrameViewType view) noexcept;
 
-    PortType getSourcePort() const;
-    PortType getDestPort() const;
-    unsigned int getUdpDataGramLength() const;
-    unsigned int getCheckSum() const;
+    explicit UdpViewer(IpViewer ipViewer) noexcept;
+    explicit UdpViewer(ConstRawFrameViewType rawFrame) noexcept;
+    /**
+     * @brief Constructs the viewer from the descriptor of FrameDissector in O(1).
+     * @throw std::runtime_error if the frame has no UDP layer.
+     */
+    explicit UdpViewer(const ParsedFrame& parsedFrame);
 
-    std::uint8_t* getFrameHeaderStart();
+    PortType getSourcePort() const noexcept;
+    PortType getDestPort() const noexcept;
+    unsigned int getUdpDataGramLength() const noexcept;
+    unsigned int getCheckSum() const noexcept;
+    unsigned int getHeaderLengthInBytes() const noexcept;
 
     std::ostream& operator<<(std::ostream& os) const;
-
-private:
-    HeaderStructType* m_frame;
 };
-    
+
+static_assert(FrameViewer<UdpViewer>);
+
+inline UdpViewer::TryViewResultType UdpViewer::TryView(const ConstRawFrameViewType view) noexcept
+{
+    if (view.size() < DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES) {
+        return TryViewResultType::onError(ParseError::TooShort);
+    }
+
+    const auto length = utils::NetworkToHost16(reinterpret_cast<const HeaderStructType*>(view.data())->len);
+    if ((length < DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES) | (length > view.size())) {
+        return TryViewResultType::onError(ParseError::InvalidLength);
+    }
+    return TryViewResultType::onOk(UdpViewer(view));
+}
+
+inline UdpViewer::UdpViewer(const IpViewer ipViewer) noexcept:
+BaseViewer(ipViewer.getPayloadStart(), ipViewer.getFrameInfo())
+{}
+
+inline UdpViewer::UdpViewer(const ConstRawFrameViewType rawFrame) noexcept:
+BaseViewer(rawFrame.data(), nullptr)
+{}
+
+inline UdpViewer::UdpViewer(const ParsedFrame& parsedFrame):
+BaseViewer(parsedFrame.getL4Start(), nullptr)
+{
+    if (!parsedFrame.hasFlag(ParsedFrame::Flag::Udp)) {
+        throw std::runtime_error("Could not view UDP frame: the frame has no UDP layer");
+    }
+}
+
+inline UdpViewer::PortType UdpViewer::getSourcePort() const noexcept
+{
+    return utils::NetworkToHost16(getHeader()->source);
+}
+
+inline UdpViewer::PortType UdpViewer::getDestPort() const noexcept
+{
+    return utils::NetworkToHost16(getHeader()->dest);
+}
+
+inline unsigned int UdpViewer::getUdpDataGramLength() const noexcept
+{
+    return utils::NetworkToHost16(getHeader()->len);
+}
+
+inline unsigned int UdpViewer::getCheckSum() const noexcept
+{
+    return utils::NetworkToHost16(getHeader()->check);
+}
+
+inline unsigned int UdpViewer::getHeaderLengthInBytes() const noexcept
+{
+    return DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES;
+}
+
 std::ostream& operator<<(std::ostream& os, const UdpViewer& updViewer);
 
 } //! namespace posnet
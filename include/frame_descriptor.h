@@ -0,0 +1,41 @@
+#ifndef VS_FRAME_DESCRIPTOR_H
+#define VS_FRAME_DESCRIPTOR_H
+
+#include "include/base_frame.h"
+#include "include/utils/spsc_ring.h"
+#include "include/utils/mpmc_ring.h"
+
+namespace posnet {
+
+/**
+ * @brief The frame, which is handed over from the capture thread to the worker threads by the frame rings.
+ * @details The descriptor does not own the frame, it only points to the frame buffer(the frame of PacketRxRing block,
+ * BatchReceiver batch, FramePool frame, ...), so the frame is not copied between the threads.
+ * @warning The producer has to keep the frame buffer alive until the consumer is done with the frame
+ * (e.g. the block of PacketRxRing is returned to the kernel only after the workers have processed its frames).
+ */
+struct FrameDescriptor {
+    using ByteType = BaseFrame::ByteType;
+    using SizeType = BaseFrame::SizeType;
+    using ConstRawFrameViewType = BaseFrame::ConstRawFrameViewType;
+    using FrameInfo = BaseFrame::FrameInfo;
+
+    const ByteType* data = nullptr;
+    SizeType length = 0;
+    FrameInfo info;
+
+    ConstRawFrameViewType getAsRawFrameView() const noexcept
+    {
+        return ConstRawFrameViewType{ data, length };
+    }
+};
+
+template<utils::OverflowPolicy P = utils::OverflowPolicy::Drop>
+using SpscFrameRing = utils::SpscRing<FrameDescriptor, P>;
+
+template<utils::OverflowPolicy P = utils::OverflowPolicy::Drop>
+using MpmcFrameRing = utils::MpmcRing<FrameDescriptor, P>;
+
+} //! namespace posnet
+
+#endif //! VS_FRAME_DESCRIPTOR_H
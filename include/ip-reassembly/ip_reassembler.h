@@ -0,0 +1,192 @@
+#ifndef VS_IP_REASSEMBLER_H
+#define VS_IP_REASSEMBLER_H
+
+#include "include/base_frame.h"
+#include "include/utils/timer_wheel.h"
+
+#include <array>
+#include <vector>
+#include <chrono>
+#include <optional>
+#include <string_view>
+#include <cstdint>
+
+namespace posnet {
+
+/**
+ * @brief This class reassembles IPv4 datagrams from their fragments.
+ * @details The fragments are matched by (source ip, dest ip, id, protocol). All memory is allocated by the constructor:
+ * the descriptors of maxDatagramCount datagrams and the slab of memoryLimitInBytes, which is split into the chunks
+ * of CHUNK_SIZE_IN_BYTES. The payload of the fragment is copied into the chunks of its datagram at the offset
+ * of the fragment, the chunks are taken only for the received parts of the datagram and they are returned to the slab
+ * when the datagram is reassembled, dropped or expired.
+ * The datagram is dropped when it breaks the limits: more than maxFragmentCount fragments, larger than maxDatagramSizeInBytes,
+ * no free descriptor or chunk. The fragment, which is fully covered by the received fragments, is ignored as a duplicate.
+ * The fragment, which partially overlaps the received fragments, drops the datagram(OverlapPolicy::Drop, the same as
+ * Linux does) or only its new bytes are kept(OverlapPolicy::KeepFirst).
+ * The datagram, which is not completed within the timeout since its first fragment, is expired by TimerWheel, which is driven
+ * by the timestamps of the processed packets(or by advance).
+ * The reassembled datagram is the contiguous IP packet with the header of the first fragment(the fragment fields
+ * are cleared, the total length and the checksum are updated), so it is viewed by IpViewer::TryView and its payload
+ * by UdpViewer::TryView, IcmpViewer, ...
+ * @example {
+ *              IpReassembler reassembler(IpReassembler::Configuration{});
+ *              const auto ipPacket = ethernetViewer->getPayload(frame);
+ *              const auto datagram = reassembler.process(ipPacket, info.timestamp);
+ *              if (datagram) {
+ *                  const auto ipViewer = IpViewer::TryView(*datagram);
+ *                  const auto udpViewer = UdpViewer::TryView(ipViewer->getPayload(*datagram));
+ *              }
+ *          }
+ * @warning This class IS NOT THREAD SAFE, it is meant to be owned by one capture(processing) thread.
+ * All fragments of the datagram have to reach the same thread(e.g. PACKET_FANOUT group in Hash mode hashes by ip-addresses).
+ */
+class IpReassembler final {
+public:
+    static constexpr unsigned int CHUNK_SIZE_IN_BYTES = 1024;
+    static constexpr unsigned int MAX_DATAGRAM_SIZE_IN_BYTES = 65535;
+    static constexpr unsigned int DEFAULT_MAX_DATAGRAM_COUNT = 1024;
+    static constexpr unsigned int DEFAULT_MEMORY_LIMIT_IN_BYTES = 4 * 1024 * 1024;
+    static constexpr unsigned int DEFAULT_MAX_FRAGMENT_COUNT = 64;
+    static constexpr std::chrono::seconds DEFAULT_TIMEOUT = std::chrono::seconds(30);
+
+    using ByteType = BaseFrame::ByteType;
+    using SizeType = BaseFrame::SizeType;
+    using ConstRawFrameViewType = BaseFrame::ConstRawFrameViewType;
+    using TimestampType = std::chrono::nanoseconds;
+
+    enum class OverlapPolicy {
+        // The datagram with the overlapping fragments is dropped
+        Drop,
+        // The bytes, which were received first, are kept
+        KeepFirst,
+    };
+
+    struct Configuration {
+        // The count of the datagrams, which are reassembled at once
+        SizeType maxDatagramCount = DEFAULT_MAX_DATAGRAM_COUNT;
+        // The size of the slab of all datagrams
+        SizeType memoryLimitInBytes = DEFAULT_MEMORY_LIMIT_IN_BYTES;
+        // The limits of one datagram
+        SizeType maxFragmentCount = DEFAULT_MAX_FRAGMENT_COUNT;
+        SizeType maxDatagramSizeInBytes = MAX_DATAGRAM_SIZE_IN_BYTES;
+        TimestampType timeout = DEFAULT_TIMEOUT;
+        OverlapPolicy overlapPolicy = OverlapPolicy::Drop;
+    };
+
+    struct Statistics {
+        std::uint64_t fragments = 0;
+        std::uint64_t reassembledDatagrams = 0;
+        std::uint64_t duplicateFragments = 0;
+        // The datagrams, which were dropped because of the overlapping or inconsistent fragments
+        std::uint64_t overlapDrops = 0;
+        // The datagrams, which were dropped because of maxFragmentCount or maxDatagramSizeInBytes
+        std::uint64_t limitDrops = 0;
+        // The datagrams, which were dropped because of maxDatagramCount or memoryLimitInBytes
+        std::uint64_t memoryDrops = 0;
+        std::uint64_t timeouts = 0;
+        // The packets, which were rejected by IpViewer::TryView or have the malformed fragment fields
+        std::uint64_t malformedPackets = 0;
+        SizeType activeDatagrams = 0;
+        SizeType usedMemoryInBytes = 0;
+    };
+
+    /**
+     * @brief Allocates the descriptors and the slab.
+     * @throw std::runtime_error if the configuration is invalid.
+     */
+    explicit IpReassembler(Configuration config, TimestampType now = TimestampType::zero());
+
+    IpReassembler(const IpReassembler&) = delete;
+    IpReassembler(IpReassembler&&) = delete;
+    IpReassembler& operator=(const IpReassembler&) = delete;
+    IpReassembler& operator=(IpReassembler&&) = delete;
+
+    /**
+     * @brief Processes the IP packet, it expires the datagrams, which are older than the timeout, first.
+     * @param ipPacket - the view, which starts with IP header(e.g. EthernetViewer::getPayload).
+     * @return the packet itself(without the padding) if it is not a fragment, the reassembled datagram if the fragment
+     * completes it, std::nullopt otherwise. The reassembled datagram is valid until the next call.
+     */
+    std::optional<ConstRawFrameViewType> process(ConstRawFrameViewType ipPacket, TimestampType timestamp);
+    // Expires the datagrams, which are older than the timeout, it should be called periodically if there are no packets
+    SizeType advance(TimestampType now);
+    // Drops all datagrams
+    void clear() noexcept;
+
+    const Configuration& getConfiguration() const noexcept;
+    Statistics getStatistics() const noexcept;
+
+private:
+    static constexpr std::uint32_t NULL_INDEX = UINT32_MAX;
+    static constexpr unsigned int MAX_IP_HEADER_LENGTH_IN_BYTES = 60;
+    static constexpr unsigned int CHUNK_TABLE_SIZE = (MAX_DATAGRAM_SIZE_IN_BYTES + CHUNK_SIZE_IN_BYTES - 1) / CHUNK_SIZE_IN_BYTES;
+
+    struct DatagramKey {
+        std::uint32_t sourceIpAddress = 0;
+        std::uint32_t destIpAddress = 0;
+        std::uint16_t id = 0;
+        std::uint8_t protocol = 0;
+
+        bool operator==(const DatagramKey& other) const noexcept = default;
+    };
+
+    // The received range of the payload [start, end)
+    struct Range {
+        std::uint32_t start = 0;
+        std::uint32_t end = 0;
+    };
+
+    struct Datagram {
+        DatagramKey key;
+        utils::TimerWheel::TimerIdType timerId = utils::TimerWheel::INVALID_TIMER_ID;
+        // The length of the payload, it is known after the last fragment, zero before
+        std::uint32_t totalLength = 0;
+        std::uint32_t receivedLength = 0;
+        SizeType fragmentCount = 0;
+        // The header of the first fragment, zero length until the first fragment is received
+        SizeType headerLength = 0;
+        std::array<ByteType, MAX_IP_HEADER_LENGTH_IN_BYTES> header{};
+        // The received ranges, they are sorted and merged
+        std::vector<Range> ranges;
+        std::array<std::uint32_t, CHUNK_TABLE_SIZE> chunks{};
+    };
+
+    enum class AddResult {
+        Added,
+        Duplicate,
+        Overlap,
+        Limit,
+        Memory,
+    };
+
+    static std::uint64_t GetHash(const DatagramKey& key) noexcept;
+
+    std::uint32_t findDatagram(const DatagramKey& key) const noexcept;
+    std::uint32_t createDatagram(const DatagramKey& key, TimestampType timestamp);
+    AddResult addFragment(Datagram& datagram, std::uint32_t offset, ConstRawFrameViewType payload, bool isLast);
+    bool copyPayload(Datagram& datagram, std::uint32_t offset, ConstRawFrameViewType payload) noexcept;
+    ConstRawFrameViewType buildDatagram(const Datagram& datagram) noexcept;
+    // Cancels the timer of the datagram and releases it
+    void dropDatagram(std::uint32_t index) noexcept;
+    // Returns the chunks to the slab and the descriptor to the free list
+    void releaseDatagram(std::uint32_t index) noexcept;
+
+    Configuration m_config;
+    std::vector<Datagram> m_datagrams;
+    std::vector<std::uint32_t> m_freeDatagrams;
+    // The open addressing index of the active datagrams, it is kept at most half full
+    std::vector<std::uint32_t> m_index;
+    std::uint32_t m_indexMask;
+    std::vector<ByteType> m_slab;
+    std::vector<std::uint32_t> m_freeChunks;
+    std::vector<ByteType> m_datagramBuffer;
+    utils::TimerWheel m_timerWheel;
+    Statistics m_statistics;
+};
+
+std::string_view OverlapPolicyToStr(IpReassembler::OverlapPolicy policy);
+
+} //! namespace posnet
+
+#endif //! VS_IP_REASSEMBLER_H
@@ -0,0 +1,173 @@
+#ifndef VS_BATCH_RECEIVER_H
+#define VS_BATCH_RECEIVER_H
+
+#include "include/base_frame.h"
+
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <iterator>
+
+#include <sys/socket.h>
+
+namespace posnet {
+
+class FramePool;
+
+/**
+ * @brief This class receives the frames(datagrams) from the socket by batches, one recvmmsg syscall per batch.
+ * @details All buffers of the batch are preallocated by the constructor and they are reused by every receive call,
+ * so receiving does not allocate memory. The socket can be any datagram socket: AF_PACKET socket(the batch contains
+ * the whole frames, which can be walked by EthernetViewer, IpViewer, ...) or UDP socket(the batch contains UDP payloads).
+ * The buffers also can be drawn from FramePool(hugepage-backed), they are returned to the pool by the destructor.
+ * The statistics of the last batch(frame count, bytes, truncated frames, duration of the syscall) can be used to tune
+ * the batch size against the latency.
+ * The metadata of the frames(FrameInfo) is collected after enableFrameInfo: the timestamps(SO_TIMESTAMPNS) and
+ * the original lengths(PACKET_AUXDATA) are received as control messages by the same recvmmsg syscall, the iface and
+ * the direction are taken from sockaddr_ll of AF_PACKET socket.
+ * @example {
+ *              BatchReceiver receiver(sockfd);
+ *              while (true) {
+ *                  for (const auto frame : receiver.receive()) {
+ *                      std::cout << EthernetViewer(frame) << std::endl;
+ *                  }
+ *              }
+ *          }
+ * @warning The frame views of the batch are valid only until the next receive call.
+ * @warning This class does not own the socket.
+ * @warning This class IS NOT THREAD SAFE.
+ */
+class BatchReceiver final {
+public:
+    static constexpr unsigned int DEFAULT_BATCH_SIZE = 64;
+    static constexpr unsigned int DEFAULT_FRAME_SIZE_IN_BYTES = 2048;
+    static constexpr unsigned int FRAME_ALIGNMENT_IN_BYTES = 64;
+    // Enough for SO_TIMESTAMPNS and PACKET_AUXDATA control messages
+    static constexpr unsigned int CONTROL_BUFFER_SIZE_IN_BYTES = 128;
+
+    using ByteType = BaseFrame::ByteType;
+    using SizeType = BaseFrame::SizeType;
+    using ConstRawFrameViewType = BaseFrame::ConstRawFrameViewType;
+    using FrameInfo = BaseFrame::FrameInfo;
+
+    struct BatchStatistics {
+        SizeType frameCount = 0;
+        std::uint64_t byteCount = 0;
+        SizeType truncatedFrameCount = 0;
+        std::chrono::nanoseconds receiveDuration = std::chrono::nanoseconds::zero();
+    };
+
+    struct Statistics {
+        std::uint64_t receiveCalls = 0;
+        std::uint64_t emptyReceiveCalls = 0;
+        std::uint64_t fullBatches = 0;
+        std::uint64_t frameCount = 0;
+        std::uint64_t byteCount = 0;
+        std::uint64_t truncatedFrameCount = 0;
+    };
+
+    class Batch final {
+    public:
+        class Iterator final {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = ConstRawFrameViewType;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = ConstRawFrameViewType;
+
+            Iterator() = default;
+            ConstRawFrameViewType operator*() const;
+            Iterator& operator++();
+            Iterator operator++(int);
+            bool operator==(const Iterator& other) const = default;
+
+        private:
+            friend Batch;
+            explicit Iterator(const Batch* batch, SizeType index);
+
+            const Batch* m_batch = nullptr;
+            SizeType m_index = 0;
+        };
+
+        SizeType size() const;
+        bool empty() const;
+        ConstRawFrameViewType operator[](SizeType index) const;
+        ConstRawFrameViewType getFrame(SizeType index) const;
+        bool isTruncated(SizeType index) const;
+        const struct sockaddr_storage& getSourceAddress(SizeType index) const;
+        // The metadata has the default values if enableFrameInfo was not called
+        const FrameInfo& getFrameInfo(SizeType index) const;
+        const BatchStatistics& getStatistics() const;
+
+        Iterator begin() const;
+        Iterator end() const;
+
+    private:
+        friend BatchReceiver;
+        explicit Batch(const BatchReceiver* receiver);
+
+        const BatchReceiver* m_receiver;
+        SizeType m_size;
+        BatchStatistics m_statistics;
+    };
+
+    explicit BatchReceiver(int socket);
+    explicit BatchReceiver(int socket, SizeType batchSize, SizeType frameSizeInBytes);
+    /**
+     * @brief The frame buffers are taken from framePool, the frame size is the frame size of framePool.
+     * @throw std::runtime_error if framePool does not have batchSize free frames.
+     */
+    explicit BatchReceiver(int socket, SizeType batchSize, FramePool& framePool);
+    ~BatchReceiver();
+
+    BatchReceiver(const BatchReceiver&) = delete;
+    BatchReceiver(BatchReceiver&&) = delete;
+    BatchReceiver& operator=(const BatchReceiver&) = delete;
+    BatchReceiver& operator=(BatchReceiver&&) = delete;
+
+    /**
+     * @brief Receives up to batch size frames by one recvmmsg syscall.
+     * @param flags - flags of recvmmsg. By default the call blocks until the first frame and then takes all frames,
+     * which are already queued in the socket, without waiting for the rest of the batch.
+     * @return the batch, which is empty if the call was interrupted or the non-blocking socket has no frames.
+     * @throw std::runtime_error if recvmmsg failed.
+     */
+    const Batch& receive(int flags = MSG_WAITFORONE);
+
+    /**
+     * @brief Enables the timestamps(SO_TIMESTAMPNS) of the socket and the auxiliary data(PACKET_AUXDATA) of AF_PACKET socket,
+     * so every next batch has the metadata of its frames.
+     * @throw std::runtime_error if the options could not be set.
+     */
+    void enableFrameInfo();
+
+    SizeType getBatchSize() const;
+    SizeType getFrameSize() const;
+    const Statistics& getStatistics() const;
+
+private:
+    // The frame buffers have to be set to the io vectors before
+    void initMessages();
+    void parseFrameInfo(SizeType index);
+
+    int m_socket;
+    SizeType m_batchSize;
+    SizeType m_frameSize;
+    SizeType m_frameStride;
+    std::vector<ByteType> m_buffer;
+    FramePool* m_framePool;
+    std::vector<struct iovec> m_ioVectors;
+    std::vector<struct mmsghdr> m_messages;
+    std::vector<struct sockaddr_storage> m_addresses;
+    std::vector<ByteType> m_controls;
+    std::vector<FrameInfo> m_frameInfos;
+    bool m_isFrameInfoEnabled;
+    Batch m_batch;
+    Statistics m_statistics;
+};
+
+} //! namespace posnet
+
+#endif //! VS_BATCH_RECEIVER_H
@@ -0,0 +1,116 @@
+#ifndef VS_CAPTURE_GROUP_H
+#define VS_CAPTURE_GROUP_H
+
+#include "include/net-io/packet_rx_ring.h"
+#include "include/packet-filter/packet_filter.h"
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <functional>
+#include <exception>
+#include <optional>
+#include <cstdint>
+
+namespace posnet {
+
+/**
+ * @brief This class represents of the group of capture workers, which share the traffic of one iface.
+ * @details The group opens N packet sockets(every socket has its own PacketRxRing) and joins them to one PACKET_FANOUT group,
+ * so the kernel distributes the frames between the sockets by the fanout mode. Every socket is served by its own worker thread,
+ * which is pinned to its own CPU, and the worker calls the user callback for every frame of its socket.
+ * The frames are passed to the callback as ConstRawFrameViewType pointing into the ring, so they are ready for the viewers.
+ * @example {
+ *              CaptureGroup group("eth0", CaptureGroup::Configuration{});
+ *              group.start([](CaptureGroup::SizeType workerIndex, CaptureGroup::ConstRawFrameViewType frame) {
+ *                  // called from the worker thread with index workerIndex
+ *              });
+ *              // ...
+ *              group.stop();
+ *          }
+ * @warning The callback is called concurrently from all worker threads.
+ * @warning The methods of this class ARE NOT THREAD SAFE, they have to be called from one control thread.
+ */
+class CaptureGroup final {
+public:
+    static constexpr int WORKER_POLL_TIMEOUT_IN_MS = 100;
+
+    using SizeType = PacketRxRing::SizeType;
+    using ConstRawFrameViewType = PacketRxRing::ConstRawFrameViewType;
+    using FanoutMode = PacketRxRing::FanoutMode;
+    using CallbackType = std::function<void(SizeType workerIndex, ConstRawFrameViewType frame)>;
+
+    struct Configuration {
+        // The count of workers is equal to the count of CPUs if it is not set
+        std::optional<SizeType> workerCount = std::nullopt;
+        // The group id is derived from the process id if it is not set
+        std::optional<std::uint16_t> groupId = std::nullopt;
+        FanoutMode mode = FanoutMode::Hash;
+        bool pinWorkers = true;
+        PacketRxRing::Configuration ringConfig = PacketRxRing::Configuration{};
+    };
+
+    struct WorkerStatistics {
+        std::uint64_t handledFrames = 0;
+        PacketRxRing::Statistics ringStatistics;
+    };
+
+    /**
+     * @brief Opens the sockets of the group and joins them to the fanout group. The workers are not started.
+     * @throw std::runtime_error if any socket could not be set up.
+     */
+    explicit CaptureGroup(std::string_view ifaceName, Configuration config);
+    ~CaptureGroup();
+
+    CaptureGroup(const CaptureGroup&) = delete;
+    CaptureGroup(CaptureGroup&&) = delete;
+    CaptureGroup& operator=(const CaptureGroup&) = delete;
+    CaptureGroup& operator=(CaptureGroup&&) = delete;
+
+    /**
+     * @brief Starts the worker threads.
+     * @throw std::runtime_error if the group is already running.
+     */
+    void start(CallbackType callback);
+
+    /**
+     * @brief Stops and joins the worker threads.
+     * @details If any worker was stopped by an exception, the first of these exceptions is rethrown.
+     */
+    void stop();
+
+    /**
+     * @brief Attaches the filter to the sockets of all workers, the unmatched frames are dropped by the kernel before they are copied into the rings.
+     * @throw std::runtime_error if the filter could not be attached to any socket.
+     */
+    void attachFilter(const PacketFilter& filter);
+
+    bool isRunning() const;
+    SizeType getWorkerCount() const;
+    std::uint16_t getGroupId() const;
+    PacketRxRing& getRing(SizeType workerIndex);
+    std::vector<WorkerStatistics> getStatistics();
+
+private:
+    struct Worker {
+        std::unique_ptr<PacketRxRing> ring;
+        std::thread thread;
+        std::atomic<std::uint64_t> handledFrames = 0;
+        std::exception_ptr error = nullptr;
+    };
+
+    void runWorker(SizeType workerIndex);
+
+    Configuration m_config;
+    std::uint16_t m_groupId;
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    CallbackType m_callback;
+    std::atomic<bool> m_isRunning;
+};
+
+} //! namespace posnet
+
+#endif //! VS_CAPTURE_GROUP_H
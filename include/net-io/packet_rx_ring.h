@@ -0,0 +1,211 @@
+#ifndef VS_PACKET_RX_RING_H
+#define VS_PACKET_RX_RING_H
+
+#include "include/base_frame.h"
+#include "include/utils/scoped_lock.h"
+
+#include <string_view>
+#include <optional>
+#include <chrono>
+#include <type_traits>
+#include <cstdint>
+
+#include <linux/if_packet.h>
+
+namespace posnet {
+
+/**
+ * @brief This class represents of memory-mapped receive ring(PACKET_RX_RING, TPACKET_V3) of AF_PACKET socket.
+ * @details The kernel writes the received frames directly into blocks of the ring, the ring is shared with user space by mmap.
+ * The block is handed over to user space when the kernel retires it(the block is full or its timeout is expired).
+ * Every frame of the retired block is exposed as ConstRawFrameViewType that points into the ring memory,
+ * so the viewers(EthernetViewer, IpViewer, ...) read the frame without any copying and without any syscall per frame.
+ * The callback can also take the metadata of the frame(FrameInfo), which is read from tpacket3_hdr of the frame.
+ * After the user has finished with the block, the block must be released(returned back to the kernel).
+ * @example {
+ *              PacketRxRing ring("eth0");
+ *              while (true) {
+ *                  ring.dispatch([](PacketRxRing::ConstRawFrameViewType frame) {
+ *                      std::cout << EthernetViewer(frame) << std::endl;
+ *                  });
+ *                  // or with the metadata
+ *                  ring.dispatch([](PacketRxRing::ConstRawFrameViewType frame, const PacketRxRing::FrameInfo& info) {
+ *                      std::cout << info.timestamp.count() << " " << EthernetViewer(frame, info) << std::endl;
+ *                  });
+ *              }
+ *          }
+ * @warning The frame views are valid only until the block, which contains them, is released.
+ * @warning This class IS NOT THREAD SAFE.
+ */
+class PacketRxRing final {
+public:
+    static constexpr unsigned int DEFAULT_BLOCK_SIZE_IN_BYTES = 1 << 22;
+    static constexpr unsigned int DEFAULT_BLOCK_COUNT = 64;
+    static constexpr unsigned int DEFAULT_FRAME_SIZE_IN_BYTES = 1 << 11;
+    static constexpr unsigned int DEFAULT_BLOCK_TIMEOUT_IN_MS = 64;
+    static constexpr int INFINITE_TIMEOUT = -1;
+
+    using ByteType = BaseFrame::ByteType;
+    using SizeType = BaseFrame::SizeType;
+    using ConstRawFrameViewType = BaseFrame::ConstRawFrameViewType;
+    using FrameInfo = BaseFrame::FrameInfo;
+
+    struct Configuration {
+        SizeType blockSizeInBytes = DEFAULT_BLOCK_SIZE_IN_BYTES;
+        SizeType blockCount = DEFAULT_BLOCK_COUNT;
+        SizeType frameSizeInBytes = DEFAULT_FRAME_SIZE_IN_BYTES;
+        SizeType blockTimeoutInMs = DEFAULT_BLOCK_TIMEOUT_IN_MS;
+    };
+
+    /**
+     * @brief Policy of distributing frames between the sockets of one PACKET_FANOUT group.
+     * Hash - by the flow hash of the frame, so all frames of the flow go to the same socket(IP fragments are defragmented).
+     * Cpu - by the CPU, which received the frame.
+     * RoundRobin - frame by frame in turn.
+     */
+    enum class FanoutMode {
+        Hash,
+        Cpu,
+        RoundRobin,
+    };
+
+    struct Statistics {
+        std::uint64_t receivedFrames = 0;
+        std::uint64_t droppedFrames = 0;
+        std::uint64_t freezeQueueCount = 0;
+    };
+
+    /**
+     * @brief This class represents of the block, which was retired by the kernel and belongs to user space now.
+     */
+    class Block final {
+    public:
+        SizeType getFrameCount() const;
+
+        /**
+         * @brief Calls the callback for every frame of the block.
+         * @details The callback is called as callback(frame) or callback(frame, info), the metadata is read only
+         * for the second form.
+         */
+        template<typename F>
+        void forEachFrame(F&& callback) const;
+
+    private:
+        friend PacketRxRing;
+        explicit Block(struct tpacket_block_desc* desc);
+
+        static FrameInfo GetFrameInfo(const struct tpacket3_hdr* frameHeader);
+
+        struct tpacket_block_desc* m_desc;
+    };
+
+    /**
+     * @brief Opens AF_PACKET socket, sets up the ring and binds the socket to the iface.
+     * @param ifaceName - name of the iface. Frames of all ifaces are captured if the name is empty.
+     * @throw std::runtime_error if the ring could not be set up.
+     */
+    explicit PacketRxRing(std::string_view ifaceName);
+    explicit PacketRxRing(std::string_view ifaceName, Configuration config);
+    ~PacketRxRing();
+
+    PacketRxRing(const PacketRxRing&) = delete;
+    PacketRxRing(PacketRxRing&&) = delete;
+    PacketRxRing& operator=(const PacketRxRing&) = delete;
+    PacketRxRing& operator=(PacketRxRing&&) = delete;
+
+    /**
+     * @brief Waits for the next retired block.
+     * @details The same block is returned until it is released by releaseBlock.
+     * @return std::nullopt if the timeout is expired.
+     */
+    std::optional<Block> nextBlock(int timeoutInMs = INFINITE_TIMEOUT);
+
+    /**
+     * @brief Returns the block back to the kernel. All frame views of the block become invalid.
+     */
+    void releaseBlock(Block block);
+
+    /**
+     * @brief Waits for the next retired block, calls the callback for every frame of the block and releases the block.
+     * @return count of the handled frames.
+     */
+    template<typename F>
+    SizeType dispatch(F&& callback, int timeoutInMs = INFINITE_TIMEOUT);
+
+    /**
+     * @brief Joins the socket to the PACKET_FANOUT group. All sockets of the group have to be bound to the same iface.
+     * @throw std::runtime_error if the socket could not join the group.
+     */
+    void joinFanoutGroup(std::uint16_t groupId, FanoutMode mode);
+
+    Statistics getStatistics();
+    const Configuration& getConfiguration() const;
+    int getSocket() const;
+
+private:
+    struct tpacket_block_desc* getBlockDesc(SizeType index) const;
+
+    Configuration m_config;
+    int m_socket;
+    ByteType* m_ring;
+    std::size_t m_ringSize;
+    SizeType m_currentBlock;
+    Statistics m_statistics;
+};
+
+inline PacketRxRing::SizeType PacketRxRing::Block::getFrameCount() const
+{
+    return m_desc->hdr.bh1.num_pkts;
+}
+
+inline PacketRxRing::FrameInfo PacketRxRing::Block::GetFrameInfo(const struct tpacket3_hdr* const frameHeader)
+{
+    // The kernel places sockaddr_ll right after the aligned frame header
+    const auto address = reinterpret_cast<const struct sockaddr_ll*>(
+        reinterpret_cast<const ByteType*>(frameHeader) + TPACKET_ALIGN(sizeof(struct tpacket3_hdr)));
+
+    FrameInfo info;
+    info.timestamp = std::chrono::seconds(frameHeader->tp_sec) + std::chrono::nanoseconds(frameHeader->tp_nsec);
+    info.originalLength = frameHeader->tp_len;
+    info.ifIndex = address->sll_ifindex;
+    info.rxHash = frameHeader->hv1.tp_rxhash;
+    info.direction = static_cast<FrameInfo::DirectionType>(address->sll_pkttype);
+    return info;
+}
+
+template<typename F>
+inline void PacketRxRing::Block::forEachFrame(F&& callback) const
+{
+    auto frameHeaderStart = reinterpret_cast<ByteType*>(m_desc) + m_desc->hdr.bh1.offset_to_first_pkt;
+    for (SizeType i = 0; i < getFrameCount(); ++i) {
+        const auto frameHeader = reinterpret_cast<const struct tpacket3_hdr*>(frameHeaderStart);
+        const ConstRawFrameViewType frame{ frameHeaderStart + frameHeader->tp_mac, frameHeader->tp_snaplen };
+        if constexpr (std::is_invocable_v<F, ConstRawFrameViewType, const FrameInfo&>) {
+            callback(frame, GetFrameInfo(frameHeader));
+        } else {
+            callback(frame);
+        }
+        frameHeaderStart += frameHeader->tp_next_offset;
+    }
+}
+
+template<typename F>
+inline PacketRxRing::SizeType PacketRxRing::dispatch(F&& callback, const int timeoutInMs)
+{
+    const auto block = nextBlock(timeoutInMs);
+    if (!block) {
+        return 0;
+    }
+
+    // The block has to be returned to the kernel even if the callback throws an exception
+    utils::ScopedLock blockLock([this, &block] {
+        releaseBlock(*block);
+    });
+
+    block->forEachFrame(std::forward<F>(callback));
+    return block->getFrameCount();
+}
+
+} //! namespace posnet
+
+#endif //! VS_PACKET_RX_RING_H
@@ -0,0 +1,157 @@
+#ifndef VS_PACKET_TX_RING_H
+#define VS_PACKET_TX_RING_H
+
+#include "include/base_frame.h"
+
+#include <string_view>
+#include <optional>
+#include <cstdint>
+
+#include <linux/if_packet.h>
+
+namespace posnet {
+
+/**
+ * @brief This class represents of memory-mapped transmit ring(PACKET_TX_RING, TPACKET_V2) of AF_PACKET socket.
+ * @details The frames are written directly into the slots of the ring, which is shared with the kernel by mmap.
+ * The builders(EthernetBuilder, IpBuilder, UdpBuilder, ...) are appended to the slot one by one, so the headers are
+ * placed in the slot without any intermediate buffer. The committed slots are handed over to the kernel in order
+ * and one send() call flushes all of them by one syscall.
+ * @example {
+ *              PacketTxRing ring("eth0");
+ *              for (auto i = 0; i < 64; ++i) {
+ *                  auto slot = ring.acquireSlot();
+ *                  slot->append(ethernetBuilder).append(ipBuilder).append(udpBuilder).append(payload);
+ *                  ring.commitSlot(*slot);
+ *              }
+ *              ring.send();
+ *          }
+ * @warning The frames have to contain the Ethernet header.
+ * @warning This class IS NOT THREAD SAFE.
+ */
+class PacketTxRing final {
+public:
+    static constexpr unsigned int DEFAULT_FRAME_SIZE_IN_BYTES = 1 << 11;
+    static constexpr unsigned int DEFAULT_FRAME_COUNT = 1 << 12;
+    static constexpr int NO_TIMEOUT = 0;
+    static constexpr int INFINITE_TIMEOUT = -1;
+
+    using ByteType = BaseFrame::ByteType;
+    using SizeType = BaseFrame::SizeType;
+    using RawFrameViewType = BaseFrame::RawFrameViewType;
+    using ConstRawFrameViewType = BaseFrame::ConstRawFrameViewType;
+
+    struct Configuration {
+        SizeType frameSizeInBytes = DEFAULT_FRAME_SIZE_IN_BYTES;
+        SizeType frameCount = DEFAULT_FRAME_COUNT;
+        // The frames are passed directly to the driver, bypassing the qdisc layer of the kernel
+        bool bypassQdisc = false;
+    };
+
+    struct Statistics {
+        // The frames, whose slots were returned by the kernel, they are counted by send and acquireSlot
+        std::uint64_t sentFrames = 0;
+        std::uint64_t sentBytes = 0;
+        // The frames, which were rejected by the kernel(TP_STATUS_WRONG_FORMAT), their slots are returned to the ring
+        std::uint64_t wrongFormatFrames = 0;
+        std::uint64_t sendCalls = 0;
+        std::uint64_t ringFullCount = 0;
+    };
+
+    /**
+     * @brief This class represents of the free slot of the ring, which belongs to user space until it is committed.
+     */
+    class Slot final {
+    public:
+        /**
+         * @brief Appends the header of the builder(or any other frame) to the end of the slot data.
+         * @throw std::runtime_error if the slot has not enough space.
+         */
+        Slot& append(const BaseFrame& frame);
+        Slot& append(ConstRawFrameViewType data);
+
+        /**
+         * @brief Reserves the space at the end of the slot data, the caller writes the data into the returned view.
+         * @throw std::runtime_error if the slot has not enough space.
+         */
+        RawFrameViewType reserve(SizeType size);
+
+        RawFrameViewType getData() const;
+        SizeType getSize() const;
+        SizeType getCapacity() const;
+
+    private:
+        friend PacketTxRing;
+        explicit Slot(struct tpacket2_hdr* header, ByteType* data, SizeType capacity);
+
+        struct tpacket2_hdr* m_header;
+        ByteType* m_data;
+        SizeType m_size;
+        SizeType m_capacity;
+    };
+
+    /**
+     * @brief Opens AF_PACKET socket, sets up the ring and binds the socket to the iface.
+     * @throw std::runtime_error if the ring could not be set up.
+     */
+    explicit PacketTxRing(std::string_view ifaceName);
+    explicit PacketTxRing(std::string_view ifaceName, Configuration config);
+    ~PacketTxRing();
+
+    PacketTxRing(const PacketTxRing&) = delete;
+    PacketTxRing(PacketTxRing&&) = delete;
+    PacketTxRing& operator=(const PacketTxRing&) = delete;
+    PacketTxRing& operator=(PacketTxRing&&) = delete;
+
+    /**
+     * @brief Returns the next free slot of the ring.
+     * @details The same slot is returned until it is committed by commitSlot.
+     * @param timeoutInMs - how long to wait for the kernel to free the slot if the ring is full.
+     * @return std::nullopt if the ring is full and the timeout is expired.
+     */
+    std::optional<Slot> acquireSlot(int timeoutInMs = NO_TIMEOUT);
+
+    /**
+     * @brief Hands over the slot to the kernel. The frame is transmitted by the next send() call.
+     * @throw std::runtime_error if the frame is shorter than the ethernet header.
+     */
+    void commitSlot(Slot slot);
+
+    /**
+     * @brief Flushes all committed slots by one syscall.
+     * @param waitForCompletion - block until all frames are transmitted.
+     * @return count of the flushed frames, zero if the kernel could not take them now(EAGAIN, ENOBUFS), in this case
+     * the frames stay pending and they are flushed by the next send or acquireSlot.
+     * @throw std::runtime_error if the frames could not be sent.
+     */
+    SizeType send(bool waitForCompletion = false);
+
+    SizeType getPendingFrameCount() const;
+    const Statistics& getStatistics() const;
+    const Configuration& getConfiguration() const;
+    int getSocket() const;
+
+private:
+    // Asks the kernel to transmit the requested slots, the frames stay pending if the kernel could not take them
+    SizeType kick(bool waitForCompletion);
+    // Counts the frames, whose slots were returned by the kernel, and returns the slots of the rejected frames to the ring
+    void reclaimFrames() noexcept;
+    struct tpacket2_hdr* getFrameHeader(SizeType index) const;
+
+    Configuration m_config;
+    SizeType m_blockSize;
+    int m_socket;
+    ByteType* m_ring;
+    std::size_t m_ringSize;
+    SizeType m_currentFrame;
+    // The committed frames, which were not taken by the kernel yet
+    SizeType m_pendingFrames;
+    // The oldest committed frame, whose slot was not returned by the kernel yet
+    SizeType m_oldestFrame;
+    SizeType m_inFlightFrames;
+    Statistics m_statistics;
+};
+
+} //! namespace posnet
+
+#endif //! VS_PACKET_TX_RING_H
@@ -0,0 +1,158 @@
+#ifndef VS_FRAME_POOL_H
+#define VS_FRAME_POOL_H
+
+#include "include/base_frame.h"
+
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <string_view>
+
+namespace posnet {
+
+/**
+ * @brief This class preallocates the fixed count of the frame buffers of the same size and hands them out to any thread.
+ * @details The region of the pool is mapped from 2 MiB hugepages(MAP_HUGETLB) if they are reserved in the system,
+ * otherwise from the regular pages, which are advised to be backed by the transparent hugepages(MADV_HUGEPAGE).
+ * So the frames of the whole pool are covered by a few TLB entries.
+ * The free frames are kept in the global lock-free stack(the index of the top frame is tagged by the counter
+ * against ABA). The threads take the frames through their own LocalCache, which refills itself from the global stack
+ * and flushes the surplus back by the batches of the half of its capacity, so most allocations do not touch the shared state.
+ * The pool also can be used without the cache(allocate/deallocate), every call is one operation on the global stack.
+ * @example {
+ *              FramePool pool(FramePool::Configuration{ .frameCount = 1 << 16 });
+ *              // in every worker thread
+ *              FramePool::LocalCache cache(pool);
+ *              auto frame = cache.allocate();
+ *              if (frame != nullptr) {
+ *                  // ...
+ *                  cache.deallocate(frame);
+ *              }
+ *          }
+ * @warning The pool has to outlive its caches and the frames have to be returned before the pool is destroyed.
+ */
+class FramePool final {
+public:
+    static constexpr unsigned int DEFAULT_FRAME_COUNT = 1 << 14;
+    static constexpr unsigned int DEFAULT_FRAME_SIZE_IN_BYTES = 2048;
+    static constexpr unsigned int FRAME_ALIGNMENT_IN_BYTES = 64;
+    static constexpr std::size_t HUGE_PAGE_SIZE_IN_BYTES = 2 * 1024 * 1024;
+
+    using ByteType = BaseFrame::ByteType;
+    using SizeType = BaseFrame::SizeType;
+
+    enum class PageType {
+        // MAP_HUGETLB
+        HugePages,
+        // The regular pages advised by MADV_HUGEPAGE
+        TransparentHugePages,
+        RegularPages,
+    };
+
+    struct Configuration {
+        SizeType frameCount = DEFAULT_FRAME_COUNT;
+        // The size is rounded up to FRAME_ALIGNMENT_IN_BYTES
+        SizeType frameSizeInBytes = DEFAULT_FRAME_SIZE_IN_BYTES;
+        bool useHugePages = true;
+    };
+
+    struct Statistics {
+        SizeType frameCount = 0;
+        // The frames in the global stack
+        SizeType availableFrames = 0;
+        // The frames taken from the global stack, which are used or kept by the local caches
+        SizeType occupiedFrames = 0;
+        std::uint64_t allocationFailures = 0;
+        std::uint64_t cacheRefills = 0;
+        std::uint64_t cacheFlushes = 0;
+    };
+
+    /**
+     * @brief The cache of the frames of one thread.
+     * @warning This class IS NOT THREAD SAFE, every thread has to have its own cache.
+     */
+    class LocalCache final {
+    public:
+        static constexpr unsigned int DEFAULT_CAPACITY = 64;
+
+        explicit LocalCache(FramePool& pool, SizeType capacity = DEFAULT_CAPACITY);
+        // The cached frames are flushed to the global stack
+        ~LocalCache();
+
+        LocalCache(const LocalCache&) = delete;
+        LocalCache(LocalCache&&) = delete;
+        LocalCache& operator=(const LocalCache&) = delete;
+        LocalCache& operator=(LocalCache&&) = delete;
+
+        /**
+         * @return the frame or nullptr if the cache and the global stack are empty.
+         */
+        ByteType* allocate() noexcept;
+        void deallocate(ByteType* frame) noexcept;
+        // Returns all cached frames to the global stack
+        void flush() noexcept;
+
+        SizeType getCachedCount() const noexcept;
+        FramePool& getPool() const noexcept;
+
+    private:
+        FramePool& m_pool;
+        SizeType m_capacity;
+        std::vector<ByteType*> m_frames;
+    };
+
+    /**
+     * @brief Maps the region of the pool.
+     * @throw std::runtime_error if the configuration is invalid or the region could not be mapped.
+     */
+    explicit FramePool(Configuration config);
+    ~FramePool();
+
+    FramePool(const FramePool&) = delete;
+    FramePool(FramePool&&) = delete;
+    FramePool& operator=(const FramePool&) = delete;
+    FramePool& operator=(FramePool&&) = delete;
+
+    /**
+     * @brief Takes the frame from the global stack, it is thread safe.
+     * @return the frame or nullptr if the pool is exhausted.
+     */
+    ByteType* allocate() noexcept;
+    void deallocate(ByteType* frame) noexcept;
+
+    bool owns(const ByteType* frame) const noexcept;
+    SizeType getFrameSize() const noexcept;
+    SizeType getFrameCount() const noexcept;
+    PageType getPageType() const noexcept;
+    Statistics getStatistics() const noexcept;
+
+private:
+    static constexpr std::uint32_t EMPTY_INDEX = UINT32_MAX;
+
+    // Pops up to count frames, the frames are written into frames
+    SizeType popFrames(ByteType** frames, SizeType count) noexcept;
+    void pushFrame(ByteType* frame) noexcept;
+
+    SizeType getFrameIndex(const ByteType* frame) const noexcept;
+
+    Configuration m_config;
+    SizeType m_frameSize;
+    std::size_t m_regionSize;
+    ByteType* m_region;
+    PageType m_pageType;
+    std::unique_ptr<std::atomic<std::uint32_t>[]> m_nextFrames;
+    // The index of the top frame in the low 32 bits and the ABA tag in the high 32 bits
+    alignas(FRAME_ALIGNMENT_IN_BYTES) std::atomic<std::uint64_t> m_head;
+    alignas(FRAME_ALIGNMENT_IN_BYTES) std::atomic<SizeType> m_availableFrames;
+    std::atomic<std::uint64_t> m_allocationFailures;
+    std::atomic<std::uint64_t> m_cacheRefills;
+    std::atomic<std::uint64_t> m_cacheFlushes;
+};
+
+std::string_view PageTypeToStr(FramePool::PageType pageType);
+
+} //! namespace posnet
+
+#endif //! VS_FRAME_POOL_H
@@ -0,0 +1,97 @@
+#ifndef VS_PACKET_BUFFER_H
+#define VS_PACKET_BUFFER_H
+
+#include "include/base_frame.h"
+
+#include <cstdint>
+
+namespace posnet {
+
+class PacketBufferPool;
+
+/**
+ * @brief This class represents of the buffer of one packet(similar to mbuf/skb), which is taken from PacketBufferPool.
+ * @details The data of the packet lies in the middle of the buffer: there is the headroom before the data and
+ * the tailroom after it. The payload is written first and then the headers are prepended layer by layer into
+ * the headroom(UdpBuilder::prependTo, IpBuilder::prependTo, EthernetBuilder::prependTo), so every header is written
+ * once into its final place and the assembled frame is never copied.
+ * Layout of the buffer:
+ * | headroom | data | tailroom |
+ * ^ start    ^ start + headroom        ^ start + capacity
+ * The buffer is the move-only handle, it returns the memory to the pool by the destructor.
+ * @example {
+ *              auto buffer = pool.acquire();
+ *              std::memcpy(buffer->append(payload.size()).data(), payload.data(), payload.size());
+ *              udpBuilder.prependTo(*buffer);
+ *              ipBuilder.prependTo(*buffer);
+ *              ethernetBuilder.prependTo(*buffer);
+ *              send(buffer->getData());
+ *          }
+ * @warning The pool has to outlive its buffers.
+ * @warning This class IS NOT THREAD SAFE, but the buffer may be passed to another thread as a whole.
+ */
+class PacketBuffer final {
+public:
+    using ByteType = BaseFrame::ByteType;
+    using SizeType = BaseFrame::SizeType;
+    using RawFrameViewType = BaseFrame::RawFrameViewType;
+    using ConstRawFrameViewType = BaseFrame::ConstRawFrameViewType;
+
+    ~PacketBuffer();
+
+    PacketBuffer(const PacketBuffer&) = delete;
+    PacketBuffer& operator=(const PacketBuffer&) = delete;
+    PacketBuffer(PacketBuffer&& other) noexcept;
+    PacketBuffer& operator=(PacketBuffer&& other) noexcept;
+
+    /**
+     * @brief Moves the start of the data into the headroom by size bytes.
+     * @return the view of the prepended bytes, the caller writes the header into it.
+     * @throw std::runtime_error if the headroom is less than size.
+     */
+    RawFrameViewType prepend(SizeType size);
+
+    /**
+     * @brief Moves the end of the data into the tailroom by size bytes.
+     * @return the view of the appended bytes.
+     * @throw std::runtime_error if the tailroom is less than size.
+     */
+    RawFrameViewType append(SizeType size);
+
+    /**
+     * @brief Removes size bytes from the start(e.g. the header of the received frame) or from the end of the data.
+     * @throw std::runtime_error if the data is shorter than size.
+     */
+    void trimFront(SizeType size);
+    void trimBack(SizeType size);
+
+    /**
+     * @brief Drops the data and moves its start to the offset headroom from the start of the buffer.
+     * @throw std::runtime_error if the headroom is greater than the capacity.
+     */
+    void reset(SizeType headroom);
+
+    RawFrameViewType getData() noexcept;
+    ConstRawFrameViewType getData() const noexcept;
+    SizeType getSize() const noexcept;
+    SizeType getHeadroom() const noexcept;
+    SizeType getTailroom() const noexcept;
+    SizeType getCapacity() const noexcept;
+    bool isValid() const noexcept;
+
+private:
+    friend PacketBufferPool;
+    explicit PacketBuffer(PacketBufferPool* pool, ByteType* start, SizeType capacity, SizeType headroom) noexcept;
+
+    void release() noexcept;
+
+    PacketBufferPool* m_pool;
+    ByteType* m_start;
+    SizeType m_capacity;
+    SizeType m_dataOffset;
+    SizeType m_size;
+};
+
+} //! namespace posnet
+
+#endif //! VS_PACKET_BUFFER_H
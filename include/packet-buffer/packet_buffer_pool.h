@@ -0,0 +1,103 @@
+#ifndef VS_PACKET_BUFFER_POOL_H
+#define VS_PACKET_BUFFER_POOL_H
+
+#include "include/packet-buffer/packet_buffer.h"
+#include "include/packet-buffer/frame_pool.h"
+
+#include <vector>
+#include <memory>
+#include <optional>
+#include <cstdint>
+
+namespace posnet {
+
+/**
+ * @brief This class preallocates the fixed count of PacketBuffer in one contiguous region and hands them out.
+ * @details Every buffer has the size headroomInBytes + tailroomInBytes, it is rounded up to BUFFER_ALIGNMENT_IN_BYTES,
+ * so the buffers do not share the cache lines. The data of the acquired buffer is empty and it starts after the headroom,
+ * so the whole tailroom is available for the payload and the whole headroom for the headers.
+ * The free buffers are kept in LIFO order, so the recently released(cache-hot) buffer is acquired first.
+ * The buffers also can be drawn from the shared FramePool(hugepage-backed) instead of the own region: then the capacity
+ * of every buffer is the frame size of FramePool, bufferCount limits the count of the buffers acquired from this pool
+ * at the same time and tailroomInBytes is not used. The frames are taken and returned through the own FramePool::LocalCache.
+ * @example {
+ *              PacketBufferPool pool(PacketBufferPool::Configuration{ .bufferCount = 4096 });
+ *              if (auto buffer = pool.acquire()) {
+ *                  // ...
+ *              } // the buffer is returned to the pool
+ *          }
+ * @warning This class IS NOT THREAD SAFE, the buffers have to be acquired and released from one thread.
+ */
+class PacketBufferPool final {
+public:
+    static constexpr unsigned int DEFAULT_BUFFER_COUNT = 1024;
+    // Enough for Ethernet, VLAN, IPv6 with options and TCP with options
+    static constexpr unsigned int DEFAULT_HEADROOM_IN_BYTES = 128;
+    static constexpr unsigned int DEFAULT_TAILROOM_IN_BYTES = 1920;
+    static constexpr unsigned int BUFFER_ALIGNMENT_IN_BYTES = 64;
+
+    using ByteType = PacketBuffer::ByteType;
+    using SizeType = PacketBuffer::SizeType;
+
+    struct Configuration {
+        SizeType bufferCount = DEFAULT_BUFFER_COUNT;
+        SizeType headroomInBytes = DEFAULT_HEADROOM_IN_BYTES;
+        SizeType tailroomInBytes = DEFAULT_TAILROOM_IN_BYTES;
+    };
+
+    struct Statistics {
+        std::uint64_t acquiredBuffers = 0;
+        std::uint64_t releasedBuffers = 0;
+        // The count of acquire calls, which found the pool empty
+        std::uint64_t exhaustedCount = 0;
+    };
+
+    /**
+     * @brief Allocates all buffers of the pool.
+     * @throw std::runtime_error if the configuration is invalid.
+     */
+    explicit PacketBufferPool(Configuration config);
+    /**
+     * @brief The buffers are drawn from framePool on demand.
+     * @throw std::runtime_error if the configuration is invalid or the headroom does not fit into the frame of framePool.
+     */
+    explicit PacketBufferPool(Configuration config, FramePool& framePool);
+    ~PacketBufferPool() = default;
+
+    PacketBufferPool(const PacketBufferPool&) = delete;
+    PacketBufferPool(PacketBufferPool&&) = delete;
+    PacketBufferPool& operator=(const PacketBufferPool&) = delete;
+    PacketBufferPool& operator=(PacketBufferPool&&) = delete;
+
+    /**
+     * @return the free buffer with the empty data after the headroom or std::nullopt if all buffers are in use
+     * (or FramePool is exhausted).
+     */
+    std::optional<PacketBuffer> acquire();
+
+    SizeType getFreeCount() const noexcept;
+    SizeType getBufferCount() const noexcept;
+    SizeType getBufferSize() const noexcept;
+    const Configuration& getConfiguration() const noexcept;
+    const Statistics& getStatistics() const noexcept;
+
+private:
+    friend PacketBuffer;
+    void release(ByteType* bufferStart) noexcept;
+
+    struct AlignedDeleter {
+        void operator()(ByteType* region) const noexcept;
+    };
+
+    Configuration m_config;
+    SizeType m_bufferSize;
+    std::unique_ptr<ByteType, AlignedDeleter> m_region;
+    std::vector<ByteType*> m_freeBuffers;
+    std::unique_ptr<FramePool::LocalCache> m_frameCache;
+    SizeType m_acquiredCount;
+    Statistics m_statistics;
+};
+
+} //! namespace posnet
+
+#endif //! VS_PACKET_BUFFER_POOL_H
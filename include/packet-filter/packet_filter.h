@@ -0,0 +1,96 @@
+#ifndef VS_PACKET_FILTER_H
+#define VS_PACKET_FILTER_H
+
+#include "include/base_frame.h"
+#include "include/utils/result.h"
+
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <linux/filter.h>
+
+namespace posnet {
+
+/**
+ * @brief This class represents of the frame filter compiled to classic BPF bytecode.
+ * @details The filter is compiled from the expression, which is a subset of the tcpdump language:
+ * primitives:  ip, arp, rarp, tcp, udp, icmp, ip proto N, ether proto N,
+ *              [src|dst] host A.B.C.D, [src|dst] net A.B.C.D/LEN, [tcp|udp] [src|dst] port N,
+ *              greater N(frame length >= N), less N(frame length <= N);
+ * operators:   not(!), and(&&), or(||), parentheses. The operators are listed by their precedence(the highest first).
+ * The same bytecode is attached to the socket(the kernel drops the unmatched frames before they are copied to user space)
+ * or is run by the user-space interpreter on the frames of the capture files.
+ * @example {
+ *              const auto filter = PacketFilter::Compile("ip and udp and dst port 53");
+ *              if (!filter) {
+ *                  std::cerr << filter.error().message << std::endl;
+ *              }
+ *              filter->attachTo(ring.getSocket());
+ *              // or offline
+ *              if (filter->match(record.frame)) { ... }
+ *          }
+ * @warning The bytecode expects the frames starting with Ethernet header(without VLAN tags), so it can be attached
+ * only to the packet sockets of SOCK_RAW type.
+ */
+class PacketFilter final {
+public:
+    using SizeType = BaseFrame::SizeType;
+    using ConstRawFrameViewType = BaseFrame::ConstRawFrameViewType;
+    using InstructionType = struct sock_filter;
+
+    // The matched frames are accepted entirely
+    static constexpr SizeType ACCEPT_LENGTH = 0x40000;
+
+    struct FilterError {
+        std::string message;
+        // The position of the invalid token in the expression
+        SizeType position;
+    };
+
+    using CompileResultType = utils::Result<PacketFilter, FilterError>;
+
+    /**
+     * @brief Compiles the expression to the bytecode. The empty expression matches all frames.
+     */
+    static CompileResultType Compile(std::string_view expression);
+
+    /**
+     * @brief Attaches the bytecode to the socket by SO_ATTACH_FILTER, the previous filter of the socket is replaced.
+     * @throw std::runtime_error if the filter could not be attached.
+     */
+    void attachTo(int socket) const;
+
+    /**
+     * @brief Detaches any filter from the socket by SO_DETACH_FILTER.
+     * @throw std::runtime_error if the filter could not be detached.
+     */
+    static void DetachFrom(int socket);
+
+    /**
+     * @brief Runs the bytecode on the frame by the user-space interpreter.
+     * @return count of bytes of the frame accepted by the filter, zero means the frame is dropped.
+     */
+    SizeType run(ConstRawFrameViewType frame) const;
+    bool match(ConstRawFrameViewType frame) const;
+
+    std::span<const InstructionType> getProgram() const;
+    const std::string& getExpression() const;
+
+private:
+    explicit PacketFilter(std::string expression, std::vector<InstructionType> program);
+
+    std::string m_expression;
+    std::vector<InstructionType> m_program;
+};
+
+/**
+ * @brief Runs any classic BPF program(the same as the kernel does for SO_ATTACH_FILTER) on the frame.
+ * @return the value returned by the program, zero for the invalid program or the out-of-bounds access.
+ */
+PacketFilter::SizeType RunBpfProgram(std::span<const PacketFilter::InstructionType> program, PacketFilter::ConstRawFrameViewType frame);
+
+} //! namespace posnet
+
+#endif //! VS_PACKET_FILTER_H
@@ -0,0 +1,234 @@
+#ifndef VS_PIPELINE_H
+#define VS_PIPELINE_H
+
+#include "include/frame_descriptor.h"
+#include "include/frame-dissector/parsed_frame.h"
+#include "include/packet-buffer/frame_pool.h"
+#include "include/utils/mpmc_ring.h"
+#include "include/utils/stage_controller.h"
+#include "include/utils/strict_mutex.h"
+
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <exception>
+#include <cstdint>
+
+namespace posnet {
+
+/**
+ * @brief The frame, which is passed between the stages of Pipeline.
+ * @details The frame is copied into the frame of FramePool by the capture stage, so it does not depend on the lifetime
+ * of the capture buffer(the block of PacketRxRing is returned to the kernel right after the capture stage).
+ * The frame is returned to FramePool after the last stage or when a stage drops it.
+ */
+struct PipelineFrame {
+    // It is filled by the dissect stage(e.g. FrameDissector::dissect), the capture stage leaves it empty
+    ParsedFrame parsedFrame;
+    FrameDescriptor descriptor;
+    // It is set by the stage, which does not pass the frame further(e.g. the filter stage)
+    bool isDropped = false;
+};
+
+/**
+ * @brief This class runs the staged processing of the captured frames: capture -> stage 1 -> ... -> stage N(sink).
+ * @details Every stage runs on its own group of threads, the neighbouring stages are connected by the bounded lock-free
+ * rings(MpmcRing) of PipelineFrame, which are passed by batches.
+ * The capture stage calls its handler in the loop, the handler takes the frames from any source(PacketRxRing,
+ * BatchReceiver, PcapReader, ...) and emits them by CaptureContext::emit, the frame is copied into the frame of FramePool.
+ * The processing stage calls its processor for every batch of its input ring, the processor can fill or read
+ * the frames of the batch and drop them(PipelineFrame::isDropped), the passed frames are forwarded to the next stage.
+ * The lifecycle of every stage is driven by its StageController(Created -> Running -> Draining -> Stopped):
+ * drain stops the capture stage, then every next stage is drained after the previous stage is stopped and its input ring
+ * is empty, so all captured frames reach the sink. stop stops all stages at once, the queued frames are discarded.
+ * The statistics of every stage(the processed and the dropped frames, the depth of the input ring, the time of waiting
+ * for the input or for the space of the output) are updated once per batch.
+ * @example {
+ *              FramePool framePool(FramePool::Configuration{});
+ *              const FrameDissector dissector;
+ *              Pipeline pipeline(Pipeline::Configuration{}, framePool,
+ *                  Pipeline::CaptureStage{ .handler = [&ring](Pipeline::CaptureContext& context) {
+ *                      ring.dispatch([&context](auto frame, const auto& info) { context.emit(frame, info); }, 100);
+ *                  } },
+ *                  {
+ *                      Pipeline::ProcessingStage{ .name = "dissect", .threadCount = 2, .processor = [&dissector](auto frames) {
+ *                          for (auto& frame : frames) {
+ *                              dissector.dissect(frame.descriptor.getAsRawFrameView(), frame.parsedFrame);
+ *                          }
+ *                      } },
+ *                      Pipeline::ProcessingStage{ .name = "sink", .processor = [](auto frames) { ... } },
+ *                  });
+ *              pipeline.start();
+ *              // ...
+ *              pipeline.drain();
+ *          }
+ * @warning The handler and the processor of the stage with several threads are called concurrently from all its threads.
+ * @warning The pipeline has to be drained or stopped before FramePool is destroyed(the destructor stops it).
+ */
+class Pipeline final {
+public:
+    static constexpr unsigned int DEFAULT_RING_CAPACITY = 4096;
+    static constexpr unsigned int DEFAULT_BATCH_SIZE = 64;
+
+    using ByteType = FrameDescriptor::ByteType;
+    using SizeType = FrameDescriptor::SizeType;
+    using ConstRawFrameViewType = FrameDescriptor::ConstRawFrameViewType;
+    using FrameInfo = FrameDescriptor::FrameInfo;
+    using RingType = utils::MpmcRing<PipelineFrame>;
+
+    enum class StageState {
+        Created,
+        Running,
+        Draining,
+        Stopped,
+    };
+
+private:
+    struct Stage;
+
+public:
+    struct Configuration {
+        // The capacity of every ring between the stages
+        SizeType ringCapacity = DEFAULT_RING_CAPACITY;
+        // The maximum count of the frames, which are passed to the processor at once
+        SizeType batchSize = DEFAULT_BATCH_SIZE;
+        // Drop - the frames, which do not fit into the ring of the next stage, are dropped and counted,
+        // Backpressure - the stage waits for the next stage, so the capture stage falls behind the source
+        utils::OverflowPolicy overflowPolicy = utils::OverflowPolicy::Backpressure;
+    };
+
+    class CaptureContext final {
+    public:
+        // The frames, which were not sent to the next stage, are returned to FramePool
+        ~CaptureContext();
+
+        CaptureContext(const CaptureContext&) = delete;
+        CaptureContext(CaptureContext&&) = delete;
+        CaptureContext& operator=(const CaptureContext&) = delete;
+        CaptureContext& operator=(CaptureContext&&) = delete;
+
+        /**
+         * @brief Copies the frame into the frame of FramePool and queues it for the next stage.
+         * @details The frame is truncated to the frame size of FramePool(FrameInfo::originalLength keeps the length).
+         * The queued frames are sent to the next stage by batches, at the latest when the handler returns.
+         * @return false if the frame was dropped, because FramePool is exhausted.
+         */
+        bool emit(ConstRawFrameViewType frame, const FrameInfo& info = FrameInfo{});
+        // The handler with the blocking source should return periodically if it is true
+        bool isStopRequested() const noexcept;
+        // The index of the thread of the capture stage, e.g. to select the socket of PACKET_FANOUT group
+        SizeType getThreadIndex() const noexcept;
+
+    private:
+        friend Pipeline;
+        explicit CaptureContext(Pipeline& pipeline, Stage& stage, SizeType threadIndex);
+
+        void flush();
+
+        Pipeline& m_pipeline;
+        Stage& m_stage;
+        SizeType m_threadIndex;
+        FramePool::LocalCache m_frameCache;
+        std::vector<PipelineFrame> m_batch;
+    };
+
+    using CaptureHandlerType = std::function<void(CaptureContext&)>;
+    using ProcessorType = std::function<void(std::span<PipelineFrame>)>;
+
+    struct CaptureStage {
+        std::string name = "capture";
+        SizeType threadCount = 1;
+        // It is called in the loop until the capture stage is drained or stopped
+        CaptureHandlerType handler;
+    };
+
+    struct ProcessingStage {
+        std::string name;
+        SizeType threadCount = 1;
+        ProcessorType processor;
+    };
+
+    struct StageStatistics {
+        std::string name;
+        StageState state = StageState::Created;
+        SizeType threadCount = 0;
+        // The frames, which were emitted(capture stage) or passed to the processor
+        std::uint64_t processedFrames = 0;
+        std::uint64_t processedBatches = 0;
+        // The frames, which were dropped by the processor or did not fit into the next ring(OverflowPolicy::Drop),
+        // or could not be emitted because FramePool was exhausted
+        std::uint64_t droppedFrames = 0;
+        // The count of the frames in the input ring
+        SizeType queueDepth = 0;
+        // The total time of all threads of the stage spent on waiting for the input frames or for the space of the next ring
+        std::chrono::nanoseconds stallTime = std::chrono::nanoseconds::zero();
+    };
+
+    /**
+     * @throw std::runtime_error if the configuration is invalid, the stage has no threads or no handler.
+     */
+    explicit Pipeline(Configuration config, FramePool& framePool, CaptureStage captureStage, std::vector<ProcessingStage> stages);
+    // The pipeline is stopped
+    ~Pipeline();
+
+    Pipeline(const Pipeline&) = delete;
+    Pipeline(Pipeline&&) = delete;
+    Pipeline& operator=(const Pipeline&) = delete;
+    Pipeline& operator=(Pipeline&&) = delete;
+
+    /**
+     * @brief Starts the threads of all stages.
+     * @throw std::runtime_error if the pipeline was already started.
+     */
+    void start();
+
+    /**
+     * @brief Stops the capture stage and waits until all captured frames pass all stages.
+     * @throw the exception of the handler or the processor, which stopped the pipeline.
+     */
+    void drain();
+
+    /**
+     * @brief Stops all stages at once, the frames in the rings are returned to FramePool.
+     * @throw the exception of the handler or the processor, which stopped the pipeline.
+     */
+    void stop();
+
+    // The pipeline is stopped if all its stages are stopped(drained, stopped or failed)
+    bool isStopped() const noexcept;
+    SizeType getStageCount() const noexcept;
+    std::vector<StageStatistics> getStatistics() const;
+
+private:
+    void runCapture(Stage& stage, SizeType threadIndex);
+    void runProcessing(Stage& stage);
+    void onThreadExit(Stage& stage) noexcept;
+    void onThreadError(std::exception_ptr error) noexcept;
+    // Sends the frames to the next ring of the stage according to the overflow policy, the frames, which were not sent,
+    // are returned to FramePool. It returns the count of the dropped frames
+    std::uint64_t forwardFrames(Stage& stage, std::span<PipelineFrame> frames, FramePool::LocalCache& frameCache);
+    void releaseFrames(std::span<const PipelineFrame> frames, FramePool::LocalCache& frameCache) noexcept;
+    void joinThreads();
+
+    Configuration m_config;
+    FramePool& m_framePool;
+    CaptureHandlerType m_captureHandler;
+    std::vector<std::unique_ptr<Stage>> m_stages;
+    // m_rings[i] is the input ring of m_stages[i + 1]
+    std::vector<std::unique_ptr<RingType>> m_rings;
+    std::vector<std::thread> m_threads;
+    // The first exception of the handler or the processor, it is rethrown by stop
+    utils::StrictMutex<std::exception_ptr> m_error;
+};
+
+std::string_view StageStateToStr(Pipeline::StageState state);
+
+} //! namespace posnet
+
+#endif //! VS_PIPELINE_H
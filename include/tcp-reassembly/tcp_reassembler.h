@@ -0,0 +1,207 @@
+#ifndef VS_TCP_REASSEMBLER_H
+#define VS_TCP_REASSEMBLER_H
+
+#include "include/base_frame.h"
+#include "include/flow-table/flow_table.h"
+#include "include/utils/timer_wheel.h"
+
+#include <array>
+#include <vector>
+#include <chrono>
+#include <functional>
+#include <string_view>
+#include <cstdint>
+
+namespace posnet {
+
+/**
+ * @brief This class reconstructs both byte streams of the observed TCP connections and delivers them in order.
+ * @details The connection is created by its first SYN or by its first segment with the payload: the sender of SYN(or
+ * the receiver of SYN+ACK, or the sender of the first segment if the handshake was not seen) is the client. The segments
+ * without the payload(e.g. the last ACK after both FINs) do not create the connection, so the closed connection is not
+ * reopened by them. The segment, which continues the stream, is passed to the data handler as the view of the processed
+ * packet, so the in-order bytes are never copied. The out-of-order segment is copied into the chunks of the pool
+ * of memoryLimitInBytes, which is allocated by the constructor, and it is delivered from the pool as soon as the hole
+ * before it is filled. The retransmitted bytes are delivered once(the first copy wins).
+ * The buffered segments are charged to maxBufferedBytesPerDirection by the whole chunks, so the direction, which sends
+ * the tiny out-of-order segments, can not take more chunks than its budget. If the budget or the pool is exhausted,
+ * the stream skips the hole up to the first buffered segment(the gap handler is called with the count of the lost bytes),
+ * so the stream never stalls on the segment, which was lost by the tap. If nothing is buffered and the segment still
+ * does not fit, the hole before the segment is skipped and it is delivered from the packet.
+ * The connection is closed after FIN of both directions is delivered, on RST, when it is idle for idleTimeout(TimerWheel
+ * driven by the timestamps of the processed packets) or by clear.
+ * @example {
+ *              TcpReassembler reassembler(TcpReassembler::Configuration{}, TcpReassembler::Handlers{
+ *                  .onData = [](const TcpReassembler::StreamInfo& stream, TcpReassembler::Direction direction, auto data) {
+ *                      // parse L7 protocol, the state is kept by stream.connectionId
+ *                  },
+ *                  .onClose = [](const TcpReassembler::StreamInfo& stream, TcpReassembler::CloseReason reason) { ... },
+ *              });
+ *              reassembler.process(ethernetViewer->getPayload(frame), info.timestamp);
+ *          }
+ * @warning This class IS NOT THREAD SAFE, it is meant to be owned by one capture(processing) thread. Both directions of
+ * the connection have to reach the same thread(e.g. PACKET_FANOUT group in Hash mode). The handlers must not call process.
+ */
+class TcpReassembler final {
+public:
+    static constexpr unsigned int CHUNK_SIZE_IN_BYTES = 2048;
+    static constexpr unsigned int DEFAULT_MAX_CONNECTION_COUNT = 1 << 16;
+    static constexpr unsigned int DEFAULT_MEMORY_LIMIT_IN_BYTES = 64 * 1024 * 1024;
+    static constexpr unsigned int DEFAULT_MAX_BUFFERED_BYTES_PER_DIRECTION = 256 * 1024;
+    static constexpr std::chrono::seconds DEFAULT_IDLE_TIMEOUT = std::chrono::seconds(120);
+
+    using ByteType = BaseFrame::ByteType;
+    using SizeType = BaseFrame::SizeType;
+    using ConstRawFrameViewType = BaseFrame::ConstRawFrameViewType;
+    using TimestampType = std::chrono::nanoseconds;
+
+    enum class Direction : std::uint8_t {
+        ClientToServer,
+        ServerToClient,
+    };
+
+    enum class CloseReason {
+        Fin,
+        Reset,
+        Timeout,
+        Clear,
+    };
+
+    struct StreamInfo {
+        // The key of the client to server direction
+        FlowKey key;
+        // The unique identifier of the connection, it is never reused
+        std::uint64_t connectionId = 0;
+        // The delivered bytes of every direction(Direction is the index)
+        std::array<std::uint64_t, 2> deliveredBytes{};
+    };
+
+    using DataHandlerType = std::function<void(const StreamInfo&, Direction, ConstRawFrameViewType)>;
+    using GapHandlerType = std::function<void(const StreamInfo&, Direction, std::uint32_t)>;
+    using CloseHandlerType = std::function<void(const StreamInfo&, CloseReason)>;
+
+    struct Handlers {
+        // The next in-order bytes of the direction, the view is valid only during the call
+        DataHandlerType onData;
+        // The count of the bytes, which were skipped, because the buffer of out-of-order segments overflowed
+        GapHandlerType onGap;
+        CloseHandlerType onClose;
+    };
+
+    struct Configuration {
+        SizeType maxConnectionCount = DEFAULT_MAX_CONNECTION_COUNT;
+        // The size of the pool of out-of-order segments of all connections
+        SizeType memoryLimitInBytes = DEFAULT_MEMORY_LIMIT_IN_BYTES;
+        // The budget of the out-of-order segments of one direction, the segment takes at least one chunk of it
+        SizeType maxBufferedBytesPerDirection = DEFAULT_MAX_BUFFERED_BYTES_PER_DIRECTION;
+        TimestampType idleTimeout = DEFAULT_IDLE_TIMEOUT;
+    };
+
+    struct Statistics {
+        std::uint64_t segments = 0;
+        std::uint64_t deliveredBytes = 0;
+        std::uint64_t outOfOrderSegments = 0;
+        // The segments, which carried only the already delivered bytes
+        std::uint64_t retransmittedSegments = 0;
+        std::uint64_t gaps = 0;
+        std::uint64_t gapBytes = 0;
+        // The out-of-order segments, which did not fit into the buffer, every overflow skips at least one hole
+        std::uint64_t bufferOverflows = 0;
+        // The connections, which were not tracked, because maxConnectionCount was reached
+        std::uint64_t connectionDrops = 0;
+        std::uint64_t createdConnections = 0;
+        std::uint64_t closedConnections = 0;
+        // The packets, which are not TCP, are malformed or do not belong to the tracked connection
+        std::uint64_t skippedPackets = 0;
+        SizeType activeConnections = 0;
+        SizeType bufferedBytes = 0;
+        SizeType usedMemoryInBytes = 0;
+    };
+
+    /**
+     * @brief Allocates the connections and the pool.
+     * @throw std::runtime_error if the configuration is invalid.
+     */
+    explicit TcpReassembler(Configuration config, Handlers handlers, TimestampType now = TimestampType::zero());
+
+    TcpReassembler(const TcpReassembler&) = delete;
+    TcpReassembler(TcpReassembler&&) = delete;
+    TcpReassembler& operator=(const TcpReassembler&) = delete;
+    TcpReassembler& operator=(TcpReassembler&&) = delete;
+
+    /**
+     * @brief Processes the IP packet, it expires the idle connections first.
+     * @param ipPacket - the view, which starts with IP header(e.g. EthernetViewer::getPayload or the datagram of IpReassembler).
+     * @return false if the packet was skipped, because it is not TCP, it is malformed or the connection is not tracked.
+     */
+    bool process(ConstRawFrameViewType ipPacket, TimestampType timestamp);
+    // Closes the idle connections, it should be called periodically if there are no packets
+    SizeType advance(TimestampType now);
+    // Closes all connections(CloseReason::Clear), the buffered segments after the holes are not delivered
+    void clear();
+
+    const Configuration& getConfiguration() const noexcept;
+    Statistics getStatistics() const noexcept;
+
+private:
+    static constexpr std::uint32_t NULL_INDEX = UINT32_MAX;
+
+    // The chunk of the out-of-order segment, the chunks of the direction are sorted by the sequence number
+    struct Chunk {
+        std::uint32_t sequence = 0;
+        std::uint32_t length = 0;
+        std::uint32_t next = NULL_INDEX;
+        std::array<ByteType, CHUNK_SIZE_IN_BYTES> data;
+    };
+
+    struct HalfStream {
+        bool isStarted = false;
+        bool hasFin = false;
+        bool isClosed = false;
+        // The sequence number of the next in-order byte
+        std::uint32_t nextSequence = 0;
+        std::uint32_t finSequence = 0;
+        std::uint32_t bufferedBytes = 0;
+        std::uint32_t chunkCount = 0;
+        std::uint32_t chunkHead = NULL_INDEX;
+    };
+
+    struct Connection {
+        StreamInfo info;
+        utils::TimerWheel::TimerIdType timerId = utils::TimerWheel::INVALID_TIMER_ID;
+        std::array<HalfStream, 2> halves;
+    };
+
+    std::uint32_t findConnection(const FlowKey& key) const noexcept;
+    std::uint32_t createConnection(const FlowKey& key, TimestampType timestamp);
+    void handleData(Connection& connection, Direction direction, std::uint32_t sequence, ConstRawFrameViewType payload);
+    bool bufferSegment(HalfStream& half, std::uint32_t sequence, ConstRawFrameViewType payload) noexcept;
+    void deliver(Connection& connection, Direction direction, ConstRawFrameViewType data);
+    // Delivers the buffered chunks, which became in-order
+    void drain(Connection& connection, Direction direction);
+    // Skips the hole before the first buffered chunk
+    void skipGap(Connection& connection, Direction direction);
+    void closeConnection(std::uint32_t index, CloseReason reason);
+    // Returns the chunks to the pool and the connection to the free list
+    void releaseConnection(std::uint32_t index) noexcept;
+
+    Configuration m_config;
+    Handlers m_handlers;
+    std::vector<Connection> m_connections;
+    std::vector<std::uint32_t> m_freeConnections;
+    // The open addressing index of the active connections by the client key, it is kept at most half full
+    std::vector<std::uint32_t> m_index;
+    std::uint32_t m_indexMask;
+    std::vector<Chunk> m_chunks;
+    std::vector<std::uint32_t> m_freeChunks;
+    utils::TimerWheel m_timerWheel;
+    std::uint64_t m_nextConnectionId;
+    Statistics m_statistics;
+};
+
+std::string_view DirectionToStr(TcpReassembler::Direction direction);
+std::string_view CloseReasonToStr(TcpReassembler::CloseReason reason);
+
+} //! namespace posnet
+
+#endif //! VS_TCP_REASSEMBLER_H
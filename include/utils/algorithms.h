@@ -2,16 +2,90 @@
 #define VS_ALGORITHMS_H
 
 #include <span>
+#include <string_view>
 #include <cstdint>
 
 namespace posnet::utils {
 
+/**
+ * @brief Implementations of the Internet checksum(RFC 1071).
+ * Scalar - portable implementation with 64-bit accumulator.
+ * Sse2, Avx2 - vectorized implementations, they are available only on x86 CPUs, which support these instruction sets.
+ */
+enum class ChecksumKernel {
+    Scalar,
+    Sse2,
+    Avx2,
+};
+
+/**
+ * @brief Calculates the Internet checksum of the packet.
+ * @details The fastest kernel, which is supported by the CPU, is selected once by the first call.
+ * @return checksum in host byte order.
+ */
 std::uint16_t CalcChecksum(std::span<const std::uint8_t> packet);
 std::uint16_t CalcChecksum(std::span<std::uint8_t> packet);
 
+/**
+ * @brief Calculates the Internet checksum of the packet by the specified kernel.
+ * @throw std::runtime_error if the kernel is not supported by the CPU.
+ */
+std::uint16_t CalcChecksum(std::span<const std::uint8_t> packet, ChecksumKernel kernel);
+
+ChecksumKernel GetChecksumKernel();
+bool IsChecksumKernelSupported(ChecksumKernel kernel);
+std::string_view ChecksumKernelToStr(ChecksumKernel kernel);
+
+/**
+ * @brief Updates the Internet checksum after the field of the packet has been changed(RFC 1624, eqn. 3).
+ * @details It takes O(1) instead of recalculating the checksum over the whole packet.
+ * The checksum and the values of the field are in host byte order, the same as CalcChecksum returns.
+ * The 32-bit version updates the field, which consists of two 16-bit words(e.g. ip-address).
+ * @example {
+ *              // TTL shares the 16-bit word with the protocol field of ip header
+ *              const auto checksum = UpdateChecksum16(oldChecksum, (oldTtl << 8) | protocol, (newTtl << 8) | protocol);
+ *          }
+ * @warning The field has to be aligned to the 16-bit word boundary of the summed data.
+ */
+std::uint16_t UpdateChecksum16(std::uint16_t checksum, std::uint16_t oldValue, std::uint16_t newValue);
+std::uint16_t UpdateChecksum32(std::uint16_t checksum, std::uint32_t oldValue, std::uint32_t newValue);
+
+/**
+ * @brief This class calculates the Internet checksum of the data, which is split into several segments
+ * (e.g. the pseudo header, the headers of the builders and the payload spans of the iovec chain), without copying them
+ * into one buffer.
+ * @details Every segment is summed by the same kernel as CalcChecksum. The segments may have any length, the segment,
+ * which starts at the odd offset of the summed data, is summed as byte-swapped(RFC 1071, section 2(B)).
+ * @example {
+ *              ChecksumAccumulator accumulator;
+ *              accumulator.add(header).add(payload0).add(payload1);
+ *              const auto checksum = accumulator.getChecksum(); // == CalcChecksum(header + payload0 + payload1)
+ *          }
+ */
+class ChecksumAccumulator final {
+public:
+    ChecksumAccumulator& add(std::span<const std::uint8_t> data) noexcept;
+    // Adds the 16-bit word in host byte order(e.g. the length of the pseudo header)
+    ChecksumAccumulator& addWord16(std::uint16_t word) noexcept;
+    // Adds the 32-bit word in host byte order
+    ChecksumAccumulator& addWord32(std::uint32_t word) noexcept;
+
+    /**
+     * @return checksum in host byte order, the same as CalcChecksum returns.
+     */
+    std::uint16_t getChecksum() const noexcept;
+    std::uint64_t getSizeInBytes() const noexcept;
+    void reset() noexcept;
+
+private:
+    // The folded sum of the words in the native byte order
+    std::uint32_t m_sum = 0;
+    std::uint64_t m_sizeInBytes = 0;
+};
+
 void HostBufferViewToNetwork(std::span<std::int8_t> buffer);
 void HostBufferViewToNetwork(std::span<std::uint8_t> buffer);
 
 } //! namespace posnet::utils
 
-#endif //! VS_ALGORITHMS_H
\ No newline at end of file
+#endif //! VS_ALGORITHMS_H
@@ -0,0 +1,58 @@
+#ifndef VS_BYTE_ORDER_H
+#define VS_BYTE_ORDER_H
+
+#include <bit>
+#include <cstdint>
+
+namespace posnet::utils {
+
+/**
+ * @brief The constexpr replacements of ntohs/ntohl/htons/htonl, they are inlined into the header-only accessors of the viewers
+ * and compile to one bswap(movbe) instruction.
+ */
+constexpr std::uint16_t ByteSwap16(const std::uint16_t value) noexcept
+{
+    return static_cast<std::uint16_t>((value << 8) | (value >> 8));
+}
+
+constexpr std::uint32_t ByteSwap32(const std::uint32_t value) noexcept
+{
+    return ((value & 0x000000FFu) << 24) | ((value & 0x0000FF00u) << 8) |
+        ((value & 0x00FF0000u) >> 8) | ((value & 0xFF000000u) >> 24);
+}
+
+constexpr std::uint16_t NetworkToHost16(const std::uint16_t value) noexcept
+{
+    if constexpr (std::endian::native == std::endian::little) {
+        return ByteSwap16(value);
+    } else {
+        return value;
+    }
+}
+
+constexpr std::uint32_t NetworkToHost32(const std::uint32_t value) noexcept
+{
+    if constexpr (std::endian::native == std::endian::little) {
+        return ByteSwap32(value);
+    } else {
+        return value;
+    }
+}
+
+constexpr std::uint16_t HostToNetwork16(const std::uint16_t value) noexcept
+{
+    return NetworkToHost16(value);
+}
+
+constexpr std::uint32_t HostToNetwork32(const std::uint32_t value) noexcept
+{
+    return NetworkToHost32(value);
+}
+
+static_assert(NetworkToHost16(HostToNetwork16(0x1234)) == 0x1234);
+static_assert(NetworkToHost32(HostToNetwork32(0x12345678)) == 0x12345678);
+static_assert(ByteSwap32(0x12345678) == 0x78563412);
+
+} //! namespace posnet::utils
+
+#endif //! VS_BYTE_ORDER_H
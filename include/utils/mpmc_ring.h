@@ -0,0 +1,268 @@
+#ifndef VS_MPMC_RING_H
+#define VS_MPMC_RING_H
+
+#include "include/utils/ring_policy.h"
+
+#include <span>
+#include <atomic>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+
+namespace posnet::utils {
+
+/**
+ * @brief The bounded lock-free ring of any count of the producer threads and the consumer threads.
+ * @details The capacity is rounded up to the power of two. Every slot has the sequence number, which says whether
+ * the slot is free for the producer of the current lap or filled for the consumer of the current lap(D. Vyukov's
+ * bounded queue), so the producers and the consumers synchronize on the slots and only claim the indices by CAS.
+ * The head index(consumers) and the tail index(producers) are kept on the separate cache lines.
+ * The batch calls claim the run of the ready slots by one CAS, so the batch costs one contended operation
+ * instead of one per value.
+ * @example {
+ *              MpmcRing<FrameDescriptor> ring(4096);
+ *              // any producer thread
+ *              if (!ring.enqueue(descriptor)) {
+ *                  // the ring is full, the descriptor is dropped and counted
+ *              }
+ *              // any consumer thread
+ *              FrameDescriptor descriptor;
+ *              while (ring.tryDequeue(descriptor)) {
+ *                  // ...
+ *              }
+ *          }
+ * @tparam T - Type of the values, it has to be default constructible and copy assignable.
+ * @tparam P - The policy of enqueue and enqueueBatch on the full ring.
+ */
+template<typename T, OverflowPolicy P = OverflowPolicy::Drop>
+class MpmcRing final {
+public:
+    static_assert(std::is_default_constructible_v<T> && std::is_copy_assignable_v<T>);
+
+    using ValueType = T;
+    using SizeType = std::size_t;
+    static constexpr OverflowPolicy OVERFLOW_POLICY = P;
+
+    /**
+     * @throw std::runtime_error if the capacity is zero.
+     */
+    explicit MpmcRing(SizeType capacity);
+
+    MpmcRing(const MpmcRing&) = delete;
+    MpmcRing(MpmcRing&&) = delete;
+    MpmcRing& operator=(const MpmcRing&) = delete;
+    MpmcRing& operator=(MpmcRing&&) = delete;
+
+    // It never blocks and does not count the rejected value as dropped
+    bool tryEnqueue(const T& value) noexcept;
+    /**
+     * @return false if the value was dropped(OverflowPolicy::Drop), always true for OverflowPolicy::Backpressure.
+     */
+    bool enqueue(const T& value) noexcept;
+    /**
+     * @return the count of the enqueued values, the rest of the values were dropped(OverflowPolicy::Drop).
+     * @warning The values of one batch can be interleaved with the values of the other producers.
+     */
+    SizeType enqueueBatch(std::span<const T> values) noexcept;
+
+    /**
+     * @return the count of the enqueued values, it never blocks and does not count the rest of the values as dropped.
+     */
+    SizeType tryEnqueueBatch(std::span<const T> values) noexcept;
+
+    bool tryDequeue(T& value) noexcept;
+    /**
+     * @return the count of the dequeued values(up to values.size()), it never blocks.
+     */
+    SizeType dequeueBatch(std::span<T> values) noexcept;
+
+    SizeType getCapacity() const noexcept;
+    // The approximate size
+    SizeType getSize() const noexcept;
+    bool isEmpty() const noexcept;
+    std::uint64_t getDroppedCount() const noexcept;
+
+private:
+    struct Slot {
+        std::atomic<SizeType> sequence;
+        T value;
+    };
+
+    alignas(CACHE_LINE_SIZE_IN_BYTES) std::atomic<SizeType> m_head;
+    alignas(CACHE_LINE_SIZE_IN_BYTES) std::atomic<SizeType> m_tail;
+    alignas(CACHE_LINE_SIZE_IN_BYTES) std::atomic<std::uint64_t> m_droppedCount;
+    alignas(CACHE_LINE_SIZE_IN_BYTES) SizeType m_mask;
+    std::unique_ptr<Slot[]> m_slots;
+};
+
+template<typename T, OverflowPolicy P>
+inline MpmcRing<T, P>::MpmcRing(const SizeType capacity):
+m_head(0),
+m_tail(0),
+m_droppedCount(0),
+m_mask(0),
+m_slots()
+{
+    if (capacity == 0) {
+        throw std::runtime_error("Could not create ring with zero capacity");
+    }
+
+    const auto roundedCapacity = RoundUpToPowerOfTwo(capacity);
+    m_mask = roundedCapacity - 1;
+    m_slots = std::make_unique<Slot[]>(roundedCapacity);
+    for (SizeType i = 0; i < roundedCapacity; ++i) {
+        m_slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+template<typename T, OverflowPolicy P>
+inline bool MpmcRing<T, P>::tryEnqueue(const T& value) noexcept
+{
+    return tryEnqueueBatch(std::span<const T>(&value, 1)) == 1;
+}
+
+template<typename T, OverflowPolicy P>
+inline bool MpmcRing<T, P>::enqueue(const T& value) noexcept
+{
+    return enqueueBatch(std::span<const T>(&value, 1)) == 1;
+}
+
+template<typename T, OverflowPolicy P>
+inline typename MpmcRing<T, P>::SizeType MpmcRing<T, P>::enqueueBatch(std::span<const T> values) noexcept
+{
+    if constexpr (P == OverflowPolicy::Drop) {
+        const auto count = tryEnqueueBatch(values);
+        if (count != values.size()) {
+            m_droppedCount.fetch_add(values.size() - count, std::memory_order_relaxed);
+        }
+        return count;
+    } else {
+        const auto totalCount = values.size();
+        Backoff backoff;
+        while (!values.empty()) {
+            const auto count = tryEnqueueBatch(values);
+            if (count == 0) {
+                backoff.pause();
+                continue;
+            }
+            backoff.reset();
+            values = values.subspan(count);
+        }
+        return totalCount;
+    }
+}
+
+template<typename T, OverflowPolicy P>
+inline typename MpmcRing<T, P>::SizeType MpmcRing<T, P>::tryEnqueueBatch(const std::span<const T> values) noexcept
+{
+    auto tail = m_tail.load(std::memory_order_relaxed);
+    while (true) {
+        // The slot is free for the producer of this lap if its sequence is equal to its index
+        SizeType count = 0;
+        while (count < values.size()) {
+            const auto sequence = m_slots[(tail + count) & m_mask].sequence.load(std::memory_order_acquire);
+            if (sequence != tail + count) {
+                break;
+            }
+            ++count;
+        }
+
+        if (count == 0) {
+            const auto sequence = m_slots[tail & m_mask].sequence.load(std::memory_order_acquire);
+            // The slot of the previous lap is not consumed yet, the ring is full
+            if (static_cast<std::intptr_t>(sequence - tail) < 0) {
+                return 0;
+            }
+            // Another producer has claimed the slot, the tail is reloaded
+            tail = m_tail.load(std::memory_order_relaxed);
+            continue;
+        }
+
+        // The slots are not touched by the consumers until their sequences are changed, and by the other producers
+        // until the tail is moved over them, so the claim by one CAS is enough
+        if (m_tail.compare_exchange_weak(tail, tail + count, std::memory_order_relaxed, std::memory_order_relaxed)) {
+            for (SizeType i = 0; i < count; ++i) {
+                auto& slot = m_slots[(tail + i) & m_mask];
+                slot.value = values[i];
+                slot.sequence.store(tail + i + 1, std::memory_order_release);
+            }
+            return count;
+        }
+    }
+}
+
+template<typename T, OverflowPolicy P>
+inline bool MpmcRing<T, P>::tryDequeue(T& value) noexcept
+{
+    return dequeueBatch(std::span<T>(&value, 1)) == 1;
+}
+
+template<typename T, OverflowPolicy P>
+inline typename MpmcRing<T, P>::SizeType MpmcRing<T, P>::dequeueBatch(const std::span<T> values) noexcept
+{
+    auto head = m_head.load(std::memory_order_relaxed);
+    while (true) {
+        // The slot is filled for the consumer of this lap if its sequence is equal to its index + 1
+        SizeType count = 0;
+        while (count < values.size()) {
+            const auto sequence = m_slots[(head + count) & m_mask].sequence.load(std::memory_order_acquire);
+            if (sequence != head + count + 1) {
+                break;
+            }
+            ++count;
+        }
+
+        if (count == 0) {
+            const auto sequence = m_slots[head & m_mask].sequence.load(std::memory_order_acquire);
+            // The slot is not filled yet, the ring is empty
+            if (static_cast<std::intptr_t>(sequence - (head + 1)) < 0) {
+                return 0;
+            }
+            head = m_head.load(std::memory_order_relaxed);
+            continue;
+        }
+
+        if (m_head.compare_exchange_weak(head, head + count, std::memory_order_relaxed, std::memory_order_relaxed)) {
+            const auto capacity = m_mask + 1;
+            for (SizeType i = 0; i < count; ++i) {
+                auto& slot = m_slots[(head + i) & m_mask];
+                values[i] = slot.value;
+                // The slot is free for the producer of the next lap
+                slot.sequence.store(head + i + capacity, std::memory_order_release);
+            }
+            return count;
+        }
+    }
+}
+
+template<typename T, OverflowPolicy P>
+inline typename MpmcRing<T, P>::SizeType MpmcRing<T, P>::getCapacity() const noexcept
+{
+    return m_mask + 1;
+}
+
+template<typename T, OverflowPolicy P>
+inline typename MpmcRing<T, P>::SizeType MpmcRing<T, P>::getSize() const noexcept
+{
+    const auto head = m_head.load(std::memory_order_acquire);
+    const auto tail = m_tail.load(std::memory_order_acquire);
+    return tail > head ? tail - head : 0;
+}
+
+template<typename T, OverflowPolicy P>
+inline bool MpmcRing<T, P>::isEmpty() const noexcept
+{
+    return getSize() == 0;
+}
+
+template<typename T, OverflowPolicy P>
+inline std::uint64_t MpmcRing<T, P>::getDroppedCount() const noexcept
+{
+    return m_droppedCount.load(std::memory_order_relaxed);
+}
+
+} //! namespace posnet::utils
+
+#endif //! VS_MPMC_RING_H
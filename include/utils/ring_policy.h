@@ -0,0 +1,66 @@
+#ifndef VS_RING_POLICY_H
+#define VS_RING_POLICY_H
+
+#include <thread>
+#include <cstddef>
+
+namespace posnet::utils {
+
+// The indices of the producers and the consumers of the rings are kept on the separate cache lines(no false sharing)
+inline constexpr std::size_t CACHE_LINE_SIZE_IN_BYTES = 64;
+
+/**
+ * @brief What enqueue/enqueueBatch of the ring do when the ring is full.
+ */
+enum class OverflowPolicy {
+    // The values, which do not fit, are dropped and counted, the producer is never blocked
+    Drop,
+    // The producer spins(and then yields) until the consumers free the slots, nothing is dropped
+    Backpressure,
+};
+
+/**
+ * @brief The spin-then-yield waiting of the producer or the consumer of the ring.
+ * @details The first SPIN_COUNT calls only spin(the other side usually frees the slot in a few hundred nanoseconds),
+ * the next calls yield the CPU, so the waiting thread does not starve the other side on the same core.
+ */
+class Backoff final {
+public:
+    static constexpr unsigned int SPIN_COUNT = 64;
+
+    void pause() noexcept;
+    void reset() noexcept;
+
+private:
+    unsigned int m_attempt = 0;
+};
+
+inline void Backoff::pause() noexcept
+{
+    if (m_attempt < SPIN_COUNT) {
+        ++m_attempt;
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#endif
+        return;
+    }
+    std::this_thread::yield();
+}
+
+inline void Backoff::reset() noexcept
+{
+    m_attempt = 0;
+}
+
+constexpr std::size_t RoundUpToPowerOfTwo(const std::size_t value) noexcept
+{
+    std::size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+} //! namespace posnet::utils
+
+#endif //! VS_RING_POLICY_H
@@ -0,0 +1,224 @@
+#ifndef VS_SPSC_RING_H
+#define VS_SPSC_RING_H
+
+#include "include/utils/ring_policy.h"
+
+#include <span>
+#include <atomic>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+
+namespace posnet::utils {
+
+/**
+ * @brief The bounded lock-free ring of one producer thread and one consumer thread.
+ * @details The capacity is rounded up to the power of two. The producer owns the tail index and the consumer owns
+ * the head index, both indices grow monotonically and every one is kept on its own cache line with the cached copy
+ * of the index of the other side, so the shared cache line is read only when the cached copy says the ring is full(empty).
+ * The batch calls publish the whole batch by one store of the index.
+ * @example {
+ *              SpscRing<FrameDescriptor, OverflowPolicy::Backpressure> ring(4096);
+ *              // the producer thread
+ *              ring.enqueueBatch(descriptors);
+ *              // the consumer thread
+ *              std::array<FrameDescriptor, 64> batch;
+ *              const auto count = ring.dequeueBatch(batch);
+ *          }
+ * @warning Only one thread may call the enqueue methods and only one thread may call the dequeue methods.
+ * @tparam T - Type of the values, it has to be default constructible and copy assignable.
+ * @tparam P - The policy of enqueue and enqueueBatch on the full ring.
+ */
+template<typename T, OverflowPolicy P = OverflowPolicy::Drop>
+class SpscRing final {
+public:
+    static_assert(std::is_default_constructible_v<T> && std::is_copy_assignable_v<T>);
+
+    using ValueType = T;
+    using SizeType = std::size_t;
+    static constexpr OverflowPolicy OVERFLOW_POLICY = P;
+
+    /**
+     * @throw std::runtime_error if the capacity is zero.
+     */
+    explicit SpscRing(SizeType capacity);
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing(SpscRing&&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+    SpscRing& operator=(SpscRing&&) = delete;
+
+    // It never blocks and does not count the rejected value as dropped
+    bool tryEnqueue(const T& value) noexcept;
+    /**
+     * @return false if the value was dropped(OverflowPolicy::Drop), always true for OverflowPolicy::Backpressure.
+     */
+    bool enqueue(const T& value) noexcept;
+    /**
+     * @return the count of the enqueued values, the rest of the values were dropped(OverflowPolicy::Drop).
+     */
+    SizeType enqueueBatch(std::span<const T> values) noexcept;
+
+    /**
+     * @return the count of the enqueued values, it never blocks and does not count the rest of the values as dropped.
+     */
+    SizeType tryEnqueueBatch(std::span<const T> values) noexcept;
+
+    bool tryDequeue(T& value) noexcept;
+    /**
+     * @return the count of the dequeued values(up to values.size()), it never blocks.
+     */
+    SizeType dequeueBatch(std::span<T> values) noexcept;
+
+    SizeType getCapacity() const noexcept;
+    // The approximate size, if it is called not by the producer or the consumer
+    SizeType getSize() const noexcept;
+    bool isEmpty() const noexcept;
+    std::uint64_t getDroppedCount() const noexcept;
+
+private:
+    // The consumer side
+    alignas(CACHE_LINE_SIZE_IN_BYTES) std::atomic<SizeType> m_head;
+    SizeType m_cachedTail;
+    // The producer side
+    alignas(CACHE_LINE_SIZE_IN_BYTES) std::atomic<SizeType> m_tail;
+    SizeType m_cachedHead;
+    std::atomic<std::uint64_t> m_droppedCount;
+    // The constant part
+    alignas(CACHE_LINE_SIZE_IN_BYTES) SizeType m_mask;
+    std::unique_ptr<T[]> m_slots;
+};
+
+template<typename T, OverflowPolicy P>
+inline SpscRing<T, P>::SpscRing(const SizeType capacity):
+m_head(0),
+m_cachedTail(0),
+m_tail(0),
+m_cachedHead(0),
+m_droppedCount(0),
+m_mask(0),
+m_slots()
+{
+    if (capacity == 0) {
+        throw std::runtime_error("Could not create ring with zero capacity");
+    }
+
+    const auto roundedCapacity = RoundUpToPowerOfTwo(capacity);
+    m_mask = roundedCapacity - 1;
+    m_slots = std::make_unique<T[]>(roundedCapacity);
+}
+
+template<typename T, OverflowPolicy P>
+inline bool SpscRing<T, P>::tryEnqueue(const T& value) noexcept
+{
+    return tryEnqueueBatch(std::span<const T>(&value, 1)) == 1;
+}
+
+template<typename T, OverflowPolicy P>
+inline bool SpscRing<T, P>::enqueue(const T& value) noexcept
+{
+    return enqueueBatch(std::span<const T>(&value, 1)) == 1;
+}
+
+template<typename T, OverflowPolicy P>
+inline typename SpscRing<T, P>::SizeType SpscRing<T, P>::enqueueBatch(std::span<const T> values) noexcept
+{
+    if constexpr (P == OverflowPolicy::Drop) {
+        const auto count = tryEnqueueBatch(values);
+        if (count != values.size()) {
+            m_droppedCount.fetch_add(values.size() - count, std::memory_order_relaxed);
+        }
+        return count;
+    } else {
+        const auto totalCount = values.size();
+        Backoff backoff;
+        while (!values.empty()) {
+            const auto count = tryEnqueueBatch(values);
+            if (count == 0) {
+                backoff.pause();
+                continue;
+            }
+            backoff.reset();
+            values = values.subspan(count);
+        }
+        return totalCount;
+    }
+}
+
+template<typename T, OverflowPolicy P>
+inline typename SpscRing<T, P>::SizeType SpscRing<T, P>::tryEnqueueBatch(const std::span<const T> values) noexcept
+{
+    const auto tail = m_tail.load(std::memory_order_relaxed);
+    const auto capacity = m_mask + 1;
+    if (tail - m_cachedHead + values.size() > capacity) {
+        m_cachedHead = m_head.load(std::memory_order_acquire);
+    }
+
+    const auto count = std::min<SizeType>(values.size(), capacity - (tail - m_cachedHead));
+    for (SizeType i = 0; i < count; ++i) {
+        m_slots[(tail + i) & m_mask] = values[i];
+    }
+
+    if (count != 0) {
+        m_tail.store(tail + count, std::memory_order_release);
+    }
+    return count;
+}
+
+template<typename T, OverflowPolicy P>
+inline bool SpscRing<T, P>::tryDequeue(T& value) noexcept
+{
+    return dequeueBatch(std::span<T>(&value, 1)) == 1;
+}
+
+template<typename T, OverflowPolicy P>
+inline typename SpscRing<T, P>::SizeType SpscRing<T, P>::dequeueBatch(const std::span<T> values) noexcept
+{
+    const auto head = m_head.load(std::memory_order_relaxed);
+    if (m_cachedTail - head < values.size()) {
+        m_cachedTail = m_tail.load(std::memory_order_acquire);
+    }
+
+    const auto count = std::min<SizeType>(values.size(), m_cachedTail - head);
+    for (SizeType i = 0; i < count; ++i) {
+        values[i] = m_slots[(head + i) & m_mask];
+    }
+
+    if (count != 0) {
+        m_head.store(head + count, std::memory_order_release);
+    }
+    return count;
+}
+
+template<typename T, OverflowPolicy P>
+inline typename SpscRing<T, P>::SizeType SpscRing<T, P>::getCapacity() const noexcept
+{
+    return m_mask + 1;
+}
+
+template<typename T, OverflowPolicy P>
+inline typename SpscRing<T, P>::SizeType SpscRing<T, P>::getSize() const noexcept
+{
+    const auto head = m_head.load(std::memory_order_acquire);
+    const auto tail = m_tail.load(std::memory_order_acquire);
+    return tail > head ? tail - head : 0;
+}
+
+template<typename T, OverflowPolicy P>
+inline bool SpscRing<T, P>::isEmpty() const noexcept
+{
+    return getSize() == 0;
+}
+
+template<typename T, OverflowPolicy P>
+inline std::uint64_t SpscRing<T, P>::getDroppedCount() const noexcept
+{
+    return m_droppedCount.load(std::memory_order_relaxed);
+}
+
+} //! namespace posnet::utils
+
+#endif //! VS_SPSC_RING_H
@@ -1,4 +1,5 @@
 #ifndef VS_STAGE_CONTROLLER_H
+#define VS_STAGE_CONTROLLER_H
 
 #include <type_traits>
 #include <initializer_list>
@@ -21,11 +22,11 @@
 
     // from thread 1
     {
-        std::Optional<Stages> prevSatge;
+        std::optional<Stages> prevStage;
         if (gStageController.gotoNextStageIfCurrentStage({
                 Stages::Stage1, Stages::Stage2 // We expect that the current stage to one from this set!
             }, Stages::Stage3, prevStage)) {
-            // We have changed current stage from *prevSatge to Stages::Stage3 atomically
+            // We have changed current stage from *prevStage to Stages::Stage3 atomically
         } else {
             // We have not changed current stage, but another thread could change
         }
@@ -36,7 +37,7 @@
         gStageController.setNextStageStrongly(Stages::Stage4);
     }
 
-@see real use cases in utils/ipc/msg_broker/VS_Subscriber.h
+@see real use cases in include/pipeline/pipeline.h
 */
 namespace posnet::utils {
 
@@ -52,18 +53,24 @@ public:
     template<typename C>
     bool gotoNextStageIfCurrentStage(C prevStage, C nextStage) = delete;
     template<typename C>
-    bool gotoNextStageIfCurrentStage(const std::initializer_list<C>& setOfPossibleValuesForCurrentStage, C nextStage, std::optional<C>& prevStage = {}) = delete;
+    bool gotoNextStageIfCurrentStage(const std::initializer_list<C>& setOfPossibleValuesForCurrentStage, C nextStage) = delete;
+    template<typename C>
+    bool gotoNextStageIfCurrentStage(const std::initializer_list<C>& setOfPossibleValuesForCurrentStage, C nextStage, std::optional<C>& prevStage) = delete;
     template<typename C>
     void setNextStageStrongly(C nextStage) = delete;
 
-    bool [[nodiscard]] gotoNextStage(T nextStage);
-    bool [[nodiscard]] gotoNextStageIfCurrentStage(T probableCurrentStage, T nextStage);
-    bool [[nodiscard]] gotoNextStageIfCurrentStage(
+    [[nodiscard]] bool gotoNextStage(T nextStage);
+    [[nodiscard]] bool gotoNextStageIfCurrentStage(T probableCurrentStage, T nextStage);
+    [[nodiscard]] bool gotoNextStageIfCurrentStage(
+        const std::initializer_list<T>& setOfPossibleValuesForCurrentStage,
+        T nextStage
+    );
+    [[nodiscard]] bool gotoNextStageIfCurrentStage(
         const std::initializer_list<T>& setOfPossibleValuesForCurrentStage,
         T nextStage,
-        std::optional<T>& prevStage = {}
+        std::optional<T>& prevStage
     );
-    T [[nodiscard]] getCurrentStage() const;
+    [[nodiscard]] T getCurrentStage() const;
     void setNextStageStrongly(T nextStage);
 
 private:
@@ -88,6 +95,16 @@ bool StageController<T>::gotoNextStageIfCurrentStage(T probableCurrentStage, con
     return m_stage.compare_exchange_strong(probableCurrentStage, nextStage);
 }
 
+template<typename T>
+inline bool StageController<T>::gotoNextStageIfCurrentStage(
+    const std::initializer_list<T>& setOfPossibleValueForCurrentStage,
+    const T nextStage
+)
+{
+    std::optional<T> prevStage;
+    return gotoNextStageIfCurrentStage(setOfPossibleValueForCurrentStage, nextStage, prevStage);
+}
+
 template<typename T>
 inline bool StageController<T>::gotoNextStageIfCurrentStage(
     const std::initializer_list<T>& setOfPossibleValueForCurrentStage,
@@ -116,6 +133,6 @@ inline void StageController<T>::setNextStageStrongly(const T nextStage)
     m_stage.store(nextStage);
 }
 
-} //! namespace posnet::utils 
+} //! namespace posnet::utils
 
-#endif VS_STAGE_CONTROLLER_H
+#endif //! VS_STAGE_CONTROLLER_H
@@ -0,0 +1,180 @@
+#ifndef VS_TIMER_WHEEL_H
+#define VS_TIMER_WHEEL_H
+
+#include <array>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+
+namespace posnet::utils {
+
+/**
+ * @brief The hierarchical timing wheel of the timeouts of the stateful entries(flows, ip fragments, neighbour entries).
+ * @details The wheel has LEVEL_COUNT levels of SLOT_COUNT slots, the slot of level 0 covers one tick, the slot of level N
+ * covers SLOT_COUNT^N ticks, so the wheel covers 2^32 ticks(~50 days with 1ms tick). The timer is put into the slot
+ * of the lowest level, which covers its expiry, and it is moved one level down when the lower level wraps around(cascade),
+ * so schedule, cancel and reschedule are O(1), and advance is O(1) per tick plus the fired and the cascaded timers.
+ * The ticks are skipped up to the next cascade of the lowest non-empty level, so advance over the long gap between
+ * the packets takes at most LEVEL_COUNT * SLOT_COUNT steps plus the fired and the cascaded timers.
+ * The timers are kept in one pool and linked by the indices, the memory is reused after the timer fires or is cancelled.
+ * The wheel is driven by the time, which is passed to advance: the timestamps of the packets or the monotonic clock.
+ * The timer never fires before its expiry, it fires at the first advance, which reaches the tick of the expiry.
+ * @example {
+ *              TimerWheel wheel(TimerWheel::Configuration{ .tickDuration = std::chrono::milliseconds(10) }, info.timestamp);
+ *              const auto timerId = wheel.schedule(info.timestamp + std::chrono::seconds(30), flowIndex);
+ *              // the next packet of the flow
+ *              wheel.reschedule(timerId, info.timestamp + std::chrono::seconds(30));
+ *              // once per batch of the packets
+ *              wheel.advance(info.timestamp, [](TimerWheel::TimerIdType timerId, std::uint64_t flowIndex) {
+ *                  // expire the flow
+ *              });
+ *          }
+ * @warning This class IS NOT THREAD SAFE, it is meant to be owned by one capture(processing) thread.
+ * The callback of advance can schedule, reschedule and cancel the timers, but it must not call advance.
+ */
+class TimerWheel final {
+public:
+    static constexpr unsigned int SLOT_BITS = 8;
+    static constexpr unsigned int SLOT_COUNT = 1 << SLOT_BITS;
+    static constexpr unsigned int LEVEL_COUNT = 4;
+    static constexpr unsigned int DEFAULT_INITIAL_CAPACITY = 1024;
+    static constexpr std::chrono::milliseconds DEFAULT_TICK_DURATION = std::chrono::milliseconds(1);
+
+    using SizeType = std::size_t;
+    using TimestampType = std::chrono::nanoseconds;
+    // The identifier is never reused: it keeps the generation of the pool entry, so the stale identifier is rejected
+    using TimerIdType = std::uint64_t;
+
+    static constexpr TimerIdType INVALID_TIMER_ID = 0;
+
+    struct Configuration {
+        // The resolution of the wheel, the expiry is rounded up to the tick
+        TimestampType tickDuration = DEFAULT_TICK_DURATION;
+        // The count of the timers, which are allocated at once, the pool grows on demand
+        SizeType initialCapacity = DEFAULT_INITIAL_CAPACITY;
+    };
+
+    /**
+     * @param now - the start time of the wheel.
+     * @throw std::runtime_error if the tick duration is not positive.
+     */
+    explicit TimerWheel(Configuration config, TimestampType now = TimestampType::zero());
+
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel(TimerWheel&&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+    TimerWheel& operator=(TimerWheel&&) = delete;
+
+    /**
+     * @brief Schedules the timer, the timer with the expiry in the past fires at the advance, which reaches the next tick.
+     * @param userData - the value, which is passed to the callback of advance(e.g. the index of the entry).
+     */
+    TimerIdType schedule(TimestampType expiry, std::uint64_t userData);
+    // Schedules the timer relative to the time of the last advance
+    TimerIdType scheduleAfter(TimestampType timeout, std::uint64_t userData);
+    /**
+     * @brief Moves the active timer to the new expiry.
+     * @return false if the timer already fired or was cancelled.
+     */
+    bool reschedule(TimerIdType timerId, TimestampType expiry) noexcept;
+    /**
+     * @return false if the timer already fired or was cancelled.
+     */
+    bool cancel(TimerIdType timerId) noexcept;
+    bool isActive(TimerIdType timerId) const noexcept;
+
+    /**
+     * @brief Fires all timers, which expire not later than now, in the order of their ticks.
+     * @param onExpired - the callback void(TimerIdType, std::uint64_t userData), the timer is released before the call.
+     * @return the count of the fired timers.
+     */
+    template<typename F>
+    SizeType advance(TimestampType now, F&& onExpired);
+
+    // The time of the last advance(or of the construction)
+    TimestampType getCurrentTime() const noexcept;
+    SizeType getTimerCount() const noexcept;
+    const Configuration& getConfiguration() const noexcept;
+
+private:
+    static constexpr std::uint32_t NULL_INDEX = UINT32_MAX;
+    static constexpr std::uint32_t SLOT_MASK = SLOT_COUNT - 1;
+
+    struct Timer {
+        std::uint64_t expiryTick = 0;
+        std::uint64_t userData = 0;
+        // The links of the slot list, next is the link of the free list for the released timer
+        std::uint32_t prev = NULL_INDEX;
+        std::uint32_t next = NULL_INDEX;
+        std::uint32_t generation = 1;
+        // The slot of the active timer, it is the index in m_slots
+        std::uint32_t slot = NULL_INDEX;
+    };
+
+    std::uint64_t toTick(TimestampType timestamp) const noexcept;
+    std::uint64_t toExpiryTick(TimestampType expiry) const noexcept;
+    std::uint32_t findTimer(TimerIdType timerId) const noexcept;
+    TimerIdType makeId(std::uint32_t index) const noexcept;
+    std::uint32_t allocate();
+    void release(std::uint32_t index) noexcept;
+    void link(std::uint32_t index) noexcept;
+    void unlink(std::uint32_t index) noexcept;
+    // Moves the timers of the higher levels down if the current tick wraps level 0, returns the slot of the current tick
+    std::uint32_t cascade() noexcept;
+    // Returns the mask of the ticks, which can be skipped: no timer fires and no non-empty slot is cascaded at them
+    std::uint64_t getSkipMask() const noexcept;
+    // Unlinks the first timer of the slot of level 0, which is expired, NULL_INDEX if the slot is empty
+    std::uint32_t popExpired(std::uint32_t slot) noexcept;
+
+    Configuration m_config;
+    std::vector<Timer> m_timers;
+    std::uint32_t m_freeHead;
+    // The heads of the slot lists: level * SLOT_COUNT + slot
+    std::array<std::uint32_t, LEVEL_COUNT * SLOT_COUNT> m_slots;
+    std::array<SizeType, LEVEL_COUNT> m_levelTimerCounts;
+    SizeType m_timerCount;
+    // The next tick, which is processed by advance
+    std::uint64_t m_currentTick;
+    TimestampType m_currentTime;
+};
+
+template<typename F>
+inline TimerWheel::SizeType TimerWheel::advance(const TimestampType now, F&& onExpired)
+{
+    const auto targetTick = toTick(now);
+    SizeType count = 0;
+    while (m_currentTick <= targetTick) {
+        if (m_timerCount == 0) {
+            m_currentTick = targetTick + 1;
+            break;
+        }
+
+        // Nothing can fire until the lowest non-empty level is cascaded, so the ticks before its next boundary are skipped
+        const auto skipMask = getSkipMask();
+        if ((m_currentTick & skipMask) != 0) {
+            const auto nextCascadeTick = (m_currentTick | skipMask) + 1;
+            m_currentTick = nextCascadeTick <= targetTick ? nextCascadeTick : targetTick + 1;
+            continue;
+        }
+
+        const auto slot = cascade();
+        for (auto index = popExpired(slot); index != NULL_INDEX; index = popExpired(slot)) {
+            const auto timerId = makeId(index);
+            const auto userData = m_timers[index].userData;
+            release(index);
+            ++count;
+            onExpired(timerId, userData);
+        }
+        ++m_currentTick;
+    }
+
+    if (now > m_currentTime) {
+        m_currentTime = now;
+    }
+    return count;
+}
+
+} //! namespace posnet::utils
+
+#endif //! VS_TIMER_WHEEL_H
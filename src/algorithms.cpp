@@ -1,57 +1,302 @@
 #include "include/utils/algorithms.h"
 
-namespace posnet::utils {
+#include <atomic>
+#include <bit>
+#include <stdexcept>
+#include <string>
+#include <cstring>
+#include <cstddef>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define POSNET_X86_CHECKSUM_KERNELS
+#include <immintrin.h>
+#endif
+
+namespace {
 
-std::uint16_t CalcChecksum(std::span<const std::uint8_t> packet)
+/*
+ * All kernels sum the packet as the words in the native byte order and swap the bytes of the folded result.
+ * The one's complement sum does not depend on the byte order(RFC 1071, section 2(B)), so the result is equal to
+ * the sum of the big-endian 16-bit words. The words are accumulated as 32-bit values into 64-bit accumulators,
+ * because 2^16 == 1 modulo 0xFFFF, so the sum of the 32-bit words folds to the same 16-bit value.
+ */
+using SumFunctionType = std::uint64_t(*)(const std::uint8_t* data, std::size_t size);
+
+// The packets, which are shorter than one iteration of the vector kernels(e.g. the headers), are summed inline,
+// because the indirect call of the kernel costs more than the sum itself
+constexpr std::size_t INLINE_SUM_MAX_SIZE = 64;
+
+std::uint64_t SumTail(const std::uint8_t* const data, const std::size_t size)
 {
-    uint32_t sum = 0;  // Используем uint32_t для хранения суммы, чтобы избежать переполнения
+    std::uint64_t sum = 0;
+    std::size_t i = 0;
+    for (; i + 4 <= size; i += 4) {
+        std::uint32_t word;
+        std::memcpy(&word, data + i, sizeof(word));
+        sum += word;
+    }
 
-    // Суммируем все 16-битные слова
-    for (auto i = 0; i + 1 < packet.size(); i += 2) {
-        sum += (packet[i] << 8) | packet[i + 1];
+    for (; i + 2 <= size; i += 2) {
+        std::uint16_t word;
+        std::memcpy(&word, data + i, sizeof(word));
+        sum += word;
     }
 
-    // Если есть нечетный байт, добавляем его в сумму
-    if (packet.size() % 2 == 1) {
-        sum += packet[packet.size() - 1] << 8;
+    // The odd byte is the first(high in network byte order) byte of the last word, the second byte is padded by zero
+    if (i < size) {
+        std::uint8_t lastWord[2] = { data[i], 0 };
+        std::uint16_t word;
+        std::memcpy(&word, lastWord, sizeof(word));
+        sum += word;
     }
+    return sum;
+}
+
+std::uint64_t SumScalar(const std::uint8_t* const data, const std::size_t size)
+{
+    std::uint64_t sum0 = 0;
+    std::uint64_t sum1 = 0;
+    std::size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        std::uint64_t words0;
+        std::uint64_t words1;
+        std::memcpy(&words0, data + i, sizeof(words0));
+        std::memcpy(&words1, data + i + 8, sizeof(words1));
+        sum0 += (words0 & 0xFFFFFFFF) + (words0 >> 32);
+        sum1 += (words1 & 0xFFFFFFFF) + (words1 >> 32);
+    }
+    return sum0 + sum1 + SumTail(data + i, size - i);
+}
+
+#ifdef POSNET_X86_CHECKSUM_KERNELS
+
+__attribute__((target("sse2")))
+std::uint64_t SumSse2(const std::uint8_t* const data, const std::size_t size)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i sum0 = _mm_setzero_si128();
+    __m128i sum1 = _mm_setzero_si128();
+    std::size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        const __m128i words0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        const __m128i words1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 16));
+        sum0 = _mm_add_epi64(sum0, _mm_unpacklo_epi32(words0, zero));
+        sum1 = _mm_add_epi64(sum1, _mm_unpackhi_epi32(words0, zero));
+        sum0 = _mm_add_epi64(sum0, _mm_unpacklo_epi32(words1, zero));
+        sum1 = _mm_add_epi64(sum1, _mm_unpackhi_epi32(words1, zero));
+    }
+
+    std::uint64_t lanes[2];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), _mm_add_epi64(sum0, sum1));
+    return lanes[0] + lanes[1] + SumScalar(data + i, size - i);
+}
+
+__attribute__((target("avx2")))
+std::uint64_t SumAvx2(const std::uint8_t* const data, const std::size_t size)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i sum0 = _mm256_setzero_si256();
+    __m256i sum1 = _mm256_setzero_si256();
+    std::size_t i = 0;
+    for (; i + 64 <= size; i += 64) {
+        const __m256i words0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        const __m256i words1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + 32));
+        sum0 = _mm256_add_epi64(sum0, _mm256_unpacklo_epi32(words0, zero));
+        sum1 = _mm256_add_epi64(sum1, _mm256_unpackhi_epi32(words0, zero));
+        sum0 = _mm256_add_epi64(sum0, _mm256_unpacklo_epi32(words1, zero));
+        sum1 = _mm256_add_epi64(sum1, _mm256_unpackhi_epi32(words1, zero));
+    }
+
+    std::uint64_t lanes[4];
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), _mm256_add_epi64(sum0, sum1));
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + SumScalar(data + i, size - i);
+}
+
+#endif //! POSNET_X86_CHECKSUM_KERNELS
+
+bool IsSupported(const posnet::utils::ChecksumKernel kernel)
+{
+    using ChecksumKernel = posnet::utils::ChecksumKernel;
+    switch (kernel) {
+        case ChecksumKernel::Scalar: return true;
+#ifdef POSNET_X86_CHECKSUM_KERNELS
+        case ChecksumKernel::Sse2: {
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("sse2");
+        }
+        case ChecksumKernel::Avx2: {
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2");
+        }
+#endif //! POSNET_X86_CHECKSUM_KERNELS
+        default:
+            return false;
+    }
+}
+
+SumFunctionType GetSumFunction(const posnet::utils::ChecksumKernel kernel)
+{
+    using ChecksumKernel = posnet::utils::ChecksumKernel;
+    switch (kernel) {
+#ifdef POSNET_X86_CHECKSUM_KERNELS
+        case ChecksumKernel::Sse2: return SumSse2;
+        case ChecksumKernel::Avx2: return SumAvx2;
+#endif //! POSNET_X86_CHECKSUM_KERNELS
+        default:
+            return SumScalar;
+    }
+}
+
+posnet::utils::ChecksumKernel SelectKernel()
+{
+    using ChecksumKernel = posnet::utils::ChecksumKernel;
+    for (const auto kernel : { ChecksumKernel::Avx2, ChecksumKernel::Sse2 }) {
+        if (IsSupported(kernel)) {
+            return kernel;
+        }
+    }
+    return ChecksumKernel::Scalar;
+}
+
+std::uint64_t ResolveAndSum(const std::uint8_t* data, std::size_t size);
+
+// The kernel is resolved by the first call, so the checksum can be used safely from the static initializers too
+std::atomic<SumFunctionType> gSumFunction(ResolveAndSum);
+
+std::uint64_t ResolveAndSum(const std::uint8_t* const data, const std::size_t size)
+{
+    const auto sumFunction = GetSumFunction(SelectKernel());
+    gSumFunction.store(sumFunction, std::memory_order_relaxed);
+    return sumFunction(data, size);
+}
+
+std::uint16_t FoldTo16(std::uint64_t sum)
+{
+    sum = (sum & 0xFFFFFFFF) + (sum >> 32);
+    sum = (sum & 0xFFFFFFFF) + (sum >> 32);
+    auto sum32 = static_cast<std::uint32_t>(sum);
+    sum32 = (sum32 & 0xFFFF) + (sum32 >> 16);
+    sum32 = (sum32 & 0xFFFF) + (sum32 >> 16);
+    return static_cast<std::uint16_t>(sum32);
+}
 
-    // Складываем старшие биты (если есть перенос) с младшими
-    while (sum >> 16) {
-        sum = (sum & 0xFFFF) + (sum >> 16);
+std::uint16_t FoldToChecksum(const std::uint64_t sum)
+{
+    auto checksum = FoldTo16(sum);
+    if constexpr (std::endian::native == std::endian::little) {
+        checksum = __builtin_bswap16(checksum);
     }
+    return static_cast<std::uint16_t>(~checksum);
+}
+
+} //! namespace
 
-    // Дополнение до единицы
-    sum = ~sum;
+namespace posnet::utils {
 
-    // Возвращаем 16-битный результат
-    return static_cast<uint16_t>(sum & 0xFFFF);
+std::uint16_t CalcChecksum(const std::span<const std::uint8_t> packet)
+{
+    if (packet.size() < INLINE_SUM_MAX_SIZE) {
+        return FoldToChecksum(SumTail(packet.data(), packet.size()));
+    }
+
+    const auto sumFunction = gSumFunction.load(std::memory_order_relaxed);
+    return FoldToChecksum(sumFunction(packet.data(), packet.size()));
 }
 
-std::uint16_t CalcChecksum(std::span<std::uint8_t> packet) 
+std::uint16_t CalcChecksum(const std::span<std::uint8_t> packet)
 {
-    uint32_t sum = 0;  // Используем uint32_t для хранения суммы, чтобы избежать переполнения
+    return CalcChecksum(std::span<const std::uint8_t>(packet));
+}
 
-    // Суммируем все 16-битные слова
-    for (auto i = 0; i + 1 < packet.size(); i += 2) {
-        sum += (packet[i] << 8) | packet[i + 1];
+std::uint16_t CalcChecksum(const std::span<const std::uint8_t> packet, const ChecksumKernel kernel)
+{
+    if (!IsSupported(kernel)) {
+        throw std::runtime_error("Checksum kernel=" + std::string(ChecksumKernelToStr(kernel)) + " is not supported by the CPU");
     }
+    return FoldToChecksum(GetSumFunction(kernel)(packet.data(), packet.size()));
+}
+
+ChecksumKernel GetChecksumKernel()
+{
+    return SelectKernel();
+}
+
+bool IsChecksumKernelSupported(const ChecksumKernel kernel)
+{
+    return IsSupported(kernel);
+}
 
-    // Если есть нечетный байт, добавляем его в сумму
-    if (packet.size() % 2 == 1) {
-        sum += packet[packet.size() - 1] << 8;
+std::string_view ChecksumKernelToStr(const ChecksumKernel kernel)
+{
+    switch (kernel) {
+        case ChecksumKernel::Scalar: return "Scalar";
+        case ChecksumKernel::Sse2: return "SSE2";
+        case ChecksumKernel::Avx2: return "AVX2";
+        default:
+            return "Undefined";
     }
+}
 
-    // Складываем старшие биты (если есть перенос) с младшими
-    while (sum >> 16) {
-        sum = (sum & 0xFFFF) + (sum >> 16);
+std::uint16_t UpdateChecksum16(const std::uint16_t checksum, const std::uint16_t oldValue, const std::uint16_t newValue)
+{
+    // HC' = ~(~HC + ~m + m')
+    std::uint32_t sum = static_cast<std::uint16_t>(~checksum);
+    sum += static_cast<std::uint16_t>(~oldValue);
+    sum += newValue;
+    sum = (sum & 0xFFFF) + (sum >> 16);
+    sum = (sum & 0xFFFF) + (sum >> 16);
+    return static_cast<std::uint16_t>(~sum);
+}
+
+std::uint16_t UpdateChecksum32(const std::uint16_t checksum, const std::uint32_t oldValue, const std::uint32_t newValue)
+{
+    const auto checksum16 = UpdateChecksum16(checksum, oldValue >> 16, newValue >> 16);
+    return UpdateChecksum16(checksum16, oldValue & 0xFFFF, newValue & 0xFFFF);
+}
+
+ChecksumAccumulator& ChecksumAccumulator::add(const std::span<const std::uint8_t> data) noexcept
+{
+    const auto sumFunction = gSumFunction.load(std::memory_order_relaxed);
+    auto sum = FoldTo16(sumFunction(data.data(), data.size()));
+    // The bytes of the segment at the odd offset are the low bytes of the words of the whole data
+    if (m_sizeInBytes % 2 != 0) {
+        sum = __builtin_bswap16(sum);
     }
 
-    // Дополнение до единицы
-    sum = ~sum;
+    m_sum = FoldTo16(static_cast<std::uint64_t>(m_sum) + sum);
+    m_sizeInBytes += data.size();
+    return *this;
+}
+
+ChecksumAccumulator& ChecksumAccumulator::addWord16(const std::uint16_t word) noexcept
+{
+    std::uint8_t bytes[2] = { static_cast<std::uint8_t>(word >> 8), static_cast<std::uint8_t>(word) };
+    return add(std::span<const std::uint8_t>(bytes));
+}
+
+ChecksumAccumulator& ChecksumAccumulator::addWord32(const std::uint32_t word) noexcept
+{
+    std::uint8_t bytes[4] = {
+        static_cast<std::uint8_t>(word >> 24), static_cast<std::uint8_t>(word >> 16),
+        static_cast<std::uint8_t>(word >> 8), static_cast<std::uint8_t>(word)
+    };
+    return add(std::span<const std::uint8_t>(bytes));
+}
+
+std::uint16_t ChecksumAccumulator::getChecksum() const noexcept
+{
+    return FoldToChecksum(m_sum);
+}
+
+std::uint64_t ChecksumAccumulator::getSizeInBytes() const noexcept
+{
+    return m_sizeInBytes;
+}
 
-    // Возвращаем 16-битный результат
-    return static_cast<uint16_t>(sum & 0xFFFF);
+void ChecksumAccumulator::reset() noexcept
+{
+    m_sum = 0;
+    m_sizeInBytes = 0;
 }
 
 void HostBufferViewToNetwork(std::span<std::int8_t> buffer)
@@ -64,4 +309,4 @@ void HostBufferViewToNetwork(std::span<std::uint8_t> buffer)
     //! TODO:
 }
 
-} //! namespace posnet::utils
\ No newline at end of file
+} //! namespace posnet::utils
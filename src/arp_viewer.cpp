@@ -5,42 +5,8 @@
 #include <array>
 #include <cstdio>
 
-#include <arpa/inet.h>
-
 namespace {
 
-posnet::ArpViewer::HardwareType ExtractHardwareType(const uint16_t hardware)
-{
-    using HardwareType = posnet::ArpViewer::HardwareType;
-    switch (hardware) {
-        case 1: return HardwareType::ARP;
-        case 0: return HardwareType::RARP;
-        default:
-            return HardwareType::Undefined;
-    }
-}
-
-posnet::ArpViewer::ProtocolType ExtractProtocolType(const uint16_t protocol)
-{
-    using ProtocolType = posnet::ArpViewer::ProtocolType;
-    return (protocol == 0x0800 ? ProtocolType::V4 : ProtocolType::V6);
-}
-
-posnet::ArpViewer::OpcodeType ExtractOpcodeType(const uint16_t opcode)
-{
-    using OpcodeType = posnet::ArpViewer::OpcodeType;
-    switch (opcode) {
-        case 1: return OpcodeType::ArpRequest;
-        case 2: return OpcodeType::ArpReply;
-        case 3: return OpcodeType::RArpRequest;
-        case 4: return OpcodeType::RArpReply;
-        case 8: return OpcodeType::InArpRequest;
-        case 9: return OpcodeType::InArpReply;
-        default:
-            return OpcodeType::Undefined;
-    }
-}
-
 std::string_view HardwareTypeToStr(const posnet::ArpViewer::HardwareType hardware)
 {
     using HardwareType = posnet::ArpViewer::HardwareType;
@@ -77,98 +43,16 @@ std::string_view OpcodeTypeToStr(const posnet::ArpViewer::OpcodeType opcode)
 
 namespace posnet {
 
-ArpViewer::ArpViewer(EthernetViewer ethernetViewer):
-BaseFrame(reinterpret_cast<const BaseFrame::ByteType*>(ethernetViewer.getStart()), ethernetViewer.getSize()),
-m_frame(reinterpret_cast<HeaderStructType*>(
-    ethernetViewer.getFrameHeaderStart() + EthernetViewer::DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES))
-{}
-
-ArpViewer::ArpViewer(const RawFrameViewType rawFrame):
-BaseFrame(reinterpret_cast<const BaseFrame::ByteType*>(rawFrame.data()), DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES),
-m_frame(reinterpret_cast<HeaderStructType*>(rawFrame.data()))
-{}
-
-ArpViewer::ArpViewer(const ConstRawFrameViewType rawFrame):
-BaseFrame(reinterpret_cast<const BaseFrame::ByteType*>(rawFrame.data()), DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES),
-m_frame(reinterpret_cast<HeaderStructType*>(
-    const_cast<RawFrameViewType::value_type*>(rawFrame.data())))
-{}
-
-ArpViewer::HardwareType ArpViewer::getHardwareType()
-{
-    return ExtractHardwareType(ntohs(m_frame->hardwareType));
-}
-
-std::string_view ArpViewer::getHardwareTypeAsStr()
-{
-    return HardwareTypeToStr(getHardwareType());
-}
-
-ArpViewer::ProtocolType ArpViewer::getProtocolType()
-{
-    return ExtractProtocolType(ntohs(m_frame->protoType));
-}
-
-std::string_view ArpViewer::getProtocolTypeAsStr()
-{
-    return ProtocolTypeToStr(getProtocolType());
-}
-
-ArpViewer::OpcodeType ArpViewer::getOpcode()
-{
-    return ExtractOpcodeType(ntohs(m_frame->opcode));
-}
-
-std::string_view ArpViewer::getOpcodeAsStr()
-{
-    return OpcodeTypeToStr(getOpcode());
-}
-
-std::string ArpViewer::getSenderMacAddressAsStr()
-{
-    return posnet::utils::MacAddrToStr(m_frame->senderMac);
-}
-
-std::string ArpViewer::getTargetMacAddressAsStr()
-{
-    return posnet::utils::MacAddrToStr(m_frame->targetMac);
-}
-
-std::string ArpViewer::getSenderIpAddressAsStr()
-{
-    return posnet::utils::IpAddrToStr(m_frame->senderIp);
-}
-
-std::string ArpViewer::getTargetIpAddressAsStr()
-{
-    return posnet::utils::IpAddrToStr(m_frame->targetIp);
-}
-
-ArpViewer::HardwareType ArpViewer::getHardwareType() const
-{
-    return ExtractHardwareType(ntohs(m_frame->hardwareType));
-}
-
 std::string_view ArpViewer::getHardwareTypeAsStr() const
 {
     return HardwareTypeToStr(getHardwareType());
 }
 
-ArpViewer::ProtocolType ArpViewer::getProtocolType() const
-{
-    return ExtractProtocolType(ntohs(m_frame->protoType));
-}
-
 std::string_view ArpViewer::getProtocolTypeAsStr() const
 {
     return ProtocolTypeToStr(getProtocolType());
 }
 
-ArpViewer::OpcodeType ArpViewer::getOpcode() const
-{
-    return ExtractOpcodeType(ntohs(m_frame->opcode));
-}
-
 std::string_view ArpViewer::getOpcodeAsStr() const
 {
     return OpcodeTypeToStr(getOpcode());
@@ -176,27 +60,22 @@ std::string_view ArpViewer::getOpcodeAsStr() const
 
 std::string ArpViewer::getSenderMacAddressAsStr() const
 {
-    return posnet::utils::MacAddrToStr(m_frame->senderMac);
+    return posnet::utils::MacAddrToStr(getHeader()->senderMac);
 }
 
 std::string ArpViewer::getTargetMacAddressAsStr() const
 {
-    return posnet::utils::MacAddrToStr(m_frame->targetMac);
+    return posnet::utils::MacAddrToStr(getHeader()->targetMac);
 }
 
 std::string ArpViewer::getSenderIpAddressAsStr() const
 {
-    return posnet::utils::IpAddrToStr(m_frame->senderIp);
+    return posnet::utils::IpAddrToStr(getHeader()->senderIp);
 }
 
 std::string ArpViewer::getTargetIpAddressAsStr() const
 {
-    return posnet::utils::IpAddrToStr(m_frame->targetIp);
-}
-
-std::uint8_t* ArpViewer::getFrameHeaderStart()
-{
-    return reinterpret_cast<std::uint8_t*>(m_frame);
+    return posnet::utils::IpAddrToStr(getHeader()->targetIp);
 }
 
 std::ostream& ArpViewer::operator<<(std::ostream& os) const
@@ -20,12 +20,7 @@ BaseFrame::ConstRawFrameViewType BaseFrame::getAsRawFrameView()
     return ConstRawFrameViewType{ getStart(), getSize() };
 }
 
-std::optional<BaseFrame::FrameInfo> BaseFrame::getFrameInfo() const
-{
-    return m_info;
-}
-
-std::optional<BaseFrame::FrameInfo> BaseFrame::getFrameInfo()
+const std::optional<BaseFrame::FrameInfo>& BaseFrame::getFrameInfo() const
 {
     return m_info;
 }
@@ -0,0 +1,321 @@
+#include "net-io/batch_receiver.h"
+#include "packet-buffer/frame_pool.h"
+
+#include "utils/system_error.h"
+
+#include <stdexcept>
+#include <algorithm>
+#include <string>
+#include <cstring>
+#include <cerrno>
+#include <cassert>
+
+#include <linux/if_packet.h>
+#include <time.h>
+
+using namespace posnet::utils;
+
+namespace {
+
+posnet::BatchReceiver::SizeType AlignUp(const posnet::BatchReceiver::SizeType value, const posnet::BatchReceiver::SizeType alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+} //! namespace
+
+namespace posnet {
+
+BatchReceiver::Batch::Iterator::Iterator(const Batch* const batch, const SizeType index):
+m_batch(batch),
+m_index(index)
+{}
+
+BatchReceiver::ConstRawFrameViewType BatchReceiver::Batch::Iterator::operator*() const
+{
+    return m_batch->getFrame(m_index);
+}
+
+BatchReceiver::Batch::Iterator& BatchReceiver::Batch::Iterator::operator++()
+{
+    ++m_index;
+    return *this;
+}
+
+BatchReceiver::Batch::Iterator BatchReceiver::Batch::Iterator::operator++(int)
+{
+    auto prev = *this;
+    ++m_index;
+    return prev;
+}
+
+BatchReceiver::Batch::Batch(const BatchReceiver* const receiver):
+m_receiver(receiver),
+m_size(0),
+m_statistics()
+{}
+
+BatchReceiver::SizeType BatchReceiver::Batch::size() const
+{
+    return m_size;
+}
+
+bool BatchReceiver::Batch::empty() const
+{
+    return m_size == 0;
+}
+
+BatchReceiver::ConstRawFrameViewType BatchReceiver::Batch::operator[](const SizeType index) const
+{
+    return getFrame(index);
+}
+
+BatchReceiver::ConstRawFrameViewType BatchReceiver::Batch::getFrame(const SizeType index) const
+{
+    assert(index < m_size);
+    const auto& message = m_receiver->m_messages[index];
+    return ConstRawFrameViewType{
+        static_cast<const ByteType*>(message.msg_hdr.msg_iov->iov_base),
+        std::min<std::size_t>(message.msg_len, m_receiver->m_frameSize)
+    };
+}
+
+bool BatchReceiver::Batch::isTruncated(const SizeType index) const
+{
+    assert(index < m_size);
+    return (m_receiver->m_messages[index].msg_hdr.msg_flags & MSG_TRUNC) != 0;
+}
+
+const struct sockaddr_storage& BatchReceiver::Batch::getSourceAddress(const SizeType index) const
+{
+    assert(index < m_size);
+    return m_receiver->m_addresses[index];
+}
+
+const BatchReceiver::FrameInfo& BatchReceiver::Batch::getFrameInfo(const SizeType index) const
+{
+    assert(index < m_size);
+    return m_receiver->m_frameInfos[index];
+}
+
+const BatchReceiver::BatchStatistics& BatchReceiver::Batch::getStatistics() const
+{
+    return m_statistics;
+}
+
+BatchReceiver::Batch::Iterator BatchReceiver::Batch::begin() const
+{
+    return Iterator(this, 0);
+}
+
+BatchReceiver::Batch::Iterator BatchReceiver::Batch::end() const
+{
+    return Iterator(this, m_size);
+}
+
+BatchReceiver::BatchReceiver(const int socket):
+BatchReceiver(socket, DEFAULT_BATCH_SIZE, DEFAULT_FRAME_SIZE_IN_BYTES)
+{}
+
+BatchReceiver::BatchReceiver(const int socket, const SizeType batchSize, const SizeType frameSizeInBytes):
+m_socket(socket),
+m_batchSize(batchSize),
+m_frameSize(frameSizeInBytes),
+m_frameStride(AlignUp(frameSizeInBytes, FRAME_ALIGNMENT_IN_BYTES)),
+m_buffer(),
+m_framePool(nullptr),
+m_ioVectors(batchSize),
+m_messages(batchSize),
+m_addresses(batchSize),
+m_controls(),
+m_frameInfos(batchSize),
+m_isFrameInfoEnabled(false),
+m_batch(this),
+m_statistics()
+{
+    if (m_batchSize == 0 || m_frameSize == 0) {
+        throw std::runtime_error("Could not create batch receiver with batch size=" + std::to_string(m_batchSize) +
+            " and frame size=" + std::to_string(m_frameSize));
+    }
+
+    // The extra space is used to align the first frame buffer by FRAME_ALIGNMENT_IN_BYTES
+    m_buffer.resize(static_cast<std::size_t>(m_frameStride) * m_batchSize + FRAME_ALIGNMENT_IN_BYTES);
+    const auto bufferAddress = reinterpret_cast<std::uintptr_t>(m_buffer.data());
+    auto frameBuffer = m_buffer.data() + (FRAME_ALIGNMENT_IN_BYTES - bufferAddress % FRAME_ALIGNMENT_IN_BYTES) % FRAME_ALIGNMENT_IN_BYTES;
+
+    for (auto& ioVector : m_ioVectors) {
+        ioVector.iov_base = frameBuffer;
+        frameBuffer += m_frameStride;
+    }
+    initMessages();
+}
+
+BatchReceiver::BatchReceiver(const int socket, const SizeType batchSize, FramePool& framePool):
+m_socket(socket),
+m_batchSize(batchSize),
+m_frameSize(framePool.getFrameSize()),
+m_frameStride(framePool.getFrameSize()),
+m_buffer(),
+m_framePool(&framePool),
+m_ioVectors(batchSize),
+m_messages(batchSize),
+m_addresses(batchSize),
+m_controls(),
+m_frameInfos(batchSize),
+m_isFrameInfoEnabled(false),
+m_batch(this),
+m_statistics()
+{
+    if (m_batchSize == 0) {
+        throw std::runtime_error("Could not create batch receiver with batch size=0");
+    }
+
+    for (SizeType i = 0; i < m_batchSize; ++i) {
+        m_ioVectors[i].iov_base = m_framePool->allocate();
+        if (m_ioVectors[i].iov_base == nullptr) {
+            for (SizeType j = 0; j < i; ++j) {
+                m_framePool->deallocate(static_cast<ByteType*>(m_ioVectors[j].iov_base));
+            }
+            throw std::runtime_error("Could not create batch receiver: frame pool is exhausted, batch size=" + std::to_string(m_batchSize));
+        }
+    }
+    initMessages();
+}
+
+BatchReceiver::~BatchReceiver()
+{
+    if (m_framePool != nullptr) {
+        for (const auto& ioVector : m_ioVectors) {
+            m_framePool->deallocate(static_cast<ByteType*>(ioVector.iov_base));
+        }
+    }
+}
+
+void BatchReceiver::initMessages()
+{
+    std::memset(m_messages.data(), 0, m_messages.size() * sizeof(struct mmsghdr));
+    for (SizeType i = 0; i < m_batchSize; ++i) {
+        m_ioVectors[i].iov_len = m_frameSize;
+        m_messages[i].msg_hdr.msg_iov = &m_ioVectors[i];
+        m_messages[i].msg_hdr.msg_iovlen = 1;
+        m_messages[i].msg_hdr.msg_name = &m_addresses[i];
+    }
+}
+
+const BatchReceiver::Batch& BatchReceiver::receive(const int flags)
+{
+    for (auto& message : m_messages) {
+        message.msg_hdr.msg_namelen = sizeof(struct sockaddr_storage);
+        message.msg_hdr.msg_flags = 0;
+        message.msg_len = 0;
+        if (m_isFrameInfoEnabled) {
+            message.msg_hdr.msg_controllen = CONTROL_BUFFER_SIZE_IN_BYTES;
+        }
+    }
+
+    const auto startTime = std::chrono::steady_clock::now();
+    const auto count = recvmmsg(m_socket, m_messages.data(), m_batchSize, flags, nullptr);
+    const auto receiveDuration = std::chrono::steady_clock::now() - startTime;
+
+    ++m_statistics.receiveCalls;
+    m_batch.m_size = 0;
+    m_batch.m_statistics = BatchStatistics{};
+    m_batch.m_statistics.receiveDuration = std::chrono::duration_cast<std::chrono::nanoseconds>(receiveDuration);
+    if (count < 0) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
+            ++m_statistics.emptyReceiveCalls;
+            return m_batch;
+        }
+        throw std::runtime_error("Could not receive batch of frames: " + GetLastSysError());
+    }
+
+    m_batch.m_size = static_cast<SizeType>(count);
+    for (SizeType i = 0; i < m_batch.m_size; ++i) {
+        m_batch.m_statistics.byteCount += m_batch.getFrame(i).size();
+        m_batch.m_statistics.truncatedFrameCount += m_batch.isTruncated(i) ? 1 : 0;
+        if (m_isFrameInfoEnabled) {
+            parseFrameInfo(i);
+        }
+    }
+    m_batch.m_statistics.frameCount = m_batch.m_size;
+
+    m_statistics.emptyReceiveCalls += m_batch.empty() ? 1 : 0;
+    m_statistics.fullBatches += m_batch.m_size == m_batchSize ? 1 : 0;
+    m_statistics.frameCount += m_batch.m_statistics.frameCount;
+    m_statistics.byteCount += m_batch.m_statistics.byteCount;
+    m_statistics.truncatedFrameCount += m_batch.m_statistics.truncatedFrameCount;
+    return m_batch;
+}
+
+void BatchReceiver::enableFrameInfo()
+{
+    if (m_isFrameInfoEnabled) {
+        return;
+    }
+
+    const int enable = 1;
+    if (setsockopt(m_socket, SOL_SOCKET, SO_TIMESTAMPNS, &enable, sizeof(enable)) < 0) {
+        throw std::runtime_error("Could not enable SO_TIMESTAMPNS: " + GetLastSysError());
+    }
+
+    int domain = 0;
+    socklen_t domainLength = sizeof(domain);
+    if (getsockopt(m_socket, SOL_SOCKET, SO_DOMAIN, &domain, &domainLength) < 0) {
+        throw std::runtime_error("Could not get domain of socket: " + GetLastSysError());
+    }
+
+    if (domain == AF_PACKET && setsockopt(m_socket, SOL_PACKET, PACKET_AUXDATA, &enable, sizeof(enable)) < 0) {
+        throw std::runtime_error("Could not enable PACKET_AUXDATA: " + GetLastSysError());
+    }
+
+    m_controls.resize(static_cast<std::size_t>(CONTROL_BUFFER_SIZE_IN_BYTES) * m_batchSize);
+    for (SizeType i = 0; i < m_batchSize; ++i) {
+        m_messages[i].msg_hdr.msg_control = m_controls.data() + static_cast<std::size_t>(CONTROL_BUFFER_SIZE_IN_BYTES) * i;
+        m_messages[i].msg_hdr.msg_controllen = CONTROL_BUFFER_SIZE_IN_BYTES;
+    }
+    m_isFrameInfoEnabled = true;
+}
+
+void BatchReceiver::parseFrameInfo(const SizeType index)
+{
+    auto& message = m_messages[index].msg_hdr;
+    auto& info = m_frameInfos[index];
+    info = FrameInfo{};
+    info.originalLength = m_messages[index].msg_len;
+
+    const auto& address = m_addresses[index];
+    if (address.ss_family == AF_PACKET) {
+        const auto& linkAddress = reinterpret_cast<const struct sockaddr_ll&>(address);
+        info.ifIndex = linkAddress.sll_ifindex;
+        info.direction = static_cast<FrameInfo::DirectionType>(linkAddress.sll_pkttype);
+    }
+
+    for (auto control = CMSG_FIRSTHDR(&message); control != nullptr; control = CMSG_NXTHDR(&message, control)) {
+        if (control->cmsg_level == SOL_SOCKET && control->cmsg_type == SCM_TIMESTAMPNS) {
+            struct timespec timestamp;
+            std::memcpy(&timestamp, CMSG_DATA(control), sizeof(timestamp));
+            info.timestamp = std::chrono::seconds(timestamp.tv_sec) + std::chrono::nanoseconds(timestamp.tv_nsec);
+        } else if (control->cmsg_level == SOL_PACKET && control->cmsg_type == PACKET_AUXDATA) {
+            struct tpacket_auxdata auxData;
+            std::memcpy(&auxData, CMSG_DATA(control), sizeof(auxData));
+            info.originalLength = auxData.tp_len;
+        }
+    }
+}
+
+BatchReceiver::SizeType BatchReceiver::getBatchSize() const
+{
+    return m_batchSize;
+}
+
+BatchReceiver::SizeType BatchReceiver::getFrameSize() const
+{
+    return m_frameSize;
+}
+
+const BatchReceiver::Statistics& BatchReceiver::getStatistics() const
+{
+    return m_statistics;
+}
+
+} //! namespace posnet
@@ -0,0 +1,163 @@
+#include "net-io/capture_group.h"
+
+#include "utils/system_error.h"
+
+#include <stdexcept>
+#include <string>
+#include <cassert>
+
+#include <unistd.h>
+#include <pthread.h>
+#include <sched.h>
+
+using namespace posnet::utils;
+
+namespace {
+
+void PinCurrentThread(const unsigned int cpu)
+{
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    CPU_SET(cpu, &cpuSet);
+    const auto error = pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+    if (error != 0) {
+        throw std::runtime_error("Could not pin capture worker to cpu=" + std::to_string(cpu));
+    }
+}
+
+unsigned int GetCpuCount()
+{
+    const auto cpuCount = std::thread::hardware_concurrency();
+    return cpuCount != 0 ? cpuCount : 1;
+}
+
+} //! namespace
+
+namespace posnet {
+
+CaptureGroup::CaptureGroup(const std::string_view ifaceName, const Configuration config):
+m_config(config),
+m_groupId(config.groupId ? *config.groupId : static_cast<std::uint16_t>(getpid() & 0xFFFF)),
+m_workers(),
+m_callback(),
+m_isRunning(false)
+{
+    const auto workerCount = m_config.workerCount ? *m_config.workerCount : GetCpuCount();
+    if (workerCount == 0) {
+        throw std::runtime_error("Could not create capture group without workers");
+    }
+
+    m_workers.reserve(workerCount);
+    for (SizeType i = 0; i < workerCount; ++i) {
+        auto worker = std::make_unique<Worker>();
+        worker->ring = std::make_unique<PacketRxRing>(ifaceName, m_config.ringConfig);
+        worker->ring->joinFanoutGroup(m_groupId, m_config.mode);
+        m_workers.push_back(std::move(worker));
+    }
+}
+
+CaptureGroup::~CaptureGroup()
+{
+    try {
+        stop();
+    } catch (...) {
+        // The destructor must not throw, the error of the worker is lost
+    }
+}
+
+void CaptureGroup::start(CallbackType callback)
+{
+    if (m_isRunning.exchange(true)) {
+        throw std::runtime_error("Could not start capture group which is already running");
+    }
+
+    m_callback = std::move(callback);
+    for (SizeType i = 0; i < m_workers.size(); ++i) {
+        m_workers[i]->error = nullptr;
+        m_workers[i]->thread = std::thread(&CaptureGroup::runWorker, this, i);
+    }
+}
+
+void CaptureGroup::stop()
+{
+    m_isRunning.store(false);
+
+    std::exception_ptr error = nullptr;
+    for (auto& worker : m_workers) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+
+        if (!error && worker->error) {
+            error = worker->error;
+        }
+        worker->error = nullptr;
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+bool CaptureGroup::isRunning() const
+{
+    return m_isRunning.load();
+}
+
+void CaptureGroup::attachFilter(const PacketFilter& filter)
+{
+    for (auto& worker : m_workers) {
+        filter.attachTo(worker->ring->getSocket());
+    }
+}
+
+CaptureGroup::SizeType CaptureGroup::getWorkerCount() const
+{
+    return m_workers.size();
+}
+
+std::uint16_t CaptureGroup::getGroupId() const
+{
+    return m_groupId;
+}
+
+PacketRxRing& CaptureGroup::getRing(const SizeType workerIndex)
+{
+    assert(workerIndex < m_workers.size());
+    return *m_workers[workerIndex]->ring;
+}
+
+std::vector<CaptureGroup::WorkerStatistics> CaptureGroup::getStatistics()
+{
+    std::vector<WorkerStatistics> statistics;
+    statistics.reserve(m_workers.size());
+    for (auto& worker : m_workers) {
+        WorkerStatistics workerStatistics;
+        workerStatistics.handledFrames = worker->handledFrames.load(std::memory_order_relaxed);
+        workerStatistics.ringStatistics = worker->ring->getStatistics();
+        statistics.push_back(workerStatistics);
+    }
+    return statistics;
+}
+
+void CaptureGroup::runWorker(const SizeType workerIndex)
+{
+    auto& worker = *m_workers[workerIndex];
+    try {
+        if (m_config.pinWorkers) {
+            // In Cpu fanout mode the socket with index N receives the frames from CPU N, so the worker follows its CPU
+            PinCurrentThread(workerIndex % GetCpuCount());
+        }
+
+        while (m_isRunning.load(std::memory_order_relaxed)) {
+            const auto handledFrames = worker.ring->dispatch([this, workerIndex](const ConstRawFrameViewType frame) {
+                m_callback(workerIndex, frame);
+            }, WORKER_POLL_TIMEOUT_IN_MS);
+            worker.handledFrames.fetch_add(handledFrames, std::memory_order_relaxed);
+        }
+    } catch (...) {
+        worker.error = std::current_exception();
+    }
+}
+
+} //! namespace posnet
@@ -1,4 +1,5 @@
 #include "frame-builder/ethernet_builder.h"
+#include "packet-buffer/packet_buffer.h"
 
 #include "utils/sock_addr_convertor.h"
 
@@ -65,6 +66,11 @@ EthernetBuilder& EthernetBuilder::setProtocol(const ProtocolType protocol) &
     return *this;
 }
 
+void EthernetBuilder::prependTo(PacketBuffer& buffer) const
+{
+    std::memcpy(buffer.prepend(DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES).data(), &m_frame, DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES);
+}
+
 std::ostream& EthernetBuilder::operator<<(std::ostream& os) const
 {
     return os << EthernetViewer(getAsRawFrameView());
@@ -0,0 +1,428 @@
+#include "flow-table/flow_table.h"
+
+#include "frame-viewers/ethernet_viewer.h"
+#include "frame-viewers/ip_viewer.h"
+#include "frame-viewers/udp_viewer.h"
+#include "frame-viewers/tcp_viewer.h"
+#include "utils/byte_order.h"
+#include "utils/ring_policy.h"
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <cassert>
+
+#include <netinet/ip.h>
+
+using namespace posnet::utils;
+
+namespace {
+
+// The table is kept at most 3/4 full, so the probe sequences stay short
+constexpr std::size_t MAX_LOAD_NUMERATOR = 3;
+constexpr std::size_t MAX_LOAD_DENOMINATOR = 4;
+
+void CheckConfiguration(const posnet::FlowTable::Configuration& config)
+{
+    if (config.maxFlowCount == 0 || config.maxFlowCount >= UINT32_MAX / MAX_LOAD_DENOMINATOR) {
+        throw std::runtime_error("Invalid flow table configuration: max flow count=" + std::to_string(config.maxFlowCount));
+    }
+}
+
+std::uint64_t MixHash(std::uint64_t value) noexcept
+{
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdULL;
+    value ^= value >> 33;
+    value *= 0xc4ceb9fe1a85ec53ULL;
+    value ^= value >> 33;
+    return value;
+}
+
+// The key and the flags of TCP segment of the frame, which starts with Ethernet header
+std::optional<posnet::FlowKey> ExtractFlowKey(const posnet::FlowKey::ConstRawFrameViewType frame, std::uint8_t& tcpFlags) noexcept
+{
+    const auto ethernetViewer = posnet::EthernetViewer::TryView(frame);
+    if (!ethernetViewer || ethernetViewer->getEtherType() != ETH_P_IP) {
+        return std::nullopt;
+    }
+
+    const auto ipPacket = ethernetViewer->getPayload(frame);
+    const auto ipViewer = posnet::IpViewer::TryView(ipPacket);
+    if (!ipViewer) {
+        return std::nullopt;
+    }
+
+    // Only the first fragment contains l4 header, the other fragments are accounted without the ports
+    const auto fragmentOffset = NetworkToHost16(static_cast<std::uint16_t>(ipViewer->getFragmentOffset())) & IP_OFFMASK;
+    if (fragmentOffset != 0) {
+        return posnet::FlowKey(*ipViewer);
+    }
+
+    const auto ipPayload = ipViewer->getPayload(ipPacket);
+    switch (ipViewer->getProtocol()) {
+        case posnet::IpViewer::ProtocolType::TCP: {
+            const auto tcpViewer = posnet::TcpViewer::TryView(ipPayload);
+            if (!tcpViewer) {
+                return std::nullopt;
+            }
+            tcpFlags = tcpViewer->getFlags();
+            return posnet::FlowKey(*ipViewer, *tcpViewer);
+        }
+        case posnet::IpViewer::ProtocolType::UDP: {
+            const auto udpViewer = posnet::UdpViewer::TryView(ipPayload);
+            if (!udpViewer) {
+                return std::nullopt;
+            }
+            return posnet::FlowKey(*ipViewer, *udpViewer);
+        }
+        default:
+            return posnet::FlowKey(*ipViewer);
+    }
+}
+
+} //! namespace
+
+namespace posnet {
+
+FlowKey::FlowKey(const IpViewer& ipViewer) noexcept:
+sourceIpAddress(ipViewer.getSourceIpAddress()),
+destIpAddress(ipViewer.getDestIpAddress()),
+sourcePort(0),
+destPort(0),
+// The raw protocol number, ProtocolType folds the protocols except ICMP, TCP and UDP into Undefined
+protocol(ipViewer.getFrameHeaderStart()[9])
+{}
+
+FlowKey::FlowKey(const IpViewer& ipViewer, const UdpViewer& udpViewer) noexcept:
+sourceIpAddress(ipViewer.getSourceIpAddress()),
+destIpAddress(ipViewer.getDestIpAddress()),
+sourcePort(static_cast<std::uint16_t>(udpViewer.getSourcePort())),
+destPort(static_cast<std::uint16_t>(udpViewer.getDestPort())),
+protocol(IPPROTO_UDP)
+{}
+
+FlowKey::FlowKey(const IpViewer& ipViewer, const TcpViewer& tcpViewer) noexcept:
+sourceIpAddress(ipViewer.getSourceIpAddress()),
+destIpAddress(ipViewer.getDestIpAddress()),
+sourcePort(static_cast<std::uint16_t>(tcpViewer.getSourcePort())),
+destPort(static_cast<std::uint16_t>(tcpViewer.getDestPort())),
+protocol(IPPROTO_TCP)
+{}
+
+FlowKey::FlowKey(const ParsedFrame& parsedFrame) noexcept:
+sourceIpAddress(parsedFrame.sourceIpAddress),
+destIpAddress(parsedFrame.destIpAddress),
+sourcePort(parsedFrame.sourcePort),
+destPort(parsedFrame.destPort),
+protocol(parsedFrame.ipProtocol)
+{
+    assert(parsedFrame.hasFlag(ParsedFrame::Flag::Ip));
+}
+
+std::optional<FlowKey> FlowKey::FromFrame(const ConstRawFrameViewType frame) noexcept
+{
+    std::uint8_t tcpFlags = 0;
+    return ExtractFlowKey(frame, tcpFlags);
+}
+
+std::uint64_t FlowKey::getHash() const noexcept
+{
+    const auto addresses = (static_cast<std::uint64_t>(sourceIpAddress) << 32) | destIpAddress;
+    const auto ports = (static_cast<std::uint64_t>(sourcePort) << 24) | (static_cast<std::uint64_t>(destPort) << 8) | protocol;
+    return MixHash(addresses * 0x9e3779b97f4a7c15ULL ^ ports);
+}
+
+FlowKey FlowKey::getReversed() const noexcept
+{
+    FlowKey key;
+    key.sourceIpAddress = destIpAddress;
+    key.destIpAddress = sourceIpAddress;
+    key.sourcePort = destPort;
+    key.destPort = sourcePort;
+    key.protocol = protocol;
+    return key;
+}
+
+FlowTable::FlowTable(Configuration config, EvictionHandlerType evictionHandler):
+m_config(config),
+m_evictionHandler(std::move(evictionHandler)),
+m_mask(0),
+m_tags(),
+m_slots(),
+m_lruHead(NULL_INDEX),
+m_lruTail(NULL_INDEX),
+m_flowCount(0),
+m_createdFlows(0),
+m_idleEvictions(0),
+m_capacityEvictions(0),
+m_skippedFrames(0)
+{
+    CheckConfiguration(m_config);
+
+    const auto capacity = RoundUpToPowerOfTwo(m_config.maxFlowCount * MAX_LOAD_DENOMINATOR / MAX_LOAD_NUMERATOR + 1);
+    m_mask = static_cast<std::uint32_t>(capacity - 1);
+    m_tags.assign(capacity, EMPTY_TAG);
+    m_slots.resize(capacity);
+}
+
+const FlowRecord& FlowTable::update(const FlowKey& key, const SizeType byteCount,
+    const TimestampType timestamp, const std::uint8_t tcpFlags)
+{
+    const auto hash = key.getHash();
+    auto index = findIndex(key, hash);
+    if (index == NULL_INDEX) {
+        index = insert(key, hash, timestamp);
+    } else if (index != m_lruHead) {
+        unlink(index);
+        linkFront(index);
+    }
+
+    auto& record = m_slots[index].record;
+    ++record.packetCount;
+    record.byteCount += byteCount;
+    record.lastSeen = timestamp;
+    record.tcpFlags |= tcpFlags;
+    return record;
+}
+
+bool FlowTable::update(const ConstRawFrameViewType frame, const TimestampType timestamp, const SizeType originalLength)
+{
+    std::uint8_t tcpFlags = 0;
+    const auto key = ExtractFlowKey(frame, tcpFlags);
+    if (!key) {
+        m_skippedFrames.store(m_skippedFrames.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return false;
+    }
+
+    update(*key, originalLength != 0 ? originalLength : frame.size(), timestamp, tcpFlags);
+    return true;
+}
+
+bool FlowTable::update(const ParsedFrame& parsedFrame, const TimestampType timestamp)
+{
+    if (!parsedFrame.hasFlag(ParsedFrame::Flag::Ip)) {
+        m_skippedFrames.store(m_skippedFrames.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return false;
+    }
+
+    update(FlowKey(parsedFrame), parsedFrame.frameSize, timestamp, parsedFrame.tcpFlags);
+    return true;
+}
+
+const FlowRecord* FlowTable::find(const FlowKey& key) const noexcept
+{
+    const auto index = findIndex(key, key.getHash());
+    return index != NULL_INDEX ? &m_slots[index].record : nullptr;
+}
+
+FlowTable::SizeType FlowTable::evictIdle(const TimestampType now)
+{
+    SizeType count = 0;
+    while (m_lruTail != NULL_INDEX && m_slots[m_lruTail].record.lastSeen + m_config.idleTimeout <= now) {
+        evict(m_lruTail, EvictionReason::Idle);
+        ++count;
+    }
+    return count;
+}
+
+void FlowTable::clear()
+{
+    while (m_lruTail != NULL_INDEX) {
+        evict(m_lruTail, EvictionReason::Clear);
+    }
+}
+
+FlowTable::SizeType FlowTable::getFlowCount() const noexcept
+{
+    return m_flowCount.load(std::memory_order_relaxed);
+}
+
+FlowTable::SizeType FlowTable::getMaxFlowCount() const noexcept
+{
+    return m_config.maxFlowCount;
+}
+
+const FlowTable::Configuration& FlowTable::getConfiguration() const noexcept
+{
+    return m_config;
+}
+
+FlowTable::Statistics FlowTable::getStatistics() const noexcept
+{
+    Statistics statistics;
+    statistics.flowCount = m_flowCount.load(std::memory_order_relaxed);
+    statistics.createdFlows = m_createdFlows.load(std::memory_order_relaxed);
+    statistics.idleEvictions = m_idleEvictions.load(std::memory_order_relaxed);
+    statistics.capacityEvictions = m_capacityEvictions.load(std::memory_order_relaxed);
+    statistics.skippedFrames = m_skippedFrames.load(std::memory_order_relaxed);
+    return statistics;
+}
+
+std::uint8_t FlowTable::GetTag(const std::uint64_t hash) noexcept
+{
+    // The high bits of the hash are not used by the index, the high bit of the tag marks the occupied slot
+    return static_cast<std::uint8_t>(0x80 | (hash >> 57));
+}
+
+std::uint32_t FlowTable::findIndex(const FlowKey& key, const std::uint64_t hash) const noexcept
+{
+    const auto tag = GetTag(hash);
+    for (auto index = static_cast<std::uint32_t>(hash) & m_mask; ; index = (index + 1) & m_mask) {
+        const auto slotTag = m_tags[index];
+        if (slotTag == EMPTY_TAG) {
+            return NULL_INDEX;
+        }
+
+        if (slotTag == tag && m_slots[index].record.key == key) {
+            return index;
+        }
+    }
+}
+
+std::uint32_t FlowTable::insert(const FlowKey& key, const std::uint64_t hash, const TimestampType timestamp)
+{
+    if (m_flowCount.load(std::memory_order_relaxed) == m_config.maxFlowCount) {
+        evict(m_lruTail, EvictionReason::Capacity);
+    }
+
+    auto index = static_cast<std::uint32_t>(hash) & m_mask;
+    while (m_tags[index] != EMPTY_TAG) {
+        index = (index + 1) & m_mask;
+    }
+
+    m_tags[index] = GetTag(hash);
+    m_slots[index].record = FlowRecord{ .key = key, .firstSeen = timestamp, .lastSeen = timestamp };
+    linkFront(index);
+    m_flowCount.store(m_flowCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    m_createdFlows.store(m_createdFlows.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    return index;
+}
+
+void FlowTable::evict(const std::uint32_t index, const EvictionReason reason)
+{
+    // The flow stays in the table if the handler throws
+    if (m_evictionHandler) {
+        m_evictionHandler(m_slots[index].record, reason);
+    }
+
+    if (reason == EvictionReason::Idle) {
+        m_idleEvictions.store(m_idleEvictions.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    } else if (reason == EvictionReason::Capacity) {
+        m_capacityEvictions.store(m_capacityEvictions.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+    erase(index);
+}
+
+void FlowTable::erase(const std::uint32_t index) noexcept
+{
+    unlink(index);
+    m_tags[index] = EMPTY_TAG;
+    m_flowCount.store(m_flowCount.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+
+    // The next flows of the probe sequence are shifted back into the hole, if the hole is between their home slot and them
+    auto hole = index;
+    for (auto next = (index + 1) & m_mask; m_tags[next] != EMPTY_TAG; next = (next + 1) & m_mask) {
+        const auto home = static_cast<std::uint32_t>(m_slots[next].record.key.getHash()) & m_mask;
+        if (((next - home) & m_mask) >= ((next - hole) & m_mask)) {
+            moveSlot(next, hole);
+            hole = next;
+        }
+    }
+}
+
+void FlowTable::linkFront(const std::uint32_t index) noexcept
+{
+    auto& slot = m_slots[index];
+    slot.prev = NULL_INDEX;
+    slot.next = m_lruHead;
+    if (m_lruHead != NULL_INDEX) {
+        m_slots[m_lruHead].prev = index;
+    } else {
+        m_lruTail = index;
+    }
+    m_lruHead = index;
+}
+
+void FlowTable::unlink(const std::uint32_t index) noexcept
+{
+    const auto& slot = m_slots[index];
+    if (slot.prev != NULL_INDEX) {
+        m_slots[slot.prev].next = slot.next;
+    } else {
+        m_lruHead = slot.next;
+    }
+
+    if (slot.next != NULL_INDEX) {
+        m_slots[slot.next].prev = slot.prev;
+    } else {
+        m_lruTail = slot.prev;
+    }
+}
+
+void FlowTable::moveSlot(const std::uint32_t from, const std::uint32_t to) noexcept
+{
+    m_slots[to] = m_slots[from];
+    m_tags[to] = m_tags[from];
+    m_tags[from] = EMPTY_TAG;
+
+    const auto& slot = m_slots[to];
+    if (slot.prev != NULL_INDEX) {
+        m_slots[slot.prev].next = to;
+    } else {
+        m_lruHead = to;
+    }
+
+    if (slot.next != NULL_INDEX) {
+        m_slots[slot.next].prev = to;
+    } else {
+        m_lruTail = to;
+    }
+}
+
+ShardedFlowTable::ShardedFlowTable(const SizeType shardCount, const FlowTable::Configuration configPerShard,
+    const FlowTable::EvictionHandlerType evictionHandler):
+m_shards()
+{
+    if (shardCount == 0) {
+        throw std::runtime_error("Invalid sharded flow table configuration: shard count must be greater than zero");
+    }
+
+    m_shards.reserve(shardCount);
+    for (SizeType i = 0; i < shardCount; ++i) {
+        m_shards.push_back(std::make_unique<FlowTable>(configPerShard, evictionHandler));
+    }
+}
+
+FlowTable& ShardedFlowTable::getShard(const SizeType index) noexcept
+{
+    assert(index < m_shards.size());
+    return *m_shards[index];
+}
+
+const FlowTable& ShardedFlowTable::getShard(const SizeType index) const noexcept
+{
+    assert(index < m_shards.size());
+    return *m_shards[index];
+}
+
+ShardedFlowTable::SizeType ShardedFlowTable::getShardCount() const noexcept
+{
+    return m_shards.size();
+}
+
+FlowTable::Statistics ShardedFlowTable::getStatistics() const noexcept
+{
+    FlowTable::Statistics total;
+    for (const auto& shard : m_shards) {
+        const auto statistics = shard->getStatistics();
+        total.flowCount += statistics.flowCount;
+        total.createdFlows += statistics.createdFlows;
+        total.idleEvictions += statistics.idleEvictions;
+        total.capacityEvictions += statistics.capacityEvictions;
+        total.skippedFrames += statistics.skippedFrames;
+    }
+    return total;
+}
+
+} //! namespace posnet
@@ -0,0 +1,106 @@
+#include "frame-builder/frame_chain.h"
+
+#include "utils/system_error.h"
+
+#include <stdexcept>
+#include <algorithm>
+#include <string>
+#include <cstring>
+#include <cerrno>
+
+using namespace posnet::utils;
+
+namespace posnet {
+
+FrameChain& FrameChain::append(const BaseFrame& frame) &
+{
+    return append(frame.getAsRawFrameView());
+}
+
+FrameChain& FrameChain::append(const ConstRawFrameViewType data) &
+{
+    if (m_segmentCount == MAX_SEGMENT_COUNT) {
+        throw std::runtime_error("Could not append segment to frame chain: the chain already has max count of segments=" +
+            std::to_string(MAX_SEGMENT_COUNT));
+    }
+
+    // iovec is shared by sendmsg and recvmsg, so its base is not const, the segment is only read by sendmsg
+    m_ioVectors[m_segmentCount].iov_base = const_cast<ByteType*>(data.data());
+    m_ioVectors[m_segmentCount].iov_len = data.size();
+    ++m_segmentCount;
+    m_size += static_cast<SizeType>(data.size());
+    return *this;
+}
+
+FrameChain::SizeType FrameChain::sendTo(const int socket, const struct sockaddr* const address, const socklen_t addressLength,
+    const int flags) const
+{
+    struct msghdr message;
+    fillMessage(message, address, addressLength);
+
+    const auto sentBytes = sendmsg(socket, &message, flags);
+    if (sentBytes < 0) {
+        throw std::runtime_error("Could not send frame chain: " + GetLastSysError());
+    }
+    return static_cast<SizeType>(sentBytes);
+}
+
+FrameChain::SizeType FrameChain::SendBatch(const int socket, const std::span<const FrameChain> chains,
+    const struct sockaddr* const address, const socklen_t addressLength, const int flags)
+{
+    std::array<struct mmsghdr, SEND_BATCH_SIZE> messages;
+    SizeType sentCount = 0;
+    while (sentCount < chains.size()) {
+        const auto count = std::min<SizeType>(static_cast<SizeType>(chains.size()) - sentCount, SEND_BATCH_SIZE);
+        for (SizeType i = 0; i < count; ++i) {
+            chains[sentCount + i].fillMessage(messages[i].msg_hdr, address, addressLength);
+            messages[i].msg_len = 0;
+        }
+
+        const auto result = sendmmsg(socket, messages.data(), count, flags);
+        if (result < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                break;
+            }
+            throw std::runtime_error("Could not send batch of frame chains: " + GetLastSysError());
+        }
+
+        sentCount += static_cast<SizeType>(result);
+        if (static_cast<SizeType>(result) < count) {
+            break;
+        }
+    }
+    return sentCount;
+}
+
+std::span<const struct iovec> FrameChain::getIoVectors() const noexcept
+{
+    return std::span<const struct iovec>(m_ioVectors.data(), m_segmentCount);
+}
+
+FrameChain::SizeType FrameChain::getSegmentCount() const noexcept
+{
+    return m_segmentCount;
+}
+
+FrameChain::SizeType FrameChain::getSize() const noexcept
+{
+    return m_size;
+}
+
+void FrameChain::clear() noexcept
+{
+    m_segmentCount = 0;
+    m_size = 0;
+}
+
+void FrameChain::fillMessage(struct msghdr& message, const struct sockaddr* const address, const socklen_t addressLength) const noexcept
+{
+    std::memset(&message, 0, sizeof(message));
+    message.msg_name = const_cast<struct sockaddr*>(address);
+    message.msg_namelen = address != nullptr ? addressLength : 0;
+    message.msg_iov = const_cast<struct iovec*>(m_ioVectors.data());
+    message.msg_iovlen = m_segmentCount;
+}
+
+} //! namespace posnet
@@ -0,0 +1,117 @@
+#include "frame-dissector/frame_columns.h"
+
+namespace posnet {
+
+FrameColumns::FrameColumns():
+m_sourceIpAddresses(),
+m_destIpAddresses(),
+m_sourcePorts(),
+m_destPorts(),
+m_ipProtocols(),
+m_tcpFlags(),
+m_frameLengths(),
+m_payloadLengths(),
+m_flags()
+{}
+
+FrameColumns::FrameColumns(const SizeType capacity):
+FrameColumns()
+{
+    reserve(capacity);
+}
+
+void FrameColumns::append(const ParsedFrame& parsedFrame)
+{
+    m_sourceIpAddresses.push_back(parsedFrame.sourceIpAddress);
+    m_destIpAddresses.push_back(parsedFrame.destIpAddress);
+    m_sourcePorts.push_back(parsedFrame.sourcePort);
+    m_destPorts.push_back(parsedFrame.destPort);
+    m_ipProtocols.push_back(parsedFrame.ipProtocol);
+    m_tcpFlags.push_back(parsedFrame.tcpFlags);
+    m_frameLengths.push_back(parsedFrame.frameSize);
+    m_payloadLengths.push_back(parsedFrame.payloadLength);
+    m_flags.push_back(parsedFrame.flags);
+}
+
+void FrameColumns::reserve(const SizeType capacity)
+{
+    m_sourceIpAddresses.reserve(capacity);
+    m_destIpAddresses.reserve(capacity);
+    m_sourcePorts.reserve(capacity);
+    m_destPorts.reserve(capacity);
+    m_ipProtocols.reserve(capacity);
+    m_tcpFlags.reserve(capacity);
+    m_frameLengths.reserve(capacity);
+    m_payloadLengths.reserve(capacity);
+    m_flags.reserve(capacity);
+}
+
+void FrameColumns::clear()
+{
+    m_sourceIpAddresses.clear();
+    m_destIpAddresses.clear();
+    m_sourcePorts.clear();
+    m_destPorts.clear();
+    m_ipProtocols.clear();
+    m_tcpFlags.clear();
+    m_frameLengths.clear();
+    m_payloadLengths.clear();
+    m_flags.clear();
+}
+
+FrameColumns::SizeType FrameColumns::size() const
+{
+    return m_flags.size();
+}
+
+bool FrameColumns::empty() const
+{
+    return m_flags.empty();
+}
+
+std::span<const std::uint32_t> FrameColumns::getSourceIpAddresses() const
+{
+    return m_sourceIpAddresses;
+}
+
+std::span<const std::uint32_t> FrameColumns::getDestIpAddresses() const
+{
+    return m_destIpAddresses;
+}
+
+std::span<const std::uint16_t> FrameColumns::getSourcePorts() const
+{
+    return m_sourcePorts;
+}
+
+std::span<const std::uint16_t> FrameColumns::getDestPorts() const
+{
+    return m_destPorts;
+}
+
+std::span<const std::uint8_t> FrameColumns::getIpProtocols() const
+{
+    return m_ipProtocols;
+}
+
+std::span<const std::uint8_t> FrameColumns::getTcpFlags() const
+{
+    return m_tcpFlags;
+}
+
+std::span<const FrameColumns::SizeType> FrameColumns::getFrameLengths() const
+{
+    return m_frameLengths;
+}
+
+std::span<const std::uint16_t> FrameColumns::getPayloadLengths() const
+{
+    return m_payloadLengths;
+}
+
+std::span<const std::uint16_t> FrameColumns::getFlags() const
+{
+    return m_flags;
+}
+
+} //! namespace posnet
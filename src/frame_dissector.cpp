@@ -0,0 +1,238 @@
+#include "frame-dissector/frame_dissector.h"
+
+#include <algorithm>
+#include <cstdint>
+
+#include <net/ethernet.h>
+#include <netinet/ether.h>
+#include <netinet/if_ether.h>
+#include <netinet/ip.h>
+#include <netinet/tcp.h>
+#include <netinet/udp.h>
+#include <netinet/ip_icmp.h>
+#include <arpa/inet.h>
+
+namespace {
+
+using Flag = posnet::ParsedFrame::Flag;
+using SizeType = posnet::ParsedFrame::SizeType;
+
+constexpr SizeType VLAN_TAG_LENGTH_IN_BYTES = 4;
+constexpr SizeType ICMP_HEADER_LENGTH_IN_BYTES = 8;
+// There are at most two tags in practice(802.1ad + 802.1Q)
+constexpr auto MAX_VLAN_TAG_COUNT = 2;
+// How many frames ahead are prefetched by the batch dissection
+constexpr SizeType PREFETCH_DISTANCE = 4;
+// Ethernet, ip and l4 headers without options fit in two cache lines
+constexpr SizeType PREFETCH_SIZE_IN_BYTES = 128;
+constexpr SizeType CACHE_LINE_SIZE_IN_BYTES = 64;
+
+void PrefetchFrame(const posnet::ParsedFrame::ConstRawFrameViewType frame)
+{
+    const auto size = std::min<SizeType>(frame.size(), PREFETCH_SIZE_IN_BYTES);
+    for (SizeType offset = 0; offset < size; offset += CACHE_LINE_SIZE_IN_BYTES) {
+        __builtin_prefetch(frame.data() + offset, 0, 3);
+    }
+}
+
+bool IsVlanEtherType(const std::uint16_t etherType)
+{
+    return etherType == ETHERTYPE_VLAN || etherType == 0x88A8 /* 802.1ad */;
+}
+
+void SetPayload(posnet::ParsedFrame& parsedFrame, const SizeType offset, const SizeType end)
+{
+    parsedFrame.payloadOffset = offset;
+    parsedFrame.payloadLength = end > offset ? std::min<SizeType>(end - offset, UINT16_MAX) : 0;
+}
+
+void DissectL4(posnet::ParsedFrame& parsedFrame, const SizeType l3End)
+{
+    const auto offset = parsedFrame.l4Offset;
+    const auto available = l3End - offset;
+    switch (parsedFrame.ipProtocol) {
+        case IPPROTO_TCP: {
+            if (available < sizeof(struct tcphdr)) {
+                break;
+            }
+
+            const auto header = reinterpret_cast<const struct tcphdr*>(parsedFrame.frame + offset);
+            const SizeType headerLength = static_cast<SizeType>(header->doff) * 4;
+            if (headerLength < sizeof(struct tcphdr) || available < headerLength) {
+                break;
+            }
+
+            parsedFrame.sourcePort = ntohs(header->source);
+            parsedFrame.destPort = ntohs(header->dest);
+            // The flags(FIN, SYN, RST, PSH, ACK, URG, ...) are the 13-th byte of the header
+            parsedFrame.tcpFlags = parsedFrame.frame[offset + 13];
+            parsedFrame.setFlag(Flag::Tcp);
+            SetPayload(parsedFrame, offset + headerLength, l3End);
+            return;
+        }
+        case IPPROTO_UDP: {
+            if (available < sizeof(struct udphdr)) {
+                break;
+            }
+
+            const auto header = reinterpret_cast<const struct udphdr*>(parsedFrame.frame + offset);
+            parsedFrame.sourcePort = ntohs(header->source);
+            parsedFrame.destPort = ntohs(header->dest);
+            parsedFrame.setFlag(Flag::Udp);
+            SetPayload(parsedFrame, offset + sizeof(struct udphdr), l3End);
+            return;
+        }
+        case IPPROTO_ICMP: {
+            if (available < ICMP_HEADER_LENGTH_IN_BYTES) {
+                break;
+            }
+
+            parsedFrame.setFlag(Flag::Icmp);
+            SetPayload(parsedFrame, offset + ICMP_HEADER_LENGTH_IN_BYTES, l3End);
+            return;
+        }
+        default: {
+            // The payload of unknown protocol starts right after ip header
+            SetPayload(parsedFrame, offset, l3End);
+            return;
+        }
+    }
+    parsedFrame.setFlag(Flag::Truncated);
+}
+
+void DissectIp(posnet::ParsedFrame& parsedFrame)
+{
+    const auto offset = parsedFrame.l3Offset;
+    if (parsedFrame.frameSize - offset < sizeof(struct iphdr)) {
+        parsedFrame.setFlag(Flag::Truncated);
+        return;
+    }
+
+    const auto header = reinterpret_cast<const struct iphdr*>(parsedFrame.frame + offset);
+    const SizeType headerLength = static_cast<SizeType>(header->ihl) * 4;
+    if (header->version != 4 || headerLength < sizeof(struct iphdr) || parsedFrame.frameSize - offset < headerLength) {
+        parsedFrame.setFlag(Flag::Truncated);
+        return;
+    }
+
+    parsedFrame.ipProtocol = header->protocol;
+    parsedFrame.sourceIpAddress = header->saddr;
+    parsedFrame.destIpAddress = header->daddr;
+    parsedFrame.l4Offset = offset + headerLength;
+    parsedFrame.setFlag(Flag::Ip);
+
+    // The total length cuts off the padding of short Ethernet frames
+    auto l3End = offset + static_cast<SizeType>(ntohs(header->tot_len));
+    if (l3End > parsedFrame.frameSize) {
+        parsedFrame.setFlag(Flag::Truncated);
+        l3End = parsedFrame.frameSize;
+    } else if (l3End < parsedFrame.l4Offset) {
+        l3End = parsedFrame.l4Offset;
+    }
+
+    const auto fragment = ntohs(header->frag_off);
+    if ((fragment & (IP_MF | IP_OFFMASK)) != 0) {
+        parsedFrame.setFlag(Flag::Fragment);
+        if ((fragment & IP_OFFMASK) != 0) {
+            // Only the first fragment contains l4 header
+            SetPayload(parsedFrame, parsedFrame.l4Offset, l3End);
+            return;
+        }
+    }
+    DissectL4(parsedFrame, l3End);
+}
+
+} //! namespace
+
+namespace posnet {
+
+FrameDissector::FrameDissector():
+FrameDissector(Configuration{})
+{}
+
+FrameDissector::FrameDissector(const Configuration config):
+m_config(config)
+{}
+
+ParsedFrame FrameDissector::dissect(const ConstRawFrameViewType frame) const
+{
+    ParsedFrame parsedFrame;
+    dissect(frame, parsedFrame);
+    return parsedFrame;
+}
+
+void FrameDissector::dissect(const ConstRawFrameViewType frame, ParsedFrame& parsedFrame) const
+{
+    parsedFrame = ParsedFrame{};
+    parsedFrame.frame = frame.data();
+    parsedFrame.frameSize = frame.size();
+    if (frame.size() < sizeof(struct ethhdr)) {
+        parsedFrame.setFlag(ParsedFrame::Flag::Truncated);
+        return;
+    }
+
+    auto etherType = ntohs(reinterpret_cast<const struct ethhdr*>(frame.data())->h_proto);
+    SizeType offset = sizeof(struct ethhdr);
+    for (auto i = 0; m_config.parseVlan && i < MAX_VLAN_TAG_COUNT && IsVlanEtherType(etherType); ++i) {
+        if (frame.size() - offset < VLAN_TAG_LENGTH_IN_BYTES) {
+            parsedFrame.setFlag(ParsedFrame::Flag::Truncated);
+            return;
+        }
+
+        // The tag consists of TCI(PCP, DEI, VID) and ethertype of the next layer, the innermost VID is kept
+        const auto tag = frame.data() + offset;
+        parsedFrame.vlanId = ((tag[0] << 8) | tag[1]) & 0x0FFF;
+        etherType = (tag[2] << 8) | tag[3];
+        offset += VLAN_TAG_LENGTH_IN_BYTES;
+        parsedFrame.setFlag(ParsedFrame::Flag::Vlan);
+    }
+
+    parsedFrame.etherType = etherType;
+    parsedFrame.l3Offset = offset;
+    switch (etherType) {
+        case ETHERTYPE_IP: {
+            DissectIp(parsedFrame);
+            break;
+        }
+        case ETHERTYPE_ARP:
+        case ETHERTYPE_REVARP: {
+            if (frame.size() - offset < sizeof(struct ether_arp)) {
+                parsedFrame.setFlag(ParsedFrame::Flag::Truncated);
+                break;
+            }
+
+            parsedFrame.setFlag(ParsedFrame::Flag::Arp);
+            SetPayload(parsedFrame, offset, frame.size());
+            break;
+        }
+        default: {
+            SetPayload(parsedFrame, offset, frame.size());
+            break;
+        }
+    }
+}
+
+void FrameDissector::dissectBatch(const std::span<const ConstRawFrameViewType> frames, FrameColumns& columns) const
+{
+    columns.reserve(columns.size() + frames.size());
+    for (SizeType i = 0; i < std::min<SizeType>(frames.size(), PREFETCH_DISTANCE); ++i) {
+        PrefetchFrame(frames[i]);
+    }
+
+    ParsedFrame parsedFrame;
+    for (SizeType i = 0; i < frames.size(); ++i) {
+        if (i + PREFETCH_DISTANCE < frames.size()) {
+            PrefetchFrame(frames[i + PREFETCH_DISTANCE]);
+        }
+
+        dissect(frames[i], parsedFrame);
+        columns.append(parsedFrame);
+    }
+}
+
+const FrameDissector::Configuration& FrameDissector::getConfiguration() const
+{
+    return m_config;
+}
+
+} //! namespace posnet
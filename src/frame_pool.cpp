@@ -0,0 +1,267 @@
+#include "packet-buffer/frame_pool.h"
+
+#include "utils/system_error.h"
+
+#include <stdexcept>
+#include <string>
+#include <algorithm>
+#include <cstring>
+#include <cassert>
+
+#include <sys/mman.h>
+
+using namespace posnet::utils;
+
+namespace {
+
+std::size_t AlignUp(const std::size_t value, const std::size_t alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+void CheckConfiguration(const posnet::FramePool::Configuration& config)
+{
+    if (config.frameCount == 0 || config.frameCount >= UINT32_MAX) {
+        throw std::runtime_error("Invalid frame pool configuration: frame count=" + std::to_string(config.frameCount));
+    }
+
+    if (config.frameSizeInBytes == 0) {
+        throw std::runtime_error("Invalid frame pool configuration: frame size must be greater than zero");
+    }
+}
+
+std::uint64_t MakeHead(const std::uint64_t prevHead, const std::uint32_t index)
+{
+    const auto tag = (prevHead >> 32) + 1;
+    return (tag << 32) | index;
+}
+
+} //! namespace
+
+namespace posnet {
+
+FramePool::LocalCache::LocalCache(FramePool& pool, const SizeType capacity):
+m_pool(pool),
+m_capacity(capacity == 0 ? 1 : capacity),
+m_frames()
+{
+    m_frames.reserve(m_capacity);
+}
+
+FramePool::LocalCache::~LocalCache()
+{
+    flush();
+}
+
+FramePool::ByteType* FramePool::LocalCache::allocate() noexcept
+{
+    if (m_frames.empty()) {
+        // The cache is refilled by the half of its capacity, so the next deallocations do not overflow it at once
+        const auto refillCount = std::max<SizeType>(m_capacity / 2, 1);
+        m_frames.resize(refillCount);
+        m_frames.resize(m_pool.popFrames(m_frames.data(), refillCount));
+        m_pool.m_cacheRefills.fetch_add(1, std::memory_order_relaxed);
+
+        if (m_frames.empty()) {
+            m_pool.m_allocationFailures.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+    }
+
+    auto frame = m_frames.back();
+    m_frames.pop_back();
+    return frame;
+}
+
+void FramePool::LocalCache::deallocate(ByteType* const frame) noexcept
+{
+    assert(m_pool.owns(frame));
+    if (m_frames.size() == m_capacity) {
+        const auto flushCount = std::max<SizeType>(m_capacity / 2, 1);
+        for (SizeType i = 0; i < flushCount; ++i) {
+            m_pool.pushFrame(m_frames.back());
+            m_frames.pop_back();
+        }
+        m_pool.m_cacheFlushes.fetch_add(1, std::memory_order_relaxed);
+    }
+    m_frames.push_back(frame);
+}
+
+void FramePool::LocalCache::flush() noexcept
+{
+    if (m_frames.empty()) {
+        return;
+    }
+
+    for (const auto frame : m_frames) {
+        m_pool.pushFrame(frame);
+    }
+    m_frames.clear();
+    m_pool.m_cacheFlushes.fetch_add(1, std::memory_order_relaxed);
+}
+
+FramePool::SizeType FramePool::LocalCache::getCachedCount() const noexcept
+{
+    return static_cast<SizeType>(m_frames.size());
+}
+
+FramePool& FramePool::LocalCache::getPool() const noexcept
+{
+    return m_pool;
+}
+
+FramePool::FramePool(const Configuration config):
+m_config(config),
+m_frameSize(0),
+m_regionSize(0),
+m_region(nullptr),
+m_pageType(PageType::RegularPages),
+m_nextFrames(),
+m_head(0),
+m_availableFrames(0),
+m_allocationFailures(0),
+m_cacheRefills(0),
+m_cacheFlushes(0)
+{
+    CheckConfiguration(m_config);
+    m_frameSize = static_cast<SizeType>(AlignUp(m_config.frameSizeInBytes, FRAME_ALIGNMENT_IN_BYTES));
+    m_regionSize = AlignUp(static_cast<std::size_t>(m_frameSize) * m_config.frameCount, HUGE_PAGE_SIZE_IN_BYTES);
+
+    void* region = MAP_FAILED;
+    if (m_config.useHugePages) {
+        // It fails if the hugepages are not reserved(vm.nr_hugepages), then the regular pages are used
+        region = mmap(nullptr, m_regionSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | MAP_POPULATE, -1, 0);
+        m_pageType = PageType::HugePages;
+    }
+
+    if (region == MAP_FAILED) {
+        region = mmap(nullptr, m_regionSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (region == MAP_FAILED) {
+            throw std::runtime_error("Could not map region of frame pool: " + GetLastSysError());
+        }
+
+        m_pageType = PageType::RegularPages;
+        if (m_config.useHugePages && madvise(region, m_regionSize, MADV_HUGEPAGE) == 0) {
+            m_pageType = PageType::TransparentHugePages;
+        }
+        // The pages are faulted in now, so the first use of every frame does not stall on the page fault
+        std::memset(region, 0, m_regionSize);
+    }
+    m_region = static_cast<ByteType*>(region);
+
+    m_nextFrames = std::make_unique<std::atomic<std::uint32_t>[]>(m_config.frameCount);
+    for (SizeType i = 0; i < m_config.frameCount; ++i) {
+        m_nextFrames[i].store(i + 1 < m_config.frameCount ? i + 1 : EMPTY_INDEX, std::memory_order_relaxed);
+    }
+    m_head.store(0, std::memory_order_release);
+    m_availableFrames.store(m_config.frameCount, std::memory_order_release);
+}
+
+FramePool::~FramePool()
+{
+    (void)munmap(m_region, m_regionSize);
+}
+
+FramePool::ByteType* FramePool::allocate() noexcept
+{
+    ByteType* frame = nullptr;
+    if (popFrames(&frame, 1) == 0) {
+        m_allocationFailures.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    return frame;
+}
+
+void FramePool::deallocate(ByteType* const frame) noexcept
+{
+    assert(owns(frame));
+    pushFrame(frame);
+}
+
+FramePool::SizeType FramePool::popFrames(ByteType** const frames, const SizeType count) noexcept
+{
+    SizeType popped = 0;
+    auto head = m_head.load(std::memory_order_acquire);
+    while (popped < count) {
+        const auto index = static_cast<std::uint32_t>(head);
+        if (index == EMPTY_INDEX) {
+            break;
+        }
+
+        // The next index may be stale if the frame was popped and pushed again by another thread,
+        // then the tag of the head is changed and the exchange fails
+        const auto next = m_nextFrames[index].load(std::memory_order_relaxed);
+        if (m_head.compare_exchange_weak(head, MakeHead(head, next), std::memory_order_acquire, std::memory_order_acquire)) {
+            frames[popped++] = m_region + static_cast<std::size_t>(index) * m_frameSize;
+            head = m_head.load(std::memory_order_acquire);
+        }
+    }
+
+    if (popped != 0) {
+        m_availableFrames.fetch_sub(popped, std::memory_order_relaxed);
+    }
+    return popped;
+}
+
+void FramePool::pushFrame(ByteType* const frame) noexcept
+{
+    const auto index = static_cast<std::uint32_t>(getFrameIndex(frame));
+    // The counter is increased before the frame is published, so the pop of this frame never decreases it below zero
+    m_availableFrames.fetch_add(1, std::memory_order_relaxed);
+    auto head = m_head.load(std::memory_order_relaxed);
+    do {
+        m_nextFrames[index].store(static_cast<std::uint32_t>(head), std::memory_order_relaxed);
+    } while (!m_head.compare_exchange_weak(head, MakeHead(head, index), std::memory_order_release, std::memory_order_relaxed));
+}
+
+FramePool::SizeType FramePool::getFrameIndex(const ByteType* const frame) const noexcept
+{
+    return static_cast<SizeType>(static_cast<std::size_t>(frame - m_region) / m_frameSize);
+}
+
+bool FramePool::owns(const ByteType* const frame) const noexcept
+{
+    const auto regionEnd = m_region + static_cast<std::size_t>(m_frameSize) * m_config.frameCount;
+    return frame >= m_region && frame < regionEnd && static_cast<std::size_t>(frame - m_region) % m_frameSize == 0;
+}
+
+FramePool::SizeType FramePool::getFrameSize() const noexcept
+{
+    return m_frameSize;
+}
+
+FramePool::SizeType FramePool::getFrameCount() const noexcept
+{
+    return m_config.frameCount;
+}
+
+FramePool::PageType FramePool::getPageType() const noexcept
+{
+    return m_pageType;
+}
+
+FramePool::Statistics FramePool::getStatistics() const noexcept
+{
+    Statistics statistics;
+    statistics.frameCount = m_config.frameCount;
+    // The counter runs ahead of the list while the frames are pushed and popped concurrently, so it is clamped
+    statistics.availableFrames = std::min(m_availableFrames.load(std::memory_order_relaxed), statistics.frameCount);
+    statistics.occupiedFrames = statistics.frameCount - statistics.availableFrames;
+    statistics.allocationFailures = m_allocationFailures.load(std::memory_order_relaxed);
+    statistics.cacheRefills = m_cacheRefills.load(std::memory_order_relaxed);
+    statistics.cacheFlushes = m_cacheFlushes.load(std::memory_order_relaxed);
+    return statistics;
+}
+
+std::string_view PageTypeToStr(const FramePool::PageType pageType)
+{
+    switch (pageType) {
+        case FramePool::PageType::HugePages: return "HugePages";
+        case FramePool::PageType::TransparentHugePages: return "TransparentHugePages";
+        case FramePool::PageType::RegularPages: return "RegularPages";
+        default:
+            return "Undefined";
+    }
+}
+
+} //! namespace posnet
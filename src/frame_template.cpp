@@ -0,0 +1,282 @@
+#include "frame-builder/frame_template.h"
+
+#include "frame-viewers/ethernet_viewer.h"
+#include "frame-viewers/ip_viewer.h"
+#include "frame-viewers/udp_viewer.h"
+#include "frame-viewers/icmp_viewer.h"
+
+#include "utils/algorithms.h"
+#include "utils/byte_order.h"
+
+#include <array>
+#include <limits>
+#include <cstddef>
+#include <cstring>
+
+#include <netinet/in.h>
+
+using namespace posnet::utils;
+
+namespace {
+
+using ByteType = posnet::FrameTemplate::ByteType;
+using SizeType = posnet::FrameTemplate::SizeType;
+
+// The offsets of the fields from the start of their headers
+constexpr SizeType IP_ID_OFFSET = offsetof(struct iphdr, id);
+constexpr SizeType IP_CHECKSUM_OFFSET = offsetof(struct iphdr, check);
+constexpr SizeType UDP_SOURCE_PORT_OFFSET = offsetof(struct udphdr, source);
+constexpr SizeType UDP_DEST_PORT_OFFSET = offsetof(struct udphdr, dest);
+constexpr SizeType UDP_CHECKSUM_OFFSET = offsetof(struct udphdr, check);
+constexpr SizeType ICMP_ID_OFFSET = offsetof(struct icmphdr, un.echo.id);
+constexpr SizeType ICMP_SEQUENCE_OFFSET = offsetof(struct icmphdr, un.echo.sequence);
+constexpr SizeType ICMP_CHECKSUM_OFFSET = offsetof(struct icmphdr, checksum);
+
+// The destination frame may be unaligned, so the fields are accessed by memcpy
+std::uint16_t Load16(const ByteType* const field)
+{
+    std::uint16_t value;
+    std::memcpy(&value, field, sizeof(value));
+    return NetworkToHost16(value);
+}
+
+void Store16(ByteType* const field, const std::uint16_t value)
+{
+    const auto networkValue = HostToNetwork16(value);
+    std::memcpy(field, &networkValue, sizeof(networkValue));
+}
+
+std::uint32_t Load32(const ByteType* const field)
+{
+    std::uint32_t value;
+    std::memcpy(&value, field, sizeof(value));
+    return NetworkToHost32(value);
+}
+
+void Store32(ByteType* const field, const std::uint32_t value)
+{
+    const auto networkValue = HostToNetwork32(value);
+    std::memcpy(field, &networkValue, sizeof(networkValue));
+}
+
+// Rewrites the 16-bit field and returns the updated checksum
+std::uint16_t StampField16(ByteType* const field, const std::uint16_t value, const std::uint16_t checksum)
+{
+    const auto oldValue = Load16(field);
+    Store16(field, value);
+    return UpdateChecksum16(checksum, oldValue, value);
+}
+
+std::uint16_t StampField32(ByteType* const field, const std::uint32_t value, const std::uint16_t checksum)
+{
+    const auto oldValue = Load32(field);
+    Store32(field, value);
+    return UpdateChecksum32(checksum, oldValue, value);
+}
+
+// The checksum of udp datagram covers the pseudo header(RFC 768)
+std::uint16_t CalcUdpChecksum(const ByteType* const ipHeader, const posnet::FrameTemplate::ConstRawFrameViewType datagram)
+{
+    ChecksumAccumulator accumulator;
+    // The source and destination ip-addresses are adjacent in ip header
+    accumulator.add(posnet::FrameTemplate::ConstRawFrameViewType{ ipHeader + offsetof(struct iphdr, saddr), 2 * sizeof(std::uint32_t) })
+        .addWord16(IPPROTO_UDP)
+        .addWord16(static_cast<std::uint16_t>(datagram.size()))
+        .add(datagram);
+
+    const auto checksum = accumulator.getChecksum();
+    // The zero checksum is transmitted as all ones, because the zero value means that there is no checksum(RFC 768)
+    return checksum == 0 ? 0xFFFF : checksum;
+}
+
+void AppendFrame(std::vector<ByteType>& frame, const posnet::FrameTemplate::ConstRawFrameViewType data)
+{
+    frame.insert(frame.end(), data.begin(), data.end());
+}
+
+} //! namespace
+
+namespace posnet {
+
+FrameTemplate::FrameTemplate(const EthernetBuilder& ethernetBuilder, const IpBuilder& ipBuilder, const UdpBuilder& udpBuilder,
+    const ConstRawFrameViewType payload):
+FrameTemplate(&ethernetBuilder, ipBuilder, udpBuilder, TransportType::UDP, payload)
+{}
+
+FrameTemplate::FrameTemplate(const EthernetBuilder& ethernetBuilder, const IpBuilder& ipBuilder, const IcmpBuilder& icmpBuilder,
+    const ConstRawFrameViewType payload):
+FrameTemplate(&ethernetBuilder, ipBuilder, icmpBuilder, TransportType::ICMP, payload)
+{}
+
+FrameTemplate::FrameTemplate(const IpBuilder& ipBuilder, const UdpBuilder& udpBuilder, const ConstRawFrameViewType payload):
+FrameTemplate(nullptr, ipBuilder, udpBuilder, TransportType::UDP, payload)
+{}
+
+FrameTemplate::FrameTemplate(const IpBuilder& ipBuilder, const IcmpBuilder& icmpBuilder, const ConstRawFrameViewType payload):
+FrameTemplate(nullptr, ipBuilder, icmpBuilder, TransportType::ICMP, payload)
+{}
+
+FrameTemplate::FrameTemplate(const EthernetBuilder* const ethernetBuilder, const IpBuilder& ipBuilder, const BaseFrame& transportBuilder,
+    const TransportType transportType, const ConstRawFrameViewType payload):
+m_frame(),
+m_transportType(transportType),
+m_ipOffset(ethernetBuilder != nullptr ? ethernetBuilder->getSize() : 0),
+m_transportOffset(m_ipOffset + ipBuilder.getSize()),
+m_payloadOffset(m_transportOffset + transportBuilder.getSize()),
+m_payloadCounterOffset(std::nullopt)
+{
+    const auto ipTotalLength = m_payloadOffset - m_ipOffset + payload.size();
+    if (ipTotalLength > std::numeric_limits<std::uint16_t>::max()) {
+        throw std::runtime_error("Could not create frame template: total length of ip packet=" +
+            std::to_string(ipTotalLength) + " is too big");
+    }
+
+    m_frame.reserve(m_payloadOffset + payload.size());
+    if (ethernetBuilder != nullptr) {
+        AppendFrame(m_frame, ethernetBuilder->getAsRawFrameView());
+    }
+    AppendFrame(m_frame, ipBuilder.getAsRawFrameView());
+    AppendFrame(m_frame, transportBuilder.getAsRawFrameView());
+    AppendFrame(m_frame, payload);
+
+    auto ipHeader = m_frame.data() + m_ipOffset;
+    auto transportHeader = m_frame.data() + m_transportOffset;
+    const auto transportLength = static_cast<SizeType>(m_frame.size()) - m_transportOffset;
+
+    Store16(ipHeader + offsetof(struct iphdr, tot_len), static_cast<std::uint16_t>(ipTotalLength));
+    ipHeader[offsetof(struct iphdr, protocol)] = transportType == TransportType::UDP ? IPPROTO_UDP : IPPROTO_ICMP;
+    Store16(ipHeader + IP_CHECKSUM_OFFSET, 0);
+    Store16(ipHeader + IP_CHECKSUM_OFFSET, CalcChecksum(ConstRawFrameViewType{ ipHeader, ipBuilder.getSize() }));
+
+    const ConstRawFrameViewType transport{ transportHeader, transportLength };
+    switch (transportType) {
+        case TransportType::UDP: {
+            Store16(transportHeader + offsetof(struct udphdr, len), static_cast<std::uint16_t>(transportLength));
+            Store16(transportHeader + UDP_CHECKSUM_OFFSET, 0);
+            Store16(transportHeader + UDP_CHECKSUM_OFFSET, CalcUdpChecksum(ipHeader, transport));
+            break;
+        }
+        case TransportType::ICMP: {
+            Store16(transportHeader + ICMP_CHECKSUM_OFFSET, 0);
+            Store16(transportHeader + ICMP_CHECKSUM_OFFSET, CalcChecksum(transport));
+            break;
+        }
+        default:
+            throw std::runtime_error("Undefined transport type of frame template=" +
+                std::to_string(static_cast<unsigned int>(transportType)));
+    }
+}
+
+FrameTemplate& FrameTemplate::setPayloadCounterOffset(const SizeType offset) &
+{
+    if (offset % 2 != 0) {
+        throw std::runtime_error("Could not set payload counter offset=" + std::to_string(offset) + ": the offset must be even");
+    }
+
+    if (m_payloadOffset + offset + PAYLOAD_COUNTER_LENGTH_IN_BYTES > m_frame.size()) {
+        throw std::runtime_error("Could not set payload counter offset=" + std::to_string(offset) +
+            ": the counter does not fit in the payload of size=" + std::to_string(m_frame.size() - m_payloadOffset));
+    }
+
+    m_payloadCounterOffset = offset;
+    return *this;
+}
+
+void FrameTemplate::stamp(const RawFrameViewType frame, const Stamp& stamp) const
+{
+    if (frame.size() < m_frame.size()) {
+        throw std::runtime_error("Could not stamp frame template: the frame size=" + std::to_string(frame.size()) +
+            " is less than the template size=" + std::to_string(m_frame.size()));
+    }
+
+    const bool isUdp = (m_transportType == TransportType::UDP);
+    if ((isUdp && (stamp.icmpId || stamp.icmpSequence)) || (!isUdp && (stamp.sourcePort || stamp.destPort))) {
+        throw std::runtime_error("Could not stamp frame template: the stamp has the fields of another transport layer");
+    }
+
+    if (stamp.payloadCounter && !m_payloadCounterOffset) {
+        throw std::runtime_error("Could not stamp frame template: the offset of payload counter is not set");
+    }
+
+    std::memcpy(frame.data(), m_frame.data(), m_frame.size());
+
+    auto ipHeader = frame.data() + m_ipOffset;
+    if (stamp.ipId) {
+        Store16(ipHeader + IP_CHECKSUM_OFFSET, StampField16(ipHeader + IP_ID_OFFSET, *stamp.ipId, Load16(ipHeader + IP_CHECKSUM_OFFSET)));
+    }
+
+    auto transportHeader = frame.data() + m_transportOffset;
+    const auto checksumField = transportHeader + (isUdp ? UDP_CHECKSUM_OFFSET : ICMP_CHECKSUM_OFFSET);
+    auto checksum = Load16(checksumField);
+    if (isUdp) {
+        if (stamp.sourcePort) {
+            checksum = StampField16(transportHeader + UDP_SOURCE_PORT_OFFSET, *stamp.sourcePort, checksum);
+        }
+        if (stamp.destPort) {
+            checksum = StampField16(transportHeader + UDP_DEST_PORT_OFFSET, *stamp.destPort, checksum);
+        }
+    } else {
+        if (stamp.icmpId) {
+            checksum = StampField16(transportHeader + ICMP_ID_OFFSET, *stamp.icmpId, checksum);
+        }
+        if (stamp.icmpSequence) {
+            checksum = StampField16(transportHeader + ICMP_SEQUENCE_OFFSET, *stamp.icmpSequence, checksum);
+        }
+    }
+
+    if (stamp.payloadCounter) {
+        checksum = StampField32(frame.data() + m_payloadOffset + *m_payloadCounterOffset, *stamp.payloadCounter, checksum);
+    }
+
+    if (isUdp && checksum == 0) {
+        checksum = 0xFFFF;
+    }
+    Store16(checksumField, checksum);
+}
+
+void FrameTemplate::stampBatch(const RawFrameViewType buffer, const std::span<const Stamp> stamps) const
+{
+    stampBatch(buffer, static_cast<SizeType>(stamps.size()), [stamps](const SizeType i) -> const Stamp& {
+        return stamps[i];
+    });
+}
+
+FrameTemplate::RawFrameViewType FrameTemplate::getBatchFrame(const RawFrameViewType buffer, const SizeType index) const noexcept
+{
+    return buffer.subspan(static_cast<std::size_t>(index) * getStride(), m_frame.size());
+}
+
+void FrameTemplate::checkBatchBuffer(const RawFrameViewType buffer, const SizeType count) const
+{
+    if (buffer.size() < static_cast<std::size_t>(count) * getStride()) {
+        throw std::runtime_error("Could not stamp batch of frame template: the buffer size=" + std::to_string(buffer.size()) +
+            " is less than the batch size=" + std::to_string(static_cast<std::size_t>(count) * getStride()));
+    }
+}
+
+FrameTemplate::ConstRawFrameViewType FrameTemplate::getAsRawFrameView() const noexcept
+{
+    return ConstRawFrameViewType{ m_frame };
+}
+
+FrameTemplate::SizeType FrameTemplate::getSize() const noexcept
+{
+    return static_cast<SizeType>(m_frame.size());
+}
+
+FrameTemplate::SizeType FrameTemplate::getStride() const noexcept
+{
+    return (getSize() + BATCH_STRIDE_ALIGNMENT_IN_BYTES - 1) / BATCH_STRIDE_ALIGNMENT_IN_BYTES * BATCH_STRIDE_ALIGNMENT_IN_BYTES;
+}
+
+FrameTemplate::TransportType FrameTemplate::getTransportType() const noexcept
+{
+    return m_transportType;
+}
+
+bool FrameTemplate::hasEthernetHeader() const noexcept
+{
+    return m_ipOffset != 0;
+}
+
+} //! namespace posnet
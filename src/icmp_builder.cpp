@@ -1,4 +1,5 @@
 #include "include/frame-builder/icmp_builder.h"
+#include "include/packet-buffer/packet_buffer.h"
 
 #include "include/frame-viewers/icmp_viewer.h"
 
@@ -139,6 +140,11 @@ IcmpBuilder& IcmpBuilder::setSequenceNumber(const unsigned int seqNumber) &
     return *this;
 }
 
+void IcmpBuilder::prependTo(PacketBuffer& buffer) const
+{
+    std::memcpy(buffer.prepend(DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES).data(), &m_frame, DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES);
+}
+
 std::ostream& IcmpBuilder::operator<<(std::ostream& os) const
 {
     return os << IcmpViewer(getAsRawFrameView());
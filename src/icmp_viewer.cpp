@@ -1,9 +1,5 @@
 #include "frame-viewers/icmp_viewer.h"
 
-#include "frame-viewers/ethernet_viewer.h"
-
-#include <arpa/inet.h>
-
 namespace {
 
 posnet::IcmpViewer::PackageType ExtractPackageType(const unsigned char type)
@@ -185,61 +181,9 @@ std::string_view PackageCodeToStr(const posnet::IcmpViewer::PackageCode packageC
 
 namespace posnet {
     
-IcmpViewer::IcmpViewer(IpViewer ipViewer):
-BaseFrame(reinterpret_cast<const BaseFrame::ByteType*>(ipViewer.getStart()), ipViewer.getSize()),
-m_frame(reinterpret_cast<HeaderStructType*>(
-    ipViewer.getFrameHeaderStart() + ipViewer.getHeaderLengthInBytes()))
-{}
-
-IcmpViewer::IcmpViewer(const ConstRawFrameViewType rawFrame):
-BaseFrame(reinterpret_cast<const BaseFrame::ByteType*>(rawFrame.data()), DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES),
-m_frame(reinterpret_cast<HeaderStructType*>(
-    const_cast<RawFrameViewType::value_type*>(rawFrame.data())))
-{}
-
-IcmpViewer::IcmpViewer(const RawFrameViewType rawFrame):
-BaseFrame(reinterpret_cast<const BaseFrame::ByteType*>(rawFrame.data()), DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES),
-m_frame(reinterpret_cast<HeaderStructType*>(rawFrame.data()))
-{}
-
-IcmpViewer::PackageType IcmpViewer::getType()
-{
-    return ExtractPackageType(m_frame->type);
-}
-
-std::string_view IcmpViewer::getTypeAsStr()
-{
-    return PackageTypeToStr(getType());
-}
-
-IcmpViewer::PackageCode IcmpViewer::getCode()
-{
-    return ExtractPackageCode(getType(), m_frame->code);
-}
-
-std::string_view IcmpViewer::getCodeAsStr()
-{
-    return PackageCodeToStr(getCode());
-}
-
-unsigned int IcmpViewer::getCheckSum()
-{
-    return ntohs(m_frame->checksum);
-}
-
-unsigned int IcmpViewer::getId()
-{
-    return ntohs(m_frame->un.echo.id);
-}
-
-unsigned int IcmpViewer::getSequenceNumber()
-{
-    return ntohs(m_frame->un.echo.sequence);
-}
-
 IcmpViewer::PackageType IcmpViewer::getType() const
 {
-    return ExtractPackageType(m_frame->type);
+    return ExtractPackageType(getHeader()->type);
 }
 
 std::string_view IcmpViewer::getTypeAsStr() const
@@ -249,7 +193,7 @@ std::string_view IcmpViewer::getTypeAsStr() const
 
 IcmpViewer::PackageCode IcmpViewer::getCode() const
 {
-    return ExtractPackageCode(getType(), m_frame->code);
+    return ExtractPackageCode(getType(), getHeader()->code);
 }
 
 std::string_view IcmpViewer::getCodeAsStr() const
@@ -257,21 +201,6 @@ std::string_view IcmpViewer::getCodeAsStr() const
     return PackageCodeToStr(getCode());
 }
 
-unsigned int IcmpViewer::getCheckSum() const
-{
-    return ntohs(m_frame->checksum);
-}
-
-unsigned int IcmpViewer::getId() const
-{
-    return ntohs(m_frame->un.echo.id);
-}
-
-unsigned int IcmpViewer::getSequenceNumber() const
-{
-    return ntohs(m_frame->un.echo.sequence);
-}
-
 std::ostream& IcmpViewer::operator<<(std::ostream& os) const
 {
     os << "ICMP header {\n";
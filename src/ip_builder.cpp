@@ -1,4 +1,5 @@
 #include "include/frame-builder/ip_builder.h"
+#include "include/packet-buffer/packet_buffer.h"
 
 #include "include/frame-viewers/ethernet_viewer.h"
 #include "include/frame-viewers/ip_viewer.h"
@@ -7,14 +8,17 @@
 #include "include/utils/algorithms.h"
 
 #include <stdexcept>
+#include <string>
 #include <sstream>
 #include <cstring>
+#include <cstddef>
 
 namespace posnet {
     
 IpBuilder::IpBuilder():
 BaseFrame(reinterpret_cast<const BaseFrame::ByteType*>(&m_frame), DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES),
-m_frame()
+m_frame(),
+m_isCheckSumSet(false)
 {
     std::memset(&m_frame, 0, sizeof(HeaderStructType));
 }
@@ -23,11 +27,11 @@ IpBuilder& IpBuilder::setVersion(const VersionType version) &
 {
     switch (version) {
         case VersionType::V4: {
-            m_frame.version = 4;
+            setHeaderField(0, [this]() { m_frame.version = 4; });
             break;
         }
         case VersionType::V6: {
-            m_frame.version = 6;
+            setHeaderField(0, [this]() { m_frame.version = 6; });
             break;
         }
         default:
@@ -42,15 +46,15 @@ IpBuilder& IpBuilder::setProtocol(const ProtocolType protocol) &
 {
     switch (protocol) {
         case ProtocolType::TCP: {
-            m_frame.protocol = IPPROTO_TCP;
+            setHeaderField(offsetof(HeaderStructType, protocol), [this]() { m_frame.protocol = IPPROTO_TCP; });
             break;
         }
         case ProtocolType::UDP: {
-            m_frame.protocol = IPPROTO_UDP;
+            setHeaderField(offsetof(HeaderStructType, protocol), [this]() { m_frame.protocol = IPPROTO_UDP; });
             break;
         }
         case ProtocolType::ICMP: {
-            m_frame.protocol = IPPROTO_ICMP;
+            setHeaderField(offsetof(HeaderStructType, protocol), [this]() { m_frame.protocol = IPPROTO_ICMP; });
             break;
         }
         default:
@@ -63,13 +67,13 @@ IpBuilder& IpBuilder::setProtocol(const ProtocolType protocol) &
 
 IpBuilder& IpBuilder::setTypeOfService(const unsigned int tos) &
 {
-    m_frame.tos = tos;
+    setHeaderField(offsetof(HeaderStructType, tos), [this, tos]() { m_frame.tos = tos; });
     return *this;
 }
 
 IpBuilder& IpBuilder::setHeaderLengthInBytes(const unsigned int length) &
 {
-    m_frame.ihl = length / 4;
+    setHeaderField(0, [this, length]() { m_frame.ihl = length / 4; });
     return *this;
 }
 
@@ -81,13 +85,13 @@ IpBuilder& IpBuilder::setTotalLength(const unsigned int length) &
     Чтобы вычислить tot_len, вы должны сложить длину заголовка IP (который обычно составляет 20 байт без опций) и длину данных, 
     которые следуют за IP-заголовком. Длина данных указывается в октетах, поэтому вам нужно умножить ее на 4, чтобы получить длину в байтах.
     */
-    m_frame.tot_len = htons(length);
+    setHeaderField(offsetof(HeaderStructType, tot_len), [this, length]() { m_frame.tot_len = htons(length); });
     return *this;
 }
 
 IpBuilder& IpBuilder::setId(const unsigned int id) &
 {
-    m_frame.id = htons(id);
+    setHeaderField(offsetof(HeaderStructType, id), [this, id]() { m_frame.id = htons(id); });
     return *this;
 }
 
@@ -119,19 +123,37 @@ IpBuilder& IpBuilder::setFragmentOffset(const bool needToFragmentPackage, const
         value |= 0x4000; // set "Don't Fragment"(DF) flag value
     }
 
-    m_frame.frag_off = htons(value);
+    setHeaderField(offsetof(HeaderStructType, frag_off), [this, value]() { m_frame.frag_off = htons(value); });
     return *this;
 }
 
 IpBuilder& IpBuilder::setTTL(const unsigned int ttl) &
 {
-    m_frame.ttl =  ttl;
+    setHeaderField(offsetof(HeaderStructType, ttl), [this, ttl]() { m_frame.ttl = ttl; });
     return *this;
 }
 
 IpBuilder& IpBuilder::setCheckSum(const unsigned int checkSum) &
 {
     m_frame.check = htons(checkSum);
+    m_isCheckSumSet = false;
+    return *this;
+}
+
+IpBuilder& IpBuilder::calcCheckSum() &
+{
+    m_frame.check = 0;
+    m_frame.check = htons(posnet::utils::CalcChecksum(
+        ConstRawVieType{ reinterpret_cast<const std::uint8_t*>(&m_frame), sizeof(HeaderStructType) }
+    ));
+    m_isCheckSumSet = true;
+    return *this;
+}
+
+IpBuilder& IpBuilder::resetCheckSum() &
+{
+    m_frame.check = 0;
+    m_isCheckSumSet = false;
     return *this;
 }
 
@@ -139,6 +161,7 @@ IpBuilder& IpBuilder::setSourceIpAddress(const std::string_view ipAddr) &
 {
     const auto result = posnet::utils::StrToIpAddr(ipAddr);
     if (result) {
+        updateCheckSum(m_frame.saddr, *result);
         m_frame.saddr = *result;
     } else {
         std::stringstream ss;
@@ -152,6 +175,7 @@ IpBuilder& IpBuilder::setDestIpAddress(const std::string_view ipAddr) &
 {
     const auto result = posnet::utils::StrToIpAddr(ipAddr);
     if (result) {
+        updateCheckSum(m_frame.daddr, *result);
         m_frame.daddr = *result;
     } else {
          std::stringstream ss;
@@ -161,6 +185,19 @@ IpBuilder& IpBuilder::setDestIpAddress(const std::string_view ipAddr) &
     return *this;
 }
 
+void IpBuilder::updateCheckSum(const std::uint32_t oldIpAddr, const std::uint32_t newIpAddr)
+{
+    if (m_isCheckSumSet) {
+        m_frame.check = htons(posnet::utils::UpdateChecksum32(ntohs(m_frame.check), ntohl(oldIpAddr), ntohl(newIpAddr)));
+    }
+}
+
+std::uint16_t IpBuilder::getHeaderWord(const std::size_t offsetInBytes) const noexcept
+{
+    const auto* const word = reinterpret_cast<const ByteType*>(&m_frame) + (offsetInBytes & ~static_cast<std::size_t>(1));
+    return static_cast<std::uint16_t>((word[0] << 8) | word[1]);
+}
+
 unsigned int IpBuilder::getDefaultCheckSum()
 {
     /*
@@ -183,6 +220,21 @@ unsigned int IpBuilder::getDefaultCheckSum() const
     );
 }
 
+void IpBuilder::prependTo(PacketBuffer& buffer) const
+{
+    const auto totalLength = DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES + buffer.getSize();
+    if (totalLength > UINT16_MAX) {
+        throw std::runtime_error("Could not prepend ip header to packet buffer: total length=" + std::to_string(totalLength) +
+            " exceeds the maximum=" + std::to_string(UINT16_MAX));
+    }
+
+    auto header = m_frame;
+    header.tot_len = htons(static_cast<std::uint16_t>(totalLength));
+    header.check = 0;
+    header.check = htons(posnet::utils::CalcChecksum(ConstRawVieType{ reinterpret_cast<const ByteType*>(&header), sizeof(header) }));
+    std::memcpy(buffer.prepend(DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES).data(), &header, sizeof(header));
+}
+
 std::ostream& IpBuilder::operator<<(std::ostream& os) const
 {
     return os << IpViewer(getAsRawFrameView());
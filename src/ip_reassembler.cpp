@@ -0,0 +1,403 @@
+#include "ip-reassembly/ip_reassembler.h"
+
+#include "frame-viewers/ip_viewer.h"
+#include "utils/algorithms.h"
+#include "utils/byte_order.h"
+#include "utils/ring_policy.h"
+
+#include <stdexcept>
+#include <string>
+#include <algorithm>
+#include <cstring>
+#include <cassert>
+
+#include <netinet/ip.h>
+
+using namespace posnet::utils;
+
+namespace {
+
+constexpr unsigned int FRAGMENT_OFFSET_UNIT_IN_BYTES = 8;
+constexpr unsigned int MIN_IP_HEADER_LENGTH_IN_BYTES = sizeof(struct iphdr);
+
+void CheckConfiguration(const posnet::IpReassembler::Configuration& config)
+{
+    if (config.maxDatagramCount == 0 || config.maxDatagramCount >= UINT32_MAX / 2) {
+        throw std::runtime_error("Invalid ip reassembler configuration: max datagram count=" + std::to_string(config.maxDatagramCount));
+    }
+
+    if (config.memoryLimitInBytes < posnet::IpReassembler::CHUNK_SIZE_IN_BYTES) {
+        throw std::runtime_error("Invalid ip reassembler configuration: memory limit=" + std::to_string(config.memoryLimitInBytes));
+    }
+
+    if (config.maxFragmentCount == 0) {
+        throw std::runtime_error("Invalid ip reassembler configuration: max fragment count must be greater than zero");
+    }
+
+    if (config.maxDatagramSizeInBytes <= MIN_IP_HEADER_LENGTH_IN_BYTES
+        || config.maxDatagramSizeInBytes > posnet::IpReassembler::MAX_DATAGRAM_SIZE_IN_BYTES) {
+        throw std::runtime_error("Invalid ip reassembler configuration: max datagram size=" + std::to_string(config.maxDatagramSizeInBytes));
+    }
+
+    if (config.timeout <= std::chrono::nanoseconds::zero()) {
+        throw std::runtime_error("Invalid ip reassembler configuration: timeout must be greater than zero");
+    }
+}
+
+} //! namespace
+
+namespace posnet {
+
+IpReassembler::IpReassembler(Configuration config, const TimestampType now):
+m_config(config),
+m_datagrams(),
+m_freeDatagrams(),
+m_index(),
+m_indexMask(0),
+m_slab(),
+m_freeChunks(),
+m_datagramBuffer(MAX_DATAGRAM_SIZE_IN_BYTES),
+m_timerWheel(TimerWheel::Configuration{ .initialCapacity = config.maxDatagramCount }, now),
+m_statistics()
+{
+    CheckConfiguration(m_config);
+
+    m_datagrams.resize(m_config.maxDatagramCount);
+    m_freeDatagrams.reserve(m_config.maxDatagramCount);
+    for (auto index = m_config.maxDatagramCount; index > 0; --index) {
+        auto& datagram = m_datagrams[index - 1];
+        datagram.ranges.reserve(m_config.maxFragmentCount);
+        datagram.chunks.fill(NULL_INDEX);
+        m_freeDatagrams.push_back(index - 1);
+    }
+
+    const auto indexSize = RoundUpToPowerOfTwo(static_cast<std::size_t>(m_config.maxDatagramCount) * 2);
+    m_index.assign(indexSize, NULL_INDEX);
+    m_indexMask = static_cast<std::uint32_t>(indexSize - 1);
+
+    const auto chunkCount = m_config.memoryLimitInBytes / CHUNK_SIZE_IN_BYTES;
+    m_slab.resize(static_cast<std::size_t>(chunkCount) * CHUNK_SIZE_IN_BYTES);
+    m_freeChunks.reserve(chunkCount);
+    for (auto chunk = chunkCount; chunk > 0; --chunk) {
+        m_freeChunks.push_back(chunk - 1);
+    }
+}
+
+std::optional<IpReassembler::ConstRawFrameViewType> IpReassembler::process(const ConstRawFrameViewType ipPacket,
+    const TimestampType timestamp)
+{
+    advance(timestamp);
+
+    const auto ipViewer = IpViewer::TryView(ipPacket);
+    if (!ipViewer) {
+        ++m_statistics.malformedPackets;
+        return std::nullopt;
+    }
+
+    const auto fragment = NetworkToHost16(static_cast<std::uint16_t>(ipViewer->getFragmentOffset()));
+    if ((fragment & (IP_MF | IP_OFFMASK)) == 0) {
+        return ipPacket.first(ipViewer->getTotalLength());
+    }
+
+    ++m_statistics.fragments;
+    const auto payload = ipViewer->getPayload(ipPacket);
+    const auto offset = static_cast<std::uint32_t>(fragment & IP_OFFMASK) * FRAGMENT_OFFSET_UNIT_IN_BYTES;
+    const bool isLast = (fragment & IP_MF) == 0;
+    // Every fragment except the last one carries the multiple of 8 bytes
+    if (payload.empty() || (!isLast && payload.size() % FRAGMENT_OFFSET_UNIT_IN_BYTES != 0)) {
+        ++m_statistics.malformedPackets;
+        return std::nullopt;
+    }
+
+    const auto header = ipPacket.first(ipViewer->getHeaderLengthInBytes());
+    const DatagramKey key{
+        .sourceIpAddress = ipViewer->getSourceIpAddress(),
+        .destIpAddress = ipViewer->getDestIpAddress(),
+        .id = static_cast<std::uint16_t>(ipViewer->getId()),
+        .protocol = header[9],
+    };
+
+    auto index = findDatagram(key);
+    if (index == NULL_INDEX) {
+        index = createDatagram(key, timestamp);
+        if (index == NULL_INDEX) {
+            ++m_statistics.memoryDrops;
+            return std::nullopt;
+        }
+    }
+
+    auto& datagram = m_datagrams[index];
+    const auto result = addFragment(datagram, offset, payload, isLast);
+    switch (result) {
+        case AddResult::Added:
+            break;
+        case AddResult::Duplicate:
+            ++m_statistics.duplicateFragments;
+            return std::nullopt;
+        case AddResult::Overlap:
+            ++m_statistics.overlapDrops;
+            dropDatagram(index);
+            return std::nullopt;
+        case AddResult::Limit:
+            ++m_statistics.limitDrops;
+            dropDatagram(index);
+            return std::nullopt;
+        case AddResult::Memory:
+            ++m_statistics.memoryDrops;
+            dropDatagram(index);
+            return std::nullopt;
+    }
+
+    if (offset == 0) {
+        datagram.headerLength = static_cast<SizeType>(header.size());
+        std::memcpy(datagram.header.data(), header.data(), header.size());
+    }
+
+    if (datagram.totalLength == 0 || datagram.receivedLength != datagram.totalLength) {
+        return std::nullopt;
+    }
+
+    if (datagram.headerLength + datagram.totalLength > MAX_DATAGRAM_SIZE_IN_BYTES) {
+        ++m_statistics.limitDrops;
+        dropDatagram(index);
+        return std::nullopt;
+    }
+
+    const auto reassembled = buildDatagram(datagram);
+    ++m_statistics.reassembledDatagrams;
+    dropDatagram(index);
+    return reassembled;
+}
+
+IpReassembler::SizeType IpReassembler::advance(const TimestampType now)
+{
+    return static_cast<SizeType>(m_timerWheel.advance(now, [this](TimerWheel::TimerIdType, const std::uint64_t index) {
+        ++m_statistics.timeouts;
+        releaseDatagram(static_cast<std::uint32_t>(index));
+    }));
+}
+
+void IpReassembler::clear() noexcept
+{
+    for (std::uint32_t index = 0; index < m_datagrams.size(); ++index) {
+        if (m_datagrams[index].timerId != TimerWheel::INVALID_TIMER_ID) {
+            dropDatagram(index);
+        }
+    }
+}
+
+const IpReassembler::Configuration& IpReassembler::getConfiguration() const noexcept
+{
+    return m_config;
+}
+
+IpReassembler::Statistics IpReassembler::getStatistics() const noexcept
+{
+    auto statistics = m_statistics;
+    statistics.activeDatagrams = static_cast<SizeType>(m_datagrams.size() - m_freeDatagrams.size());
+    statistics.usedMemoryInBytes = static_cast<SizeType>(m_slab.size() - m_freeChunks.size() * CHUNK_SIZE_IN_BYTES);
+    return statistics;
+}
+
+std::uint64_t IpReassembler::GetHash(const DatagramKey& key) noexcept
+{
+    auto hash = ((static_cast<std::uint64_t>(key.sourceIpAddress) << 32) | key.destIpAddress) * 0x9e3779b97f4a7c15ULL;
+    hash ^= (static_cast<std::uint64_t>(key.id) << 8) | key.protocol;
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+std::uint32_t IpReassembler::findDatagram(const DatagramKey& key) const noexcept
+{
+    for (auto position = static_cast<std::uint32_t>(GetHash(key)) & m_indexMask; ; position = (position + 1) & m_indexMask) {
+        const auto index = m_index[position];
+        if (index == NULL_INDEX || m_datagrams[index].key == key) {
+            return index;
+        }
+    }
+}
+
+std::uint32_t IpReassembler::createDatagram(const DatagramKey& key, const TimestampType timestamp)
+{
+    if (m_freeDatagrams.empty()) {
+        return NULL_INDEX;
+    }
+
+    const auto index = m_freeDatagrams.back();
+    m_freeDatagrams.pop_back();
+
+    auto position = static_cast<std::uint32_t>(GetHash(key)) & m_indexMask;
+    while (m_index[position] != NULL_INDEX) {
+        position = (position + 1) & m_indexMask;
+    }
+    m_index[position] = index;
+
+    auto& datagram = m_datagrams[index];
+    datagram.key = key;
+    datagram.totalLength = 0;
+    datagram.receivedLength = 0;
+    datagram.fragmentCount = 0;
+    datagram.headerLength = 0;
+    datagram.ranges.clear();
+    datagram.timerId = m_timerWheel.schedule(timestamp + m_config.timeout, index);
+    return index;
+}
+
+IpReassembler::AddResult IpReassembler::addFragment(Datagram& datagram, const std::uint32_t offset,
+    const ConstRawFrameViewType payload, const bool isLast)
+{
+    const auto end = offset + static_cast<std::uint32_t>(payload.size());
+    if (++datagram.fragmentCount > m_config.maxFragmentCount || end + MIN_IP_HEADER_LENGTH_IN_BYTES > m_config.maxDatagramSizeInBytes) {
+        return AddResult::Limit;
+    }
+
+    // The fragments after the end of the datagram or the second last fragment with the other end are inconsistent
+    if (isLast) {
+        if ((datagram.totalLength != 0 && datagram.totalLength != end)
+            || (!datagram.ranges.empty() && datagram.ranges.back().end > end)) {
+            return AddResult::Overlap;
+        }
+    } else if (datagram.totalLength != 0 && end > datagram.totalLength) {
+        return AddResult::Overlap;
+    }
+
+    // The first range, which ends after the start of the fragment
+    auto it = std::find_if(datagram.ranges.begin(), datagram.ranges.end(), [offset](const Range& range) {
+        return range.end > offset;
+    });
+    const bool isOverlapped = it != datagram.ranges.end() && it->start < end;
+    if (isOverlapped) {
+        if (it->start <= offset && it->end >= end) {
+            --datagram.fragmentCount;
+            return AddResult::Duplicate;
+        }
+
+        if (m_config.overlapPolicy == OverlapPolicy::Drop) {
+            return AddResult::Overlap;
+        }
+    }
+
+    // Only the gaps between the received ranges are copied
+    auto position = offset;
+    for (auto rangeIt = it; rangeIt != datagram.ranges.end() && rangeIt->start < end; ++rangeIt) {
+        if (rangeIt->start > position && !copyPayload(datagram, position, payload.subspan(position - offset, rangeIt->start - position))) {
+            return AddResult::Memory;
+        }
+        position = std::max(position, rangeIt->end);
+    }
+
+    if (position < end && !copyPayload(datagram, position, payload.subspan(position - offset, end - position))) {
+        return AddResult::Memory;
+    }
+
+    // The ranges, which overlap or touch the fragment, are merged into one
+    auto first = std::find_if(datagram.ranges.begin(), datagram.ranges.end(), [offset](const Range& range) {
+        return range.end >= offset;
+    });
+    auto last = first;
+    Range merged{ offset, end };
+    while (last != datagram.ranges.end() && last->start <= end) {
+        merged.start = std::min(merged.start, last->start);
+        merged.end = std::max(merged.end, last->end);
+        ++last;
+    }
+    first = datagram.ranges.erase(first, last);
+    datagram.ranges.insert(first, merged);
+
+    if (isLast) {
+        datagram.totalLength = end;
+    }
+    return AddResult::Added;
+}
+
+bool IpReassembler::copyPayload(Datagram& datagram, std::uint32_t offset, ConstRawFrameViewType payload) noexcept
+{
+    while (!payload.empty()) {
+        auto& chunk = datagram.chunks[offset / CHUNK_SIZE_IN_BYTES];
+        if (chunk == NULL_INDEX) {
+            if (m_freeChunks.empty()) {
+                return false;
+            }
+            chunk = m_freeChunks.back();
+            m_freeChunks.pop_back();
+        }
+
+        const auto chunkOffset = offset % CHUNK_SIZE_IN_BYTES;
+        const auto size = std::min<std::size_t>(payload.size(), CHUNK_SIZE_IN_BYTES - chunkOffset);
+        std::memcpy(m_slab.data() + static_cast<std::size_t>(chunk) * CHUNK_SIZE_IN_BYTES + chunkOffset, payload.data(), size);
+        datagram.receivedLength += static_cast<std::uint32_t>(size);
+        offset += static_cast<std::uint32_t>(size);
+        payload = payload.subspan(size);
+    }
+    return true;
+}
+
+IpReassembler::ConstRawFrameViewType IpReassembler::buildDatagram(const Datagram& datagram) noexcept
+{
+    assert(datagram.headerLength != 0);
+    auto* const output = m_datagramBuffer.data();
+    std::memcpy(output, datagram.header.data(), datagram.headerLength);
+
+    auto* const header = reinterpret_cast<struct iphdr*>(output);
+    const auto totalLength = datagram.headerLength + datagram.totalLength;
+    header->tot_len = HostToNetwork16(static_cast<std::uint16_t>(totalLength));
+    // Only DF flag of the first fragment is kept
+    header->frag_off &= HostToNetwork16(IP_DF);
+    header->check = 0;
+    header->check = HostToNetwork16(CalcChecksum(std::span<const std::uint8_t>(output, datagram.headerLength)));
+
+    for (std::uint32_t offset = 0; offset < datagram.totalLength; offset += CHUNK_SIZE_IN_BYTES) {
+        const auto chunk = datagram.chunks[offset / CHUNK_SIZE_IN_BYTES];
+        const auto size = std::min<std::uint32_t>(CHUNK_SIZE_IN_BYTES, datagram.totalLength - offset);
+        std::memcpy(output + datagram.headerLength + offset, m_slab.data() + static_cast<std::size_t>(chunk) * CHUNK_SIZE_IN_BYTES, size);
+    }
+    return ConstRawFrameViewType(output, totalLength);
+}
+
+void IpReassembler::dropDatagram(const std::uint32_t index) noexcept
+{
+    (void)m_timerWheel.cancel(m_datagrams[index].timerId);
+    releaseDatagram(index);
+}
+
+void IpReassembler::releaseDatagram(const std::uint32_t index) noexcept
+{
+    auto& datagram = m_datagrams[index];
+    for (auto& chunk : datagram.chunks) {
+        if (chunk != NULL_INDEX) {
+            m_freeChunks.push_back(chunk);
+            chunk = NULL_INDEX;
+        }
+    }
+    datagram.timerId = TimerWheel::INVALID_TIMER_ID;
+
+    // The next datagrams of the probe sequence are shifted back into the hole, if the hole is between their home position and them
+    auto hole = static_cast<std::uint32_t>(GetHash(datagram.key)) & m_indexMask;
+    while (m_index[hole] != index) {
+        hole = (hole + 1) & m_indexMask;
+    }
+    m_index[hole] = NULL_INDEX;
+    for (auto position = (hole + 1) & m_indexMask; m_index[position] != NULL_INDEX; position = (position + 1) & m_indexMask) {
+        const auto home = static_cast<std::uint32_t>(GetHash(m_datagrams[m_index[position]].key)) & m_indexMask;
+        if (((position - home) & m_indexMask) >= ((position - hole) & m_indexMask)) {
+            m_index[hole] = m_index[position];
+            m_index[position] = NULL_INDEX;
+            hole = position;
+        }
+    }
+    m_freeDatagrams.push_back(index);
+}
+
+std::string_view OverlapPolicyToStr(const IpReassembler::OverlapPolicy policy)
+{
+    switch (policy) {
+        case IpReassembler::OverlapPolicy::Drop: return "Drop";
+        case IpReassembler::OverlapPolicy::KeepFirst: return "KeepFirst";
+        default:
+            return "Undefined";
+    }
+}
+
+} //! namespace posnet
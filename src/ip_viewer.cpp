@@ -4,7 +4,6 @@
 
 #include <sys/socket.h>
 #include <netinet/in.h>
-#include <arpa/inet.h>
 
 namespace {
 
@@ -24,158 +23,19 @@ std::string_view ProtocolToStr(const posnet::IpViewer::ProtocolType protocol)
 
 namespace posnet {
 
-IpViewer::IpViewer(EthernetViewer ethernetViewer):
-BaseFrame(reinterpret_cast<const BaseFrame::ByteType*>(ethernetViewer.getStart()), ethernetViewer.getSize()),
-m_frame(reinterpret_cast<HeaderStructType*>(
-    ethernetViewer.getFrameHeaderStart() + EthernetViewer::DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES))
-{}
-
-IpViewer::IpViewer(const RawFrameViewType rawFrame):
-BaseFrame(reinterpret_cast<const BaseFrame::ByteType*>(rawFrame.data()), DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES),
-m_frame(reinterpret_cast<HeaderStructType*>(rawFrame.data()))
-{}
-
-IpViewer::IpViewer(const ConstRawFrameViewType rawFrame):
-BaseFrame(reinterpret_cast<const BaseFrame::ByteType*>(rawFrame.data()), DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES),
-m_frame(reinterpret_cast<HeaderStructType*>(
-    const_cast<RawFrameViewType::value_type*>(rawFrame.data())))
-{}
-
-IpViewer::VersionType IpViewer::getVersion()
-{
-    return (m_frame->version == 4 ? VersionType::V4 : VersionType::V6);
-}
-
-IpViewer::ProtocolType IpViewer::getProtocol()
-{
-    switch (m_frame->protocol) {
-        case IPPROTO_ICMP: return ProtocolType::ICMP;
-        case IPPROTO_TCP: return ProtocolType::TCP;
-        case IPPROTO_UDP: return ProtocolType::UDP;
-        default:
-            return ProtocolType::Undefined;
-    }
-}
-
-std::string_view IpViewer::getProtocolAsStr()
-{
-   return ProtocolToStr(getProtocol());
-}
-
-unsigned int IpViewer::getTypeOfService()
-{
-    return m_frame->tos;
-}
-
-unsigned int IpViewer::getHeaderLengthInBytes()
-{
-    return static_cast<unsigned int>(m_frame->ihl) * 4;
-}
-
-unsigned int IpViewer::getTotalLength()
-{
-    return ntohs(m_frame->tot_len);
-}
-
-unsigned int IpViewer::getId()
-{
-    return ntohs(m_frame->id);
-}
-
-unsigned int IpViewer::getFragmentOffset()
-{
-    return (m_frame->frag_off);
-}
-
-unsigned int IpViewer::getTTL()
-{
-    return (m_frame->ttl);
-}
-
-unsigned int IpViewer::getCheckSum()
-{
-    return ntohs(m_frame->check);
-}
-
-std::string IpViewer::getSourceIpAddressAsStr()
-{
-    return posnet::utils::IpAddrToStr(m_frame->saddr);
-}
-
-std::string IpViewer::getDestIpAddressAsStr()
-{
-    return posnet::utils::IpAddrToStr(m_frame->daddr);
-}
-
-IpViewer::VersionType IpViewer::getVersion() const
-{
-    return (m_frame->version == 4 ? VersionType::V4 : VersionType::V6);
-}
-
-IpViewer::ProtocolType IpViewer::getProtocol() const
-{
-    switch (m_frame->protocol) {
-        case IPPROTO_ICMP: return ProtocolType::ICMP;
-        case IPPROTO_TCP: return ProtocolType::TCP;
-        case IPPROTO_UDP: return ProtocolType::UDP;
-        default:
-            return ProtocolType::Undefined;
-    }
-}
-
 std::string_view IpViewer::getProtocolAsStr() const
 {
     return ProtocolToStr(getProtocol());
 }
 
-unsigned int IpViewer::getTypeOfService() const
-{
-    return m_frame->tos;
-}
-
-unsigned int IpViewer::getHeaderLengthInBytes() const
-{
-    return static_cast<unsigned int>(m_frame->ihl) * 4;
-}
-
-unsigned int IpViewer::getTotalLength() const
-{
-    return ntohs(m_frame->tot_len);
-}
-
-unsigned int IpViewer::getId() const
-{
-    return ntohs(m_frame->id);
-}
-
-unsigned int IpViewer::getFragmentOffset() const
-{
-    return (m_frame->frag_off);
-}
-
-unsigned int IpViewer::getTTL() const
-{
-    return (m_frame->ttl);
-}
-
-unsigned int IpViewer::getCheckSum() const
-{
-    return ntohs(m_frame->check);
-}
-
 std::string IpViewer::getSourceIpAddressAsStr() const
 {
-    return posnet::utils::IpAddrToStr(m_frame->saddr);
+    return posnet::utils::IpAddrToStr(getHeader()->saddr);
 }
 
 std::string IpViewer::getDestIpAddressAsStr() const
 {
-    return posnet::utils::IpAddrToStr(m_frame->daddr);
-}
-
-std::uint8_t* IpViewer::getFrameHeaderStart()
-{
-    return reinterpret_cast<std::uint8_t*>(m_frame);
+    return posnet::utils::IpAddrToStr(getHeader()->daddr);
 }
 
 std::ostream& IpViewer::operator<<(std::ostream& os) const
@@ -0,0 +1,142 @@
+#include "packet-buffer/packet_buffer.h"
+#include "packet-buffer/packet_buffer_pool.h"
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace posnet {
+
+PacketBuffer::PacketBuffer(PacketBufferPool* const pool, ByteType* const start, const SizeType capacity, const SizeType headroom) noexcept:
+m_pool(pool),
+m_start(start),
+m_capacity(capacity),
+m_dataOffset(headroom),
+m_size(0)
+{}
+
+PacketBuffer::~PacketBuffer()
+{
+    release();
+}
+
+PacketBuffer::PacketBuffer(PacketBuffer&& other) noexcept:
+m_pool(std::exchange(other.m_pool, nullptr)),
+m_start(std::exchange(other.m_start, nullptr)),
+m_capacity(std::exchange(other.m_capacity, 0)),
+m_dataOffset(std::exchange(other.m_dataOffset, 0)),
+m_size(std::exchange(other.m_size, 0))
+{}
+
+PacketBuffer& PacketBuffer::operator=(PacketBuffer&& other) noexcept
+{
+    if (this != &other) {
+        release();
+        m_pool = std::exchange(other.m_pool, nullptr);
+        m_start = std::exchange(other.m_start, nullptr);
+        m_capacity = std::exchange(other.m_capacity, 0);
+        m_dataOffset = std::exchange(other.m_dataOffset, 0);
+        m_size = std::exchange(other.m_size, 0);
+    }
+    return *this;
+}
+
+PacketBuffer::RawFrameViewType PacketBuffer::prepend(const SizeType size)
+{
+    if (size > getHeadroom()) {
+        throw std::runtime_error("Could not prepend " + std::to_string(size) + " bytes to packet buffer: headroom=" +
+            std::to_string(getHeadroom()));
+    }
+
+    m_dataOffset -= size;
+    m_size += size;
+    return RawFrameViewType{ m_start + m_dataOffset, size };
+}
+
+PacketBuffer::RawFrameViewType PacketBuffer::append(const SizeType size)
+{
+    if (size > getTailroom()) {
+        throw std::runtime_error("Could not append " + std::to_string(size) + " bytes to packet buffer: tailroom=" +
+            std::to_string(getTailroom()));
+    }
+
+    const auto appended = RawFrameViewType{ m_start + m_dataOffset + m_size, size };
+    m_size += size;
+    return appended;
+}
+
+void PacketBuffer::trimFront(const SizeType size)
+{
+    if (size > m_size) {
+        throw std::runtime_error("Could not trim " + std::to_string(size) + " bytes from packet buffer: size=" + std::to_string(m_size));
+    }
+
+    m_dataOffset += size;
+    m_size -= size;
+}
+
+void PacketBuffer::trimBack(const SizeType size)
+{
+    if (size > m_size) {
+        throw std::runtime_error("Could not trim " + std::to_string(size) + " bytes from packet buffer: size=" + std::to_string(m_size));
+    }
+
+    m_size -= size;
+}
+
+void PacketBuffer::reset(const SizeType headroom)
+{
+    if (headroom > m_capacity) {
+        throw std::runtime_error("Could not reset packet buffer: headroom=" + std::to_string(headroom) +
+            " is greater than capacity=" + std::to_string(m_capacity));
+    }
+
+    m_dataOffset = headroom;
+    m_size = 0;
+}
+
+PacketBuffer::RawFrameViewType PacketBuffer::getData() noexcept
+{
+    return RawFrameViewType{ m_start + m_dataOffset, m_size };
+}
+
+PacketBuffer::ConstRawFrameViewType PacketBuffer::getData() const noexcept
+{
+    return ConstRawFrameViewType{ m_start + m_dataOffset, m_size };
+}
+
+PacketBuffer::SizeType PacketBuffer::getSize() const noexcept
+{
+    return m_size;
+}
+
+PacketBuffer::SizeType PacketBuffer::getHeadroom() const noexcept
+{
+    return m_dataOffset;
+}
+
+PacketBuffer::SizeType PacketBuffer::getTailroom() const noexcept
+{
+    return m_capacity - m_dataOffset - m_size;
+}
+
+PacketBuffer::SizeType PacketBuffer::getCapacity() const noexcept
+{
+    return m_capacity;
+}
+
+bool PacketBuffer::isValid() const noexcept
+{
+    return m_start != nullptr;
+}
+
+void PacketBuffer::release() noexcept
+{
+    if (m_pool != nullptr) {
+        m_pool->release(m_start);
+        m_pool = nullptr;
+        m_start = nullptr;
+    }
+}
+
+} //! namespace posnet
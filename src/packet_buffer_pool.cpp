@@ -0,0 +1,134 @@
+#include "packet-buffer/packet_buffer_pool.h"
+
+#include <stdexcept>
+#include <string>
+#include <new>
+
+namespace {
+
+posnet::PacketBufferPool::SizeType AlignUp(const posnet::PacketBufferPool::SizeType value, const posnet::PacketBufferPool::SizeType alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+void CheckConfiguration(const posnet::PacketBufferPool::Configuration& config)
+{
+    if (config.bufferCount == 0) {
+        throw std::runtime_error("Invalid packet buffer pool configuration: buffer count must be greater than zero");
+    }
+
+    if (config.headroomInBytes + config.tailroomInBytes == 0) {
+        throw std::runtime_error("Invalid packet buffer pool configuration: buffer size must be greater than zero");
+    }
+}
+
+} //! namespace
+
+namespace posnet {
+
+void PacketBufferPool::AlignedDeleter::operator()(ByteType* const region) const noexcept
+{
+    ::operator delete[](region, std::align_val_t{ BUFFER_ALIGNMENT_IN_BYTES });
+}
+
+PacketBufferPool::PacketBufferPool(const Configuration config):
+m_config(config),
+m_bufferSize(0),
+m_region(),
+m_freeBuffers(),
+m_frameCache(),
+m_acquiredCount(0),
+m_statistics()
+{
+    CheckConfiguration(m_config);
+    m_bufferSize = AlignUp(m_config.headroomInBytes + m_config.tailroomInBytes, BUFFER_ALIGNMENT_IN_BYTES);
+
+    const auto regionSize = static_cast<std::size_t>(m_bufferSize) * m_config.bufferCount;
+    m_region.reset(static_cast<ByteType*>(::operator new[](regionSize, std::align_val_t{ BUFFER_ALIGNMENT_IN_BYTES })));
+
+    // The first buffer is on the top of the stack
+    m_freeBuffers.reserve(m_config.bufferCount);
+    for (auto i = m_config.bufferCount; i > 0; --i) {
+        m_freeBuffers.push_back(m_region.get() + static_cast<std::size_t>(i - 1) * m_bufferSize);
+    }
+}
+
+PacketBufferPool::PacketBufferPool(const Configuration config, FramePool& framePool):
+m_config(config),
+m_bufferSize(framePool.getFrameSize()),
+m_region(),
+m_freeBuffers(),
+m_frameCache(std::make_unique<FramePool::LocalCache>(framePool)),
+m_acquiredCount(0),
+m_statistics()
+{
+    if (m_config.bufferCount == 0) {
+        throw std::runtime_error("Invalid packet buffer pool configuration: buffer count must be greater than zero");
+    }
+
+    if (m_config.headroomInBytes >= m_bufferSize) {
+        throw std::runtime_error("Invalid packet buffer pool configuration: headroom=" + std::to_string(m_config.headroomInBytes) +
+            " does not fit into frame of size=" + std::to_string(m_bufferSize));
+    }
+}
+
+std::optional<PacketBuffer> PacketBufferPool::acquire()
+{
+    ByteType* bufferStart = nullptr;
+    if (m_acquiredCount < m_config.bufferCount) {
+        if (m_frameCache) {
+            bufferStart = m_frameCache->allocate();
+        } else if (!m_freeBuffers.empty()) {
+            bufferStart = m_freeBuffers.back();
+            m_freeBuffers.pop_back();
+        }
+    }
+
+    if (bufferStart == nullptr) {
+        ++m_statistics.exhaustedCount;
+        return std::nullopt;
+    }
+
+    ++m_acquiredCount;
+    ++m_statistics.acquiredBuffers;
+    return PacketBuffer(this, bufferStart, m_bufferSize, m_config.headroomInBytes);
+}
+
+void PacketBufferPool::release(ByteType* const bufferStart) noexcept
+{
+    if (m_frameCache) {
+        m_frameCache->deallocate(bufferStart);
+    } else {
+        // The capacity is reserved for all buffers, so push_back does not allocate
+        m_freeBuffers.push_back(bufferStart);
+    }
+    --m_acquiredCount;
+    ++m_statistics.releasedBuffers;
+}
+
+PacketBufferPool::SizeType PacketBufferPool::getFreeCount() const noexcept
+{
+    return m_config.bufferCount - m_acquiredCount;
+}
+
+PacketBufferPool::SizeType PacketBufferPool::getBufferCount() const noexcept
+{
+    return m_config.bufferCount;
+}
+
+PacketBufferPool::SizeType PacketBufferPool::getBufferSize() const noexcept
+{
+    return m_bufferSize;
+}
+
+const PacketBufferPool::Configuration& PacketBufferPool::getConfiguration() const noexcept
+{
+    return m_config;
+}
+
+const PacketBufferPool::Statistics& PacketBufferPool::getStatistics() const noexcept
+{
+    return m_statistics;
+}
+
+} //! namespace posnet
@@ -0,0 +1,753 @@
+#include "packet-filter/packet_filter.h"
+
+#include "utils/system_error.h"
+#include "utils/sock_addr_convertor.h"
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <cctype>
+#include <cstring>
+
+#include <sys/socket.h>
+#include <net/ethernet.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+using namespace posnet::utils;
+
+namespace {
+
+using SizeType = posnet::PacketFilter::SizeType;
+using InstructionType = posnet::PacketFilter::InstructionType;
+using FilterError = posnet::PacketFilter::FilterError;
+
+constexpr std::uint32_t ETHER_TYPE_OFFSET = 12;
+constexpr std::uint32_t IP_HEADER_OFFSET = ETH_HLEN;
+constexpr std::uint32_t IP_FRAGMENT_OFFSET = IP_HEADER_OFFSET + 6;
+constexpr std::uint32_t IP_PROTOCOL_OFFSET = IP_HEADER_OFFSET + 9;
+constexpr std::uint32_t IP_SOURCE_ADDRESS_OFFSET = IP_HEADER_OFFSET + 12;
+constexpr std::uint32_t IP_DEST_ADDRESS_OFFSET = IP_HEADER_OFFSET + 16;
+// The offsets of the ports from the start of l4 header, the length of ip header is loaded into X register
+constexpr std::uint32_t SOURCE_PORT_OFFSET = IP_HEADER_OFFSET;
+constexpr std::uint32_t DEST_PORT_OFFSET = IP_HEADER_OFFSET + 2;
+constexpr std::uint32_t IP_FRAGMENT_OFFSET_MASK = 0x1FFF;
+constexpr std::uint32_t MAX_JUMP_OFFSET = 0xFF;
+
+/**
+ * @brief The comparison of the frame field with the constant, it is compiled to the load and the conditional jump.
+ */
+struct Comparison {
+    enum class LoadMode {
+        // The field at the fixed offset from the start of the frame
+        Absolute,
+        // The field at the offset from the start of l4 header
+        Indirect,
+        // The length of the frame
+        Length,
+    };
+
+    enum class Operation {
+        Equal,
+        Greater,
+        GreaterOrEqual,
+        // Any bit of the constant is set in the field
+        AnyBitSet,
+    };
+
+    LoadMode mode = LoadMode::Absolute;
+    std::uint32_t size = 0;
+    std::uint32_t offset = 0;
+    std::optional<std::uint32_t> mask = std::nullopt;
+    Operation operation = Operation::Equal;
+    std::uint32_t value = 0;
+};
+
+struct Node {
+    enum class Type {
+        And,
+        Or,
+        Not,
+        Compare,
+        True,
+    };
+
+    Type type = Type::True;
+    std::unique_ptr<Node> left = nullptr;
+    std::unique_ptr<Node> right = nullptr;
+    Comparison comparison;
+};
+
+using NodePtr = std::unique_ptr<Node>;
+
+NodePtr MakeNode(const Node::Type type, NodePtr left = nullptr, NodePtr right = nullptr)
+{
+    auto node = std::make_unique<Node>();
+    node->type = type;
+    node->left = std::move(left);
+    node->right = std::move(right);
+    return node;
+}
+
+NodePtr MakeComparison(const Comparison comparison)
+{
+    auto node = MakeNode(Node::Type::Compare);
+    node->comparison = comparison;
+    return node;
+}
+
+NodePtr MakeEtherTypeTest(const std::uint16_t etherType)
+{
+    return MakeComparison(Comparison{ Comparison::LoadMode::Absolute, BPF_H, ETHER_TYPE_OFFSET, std::nullopt,
+        Comparison::Operation::Equal, etherType });
+}
+
+NodePtr MakeIpProtocolTest(const std::uint8_t protocol)
+{
+    return MakeNode(Node::Type::And, MakeEtherTypeTest(ETHERTYPE_IP),
+        MakeComparison(Comparison{ Comparison::LoadMode::Absolute, BPF_B, IP_PROTOCOL_OFFSET, std::nullopt,
+            Comparison::Operation::Equal, protocol }));
+}
+
+enum class DirectionType {
+    Source,
+    Dest,
+    Any,
+};
+
+NodePtr MakeDirectional(const DirectionType direction, const std::function<NodePtr(bool isSource)>& makeTest)
+{
+    switch (direction) {
+        case DirectionType::Source: return makeTest(true);
+        case DirectionType::Dest: return makeTest(false);
+        default:
+            return MakeNode(Node::Type::Or, makeTest(true), makeTest(false));
+    }
+}
+
+NodePtr MakeNetTest(const DirectionType direction, const std::uint32_t address, const std::uint32_t mask)
+{
+    auto test = MakeDirectional(direction, [address, mask](const bool isSource) {
+        return MakeComparison(Comparison{ Comparison::LoadMode::Absolute, BPF_W,
+            isSource ? IP_SOURCE_ADDRESS_OFFSET : IP_DEST_ADDRESS_OFFSET,
+            mask == 0xFFFFFFFF ? std::nullopt : std::make_optional(mask),
+            Comparison::Operation::Equal, address & mask });
+    });
+    return MakeNode(Node::Type::And, MakeEtherTypeTest(ETHERTYPE_IP), std::move(test));
+}
+
+NodePtr MakePortTest(const DirectionType direction, const std::optional<std::uint8_t> protocol, const std::uint16_t port)
+{
+    // The ports are only in the first fragment of the datagram
+    auto notFragment = MakeNode(Node::Type::Not, MakeComparison(Comparison{ Comparison::LoadMode::Absolute, BPF_H,
+        IP_FRAGMENT_OFFSET, std::nullopt, Comparison::Operation::AnyBitSet, IP_FRAGMENT_OFFSET_MASK }));
+    auto protocolTest = protocol ? MakeIpProtocolTest(*protocol) :
+        MakeNode(Node::Type::Or, MakeIpProtocolTest(IPPROTO_TCP), MakeIpProtocolTest(IPPROTO_UDP));
+    auto portTest = MakeDirectional(direction, [port](const bool isSource) {
+        return MakeComparison(Comparison{ Comparison::LoadMode::Indirect, BPF_H,
+            isSource ? SOURCE_PORT_OFFSET : DEST_PORT_OFFSET, std::nullopt, Comparison::Operation::Equal, port });
+    });
+    return MakeNode(Node::Type::And, std::move(protocolTest),
+        MakeNode(Node::Type::And, std::move(notFragment), std::move(portTest)));
+}
+
+/**
+ * @brief The recursive descent parser of the filter expression.
+ */
+class Parser final {
+public:
+    explicit Parser(const std::string_view expression):
+    m_expression(expression),
+    m_position(0),
+    m_error(std::nullopt)
+    {}
+
+    NodePtr parse()
+    {
+        skipSpaces();
+        if (m_position == m_expression.size()) {
+            return MakeNode(Node::Type::True);
+        }
+
+        auto node = parseOr();
+        skipSpaces();
+        if (node && m_position != m_expression.size()) {
+            return setError("Unexpected token");
+        }
+        return node;
+    }
+
+    const std::optional<FilterError>& getError() const
+    {
+        return m_error;
+    }
+
+private:
+    NodePtr parseOr()
+    {
+        auto node = parseAnd();
+        while (node && (acceptWord("or") || acceptSymbol("||"))) {
+            auto right = parseAnd();
+            if (!right) {
+                return nullptr;
+            }
+            node = MakeNode(Node::Type::Or, std::move(node), std::move(right));
+        }
+        return node;
+    }
+
+    NodePtr parseAnd()
+    {
+        auto node = parseNot();
+        while (node && (acceptWord("and") || acceptSymbol("&&"))) {
+            auto right = parseNot();
+            if (!right) {
+                return nullptr;
+            }
+            node = MakeNode(Node::Type::And, std::move(node), std::move(right));
+        }
+        return node;
+    }
+
+    NodePtr parseNot()
+    {
+        if (acceptWord("not") || acceptSymbol("!")) {
+            auto node = parseNot();
+            return node ? MakeNode(Node::Type::Not, std::move(node)) : nullptr;
+        }
+
+        if (acceptSymbol("(")) {
+            auto node = parseOr();
+            if (node && !acceptSymbol(")")) {
+                return setError("Expected ')'");
+            }
+            return node;
+        }
+        return parsePrimitive();
+    }
+
+    NodePtr parsePrimitive()
+    {
+        const auto direction = parseDirection();
+        if (direction != DirectionType::Any) {
+            return parseQualified(direction, std::nullopt);
+        }
+
+        if (acceptWord("ip")) {
+            if (acceptWord("proto")) {
+                const auto protocol = parseNumber(0xFF);
+                return protocol ? MakeIpProtocolTest(*protocol) : nullptr;
+            }
+            return MakeEtherTypeTest(ETHERTYPE_IP);
+        } else if (acceptWord("ether")) {
+            if (!acceptWord("proto")) {
+                return setError("Expected 'proto'");
+            }
+            const auto etherType = parseNumber(0xFFFF);
+            return etherType ? MakeEtherTypeTest(*etherType) : nullptr;
+        } else if (acceptWord("arp")) {
+            return MakeEtherTypeTest(ETHERTYPE_ARP);
+        } else if (acceptWord("rarp")) {
+            return MakeEtherTypeTest(ETHERTYPE_REVARP);
+        } else if (acceptWord("icmp")) {
+            return MakeIpProtocolTest(IPPROTO_ICMP);
+        } else if (acceptWord("tcp")) {
+            return parseTransport(IPPROTO_TCP);
+        } else if (acceptWord("udp")) {
+            return parseTransport(IPPROTO_UDP);
+        } else if (acceptWord("greater")) {
+            const auto length = parseNumber(0xFFFFFFFF);
+            return length ? MakeComparison(Comparison{ Comparison::LoadMode::Length, BPF_W, 0, std::nullopt,
+                Comparison::Operation::GreaterOrEqual, *length }) : nullptr;
+        } else if (acceptWord("less")) {
+            const auto length = parseNumber(0xFFFFFFFF);
+            return length ? MakeNode(Node::Type::Not, MakeComparison(Comparison{ Comparison::LoadMode::Length, BPF_W, 0,
+                std::nullopt, Comparison::Operation::Greater, *length })) : nullptr;
+        }
+        return parseQualified(DirectionType::Any, std::nullopt);
+    }
+
+    // tcp, udp, tcp port N, udp src port N, ...
+    NodePtr parseTransport(const std::uint8_t protocol)
+    {
+        const auto position = m_position;
+        const auto direction = parseDirection();
+        if (direction != DirectionType::Any || peekWord("port")) {
+            return parseQualified(direction, protocol);
+        }
+        m_position = position;
+        return MakeIpProtocolTest(protocol);
+    }
+
+    // host A.B.C.D, net A.B.C.D/LEN, port N(the direction is already parsed)
+    NodePtr parseQualified(const DirectionType direction, const std::optional<std::uint8_t> protocol)
+    {
+        if (acceptWord("port")) {
+            const auto port = parseNumber(0xFFFF);
+            return port ? MakePortTest(direction, protocol, *port) : nullptr;
+        }
+
+        if (protocol) {
+            return setError("Expected 'port'");
+        }
+
+        if (acceptWord("host")) {
+            const auto address = parseAddress();
+            return address ? MakeNetTest(direction, *address, 0xFFFFFFFF) : nullptr;
+        } else if (acceptWord("net")) {
+            const auto address = parseAddress();
+            if (!address || !acceptSymbol("/")) {
+                return address ? setError("Expected '/'") : nullptr;
+            }
+
+            const auto prefixLength = parseNumber(32);
+            if (!prefixLength) {
+                return nullptr;
+            }
+            const auto mask = *prefixLength == 0 ? 0 : 0xFFFFFFFF << (32 - *prefixLength);
+            return MakeNetTest(direction, *address, mask);
+        }
+        return setError("Unknown primitive");
+    }
+
+    DirectionType parseDirection()
+    {
+        if (acceptWord("src")) {
+            return DirectionType::Source;
+        } else if (acceptWord("dst")) {
+            return DirectionType::Dest;
+        }
+        return DirectionType::Any;
+    }
+
+    std::optional<std::uint32_t> parseNumber(const std::uint32_t maxValue)
+    {
+        skipSpaces();
+        const auto start = m_position;
+        while (m_position < m_expression.size() &&
+            (std::isxdigit(m_expression[m_position]) || m_expression[m_position] == 'x')) {
+            ++m_position;
+        }
+
+        const std::string token(m_expression.substr(start, m_position - start));
+        try {
+            std::size_t parsedSize = 0;
+            const auto value = std::stoul(token, &parsedSize, 0);
+            if (parsedSize == token.size() && value <= maxValue) {
+                return static_cast<std::uint32_t>(value);
+            }
+        } catch (const std::exception&) {
+        }
+        m_position = start;
+        setError("Invalid number, expected value in range [0, " + std::to_string(maxValue) + "]");
+        return std::nullopt;
+    }
+
+    // The address is returned in host byte order
+    std::optional<std::uint32_t> parseAddress()
+    {
+        skipSpaces();
+        const auto start = m_position;
+        while (m_position < m_expression.size() && (std::isdigit(m_expression[m_position]) || m_expression[m_position] == '.')) {
+            ++m_position;
+        }
+
+        // StrToIpAddr expects the null-terminated string
+        const std::string token(m_expression.substr(start, m_position - start));
+        const auto address = StrToIpAddr(token);
+        if (!address) {
+            m_position = start;
+            setError("Invalid ip-address");
+            return std::nullopt;
+        }
+        return ntohl(*address);
+    }
+
+    bool peekWord(const std::string_view word)
+    {
+        const auto position = m_position;
+        const auto result = acceptWord(word);
+        m_position = position;
+        return result;
+    }
+
+    bool acceptWord(const std::string_view word)
+    {
+        skipSpaces();
+        if (m_expression.substr(m_position, word.size()) != word) {
+            return false;
+        }
+
+        const auto end = m_position + word.size();
+        if (end < m_expression.size() && std::isalnum(m_expression[end])) {
+            return false;
+        }
+        m_position = end;
+        return true;
+    }
+
+    bool acceptSymbol(const std::string_view symbol)
+    {
+        skipSpaces();
+        if (m_expression.substr(m_position, symbol.size()) != symbol) {
+            return false;
+        }
+        m_position += symbol.size();
+        return true;
+    }
+
+    void skipSpaces()
+    {
+        while (m_position < m_expression.size() && std::isspace(m_expression[m_position])) {
+            ++m_position;
+        }
+    }
+
+    NodePtr setError(std::string message)
+    {
+        if (!m_error) {
+            m_error = FilterError{ std::move(message), static_cast<SizeType>(m_position) };
+        }
+        return nullptr;
+    }
+
+    std::string_view m_expression;
+    std::size_t m_position;
+    std::optional<FilterError> m_error;
+};
+
+/**
+ * @brief Generates the bytecode from the tree. The jumps are emitted to the labels, which are resolved at the end,
+ * because classic BPF has only forward jumps with 8-bit offsets.
+ */
+class CodeGenerator final {
+public:
+    std::optional<std::vector<InstructionType>> generate(const Node& root)
+    {
+        const auto acceptLabel = makeLabel();
+        const auto rejectLabel = makeLabel();
+        generate(root, acceptLabel, rejectLabel);
+
+        placeLabel(acceptLabel);
+        m_code.push_back(BPF_STMT(BPF_RET | BPF_K, posnet::PacketFilter::ACCEPT_LENGTH));
+        placeLabel(rejectLabel);
+        m_code.push_back(BPF_STMT(BPF_RET | BPF_K, 0));
+
+        for (const auto& fixup : m_fixups) {
+            auto& instruction = m_code[fixup.index];
+            const auto trueOffset = m_labels[fixup.trueLabel] - fixup.index - 1;
+            const auto falseOffset = m_labels[fixup.falseLabel] - fixup.index - 1;
+            if (BPF_OP(instruction.code) == BPF_JA) {
+                instruction.k = trueOffset;
+                continue;
+            }
+
+            if (trueOffset > MAX_JUMP_OFFSET || falseOffset > MAX_JUMP_OFFSET) {
+                return std::nullopt;
+            }
+            instruction.jt = static_cast<std::uint8_t>(trueOffset);
+            instruction.jf = static_cast<std::uint8_t>(falseOffset);
+        }
+        return std::move(m_code);
+    }
+
+private:
+    struct Fixup {
+        std::size_t index;
+        std::size_t trueLabel;
+        std::size_t falseLabel;
+    };
+
+    void generate(const Node& node, const std::size_t trueLabel, const std::size_t falseLabel)
+    {
+        switch (node.type) {
+            case Node::Type::And: {
+                const auto rightLabel = makeLabel();
+                generate(*node.left, rightLabel, falseLabel);
+                placeLabel(rightLabel);
+                generate(*node.right, trueLabel, falseLabel);
+                break;
+            }
+            case Node::Type::Or: {
+                const auto rightLabel = makeLabel();
+                generate(*node.left, trueLabel, rightLabel);
+                placeLabel(rightLabel);
+                generate(*node.right, trueLabel, falseLabel);
+                break;
+            }
+            case Node::Type::Not: {
+                generate(*node.left, falseLabel, trueLabel);
+                break;
+            }
+            case Node::Type::Compare: {
+                generateComparison(node.comparison, trueLabel, falseLabel);
+                break;
+            }
+            case Node::Type::True: {
+                m_fixups.push_back(Fixup{ m_code.size(), trueLabel, trueLabel });
+                m_code.push_back(BPF_STMT(BPF_JMP | BPF_JA, 0));
+                break;
+            }
+        }
+    }
+
+    void generateComparison(const Comparison& comparison, const std::size_t trueLabel, const std::size_t falseLabel)
+    {
+        switch (comparison.mode) {
+            case Comparison::LoadMode::Absolute: {
+                m_code.push_back(BPF_STMT(BPF_LD | comparison.size | BPF_ABS, comparison.offset));
+                break;
+            }
+            case Comparison::LoadMode::Indirect: {
+                // X = 4 * (ip[0] & 0x0F), it is the length of ip header
+                m_code.push_back(BPF_STMT(BPF_LDX | BPF_B | BPF_MSH, IP_HEADER_OFFSET));
+                m_code.push_back(BPF_STMT(BPF_LD | comparison.size | BPF_IND, comparison.offset));
+                break;
+            }
+            case Comparison::LoadMode::Length: {
+                m_code.push_back(BPF_STMT(BPF_LD | BPF_W | BPF_LEN, 0));
+                break;
+            }
+        }
+
+        if (comparison.mask) {
+            m_code.push_back(BPF_STMT(BPF_ALU | BPF_AND | BPF_K, *comparison.mask));
+        }
+
+        std::uint16_t operation = BPF_JEQ;
+        switch (comparison.operation) {
+            case Comparison::Operation::Equal: operation = BPF_JEQ; break;
+            case Comparison::Operation::Greater: operation = BPF_JGT; break;
+            case Comparison::Operation::GreaterOrEqual: operation = BPF_JGE; break;
+            case Comparison::Operation::AnyBitSet: operation = BPF_JSET; break;
+        }
+        m_fixups.push_back(Fixup{ m_code.size(), trueLabel, falseLabel });
+        m_code.push_back(BPF_JUMP(BPF_JMP | operation | BPF_K, comparison.value, 0, 0));
+    }
+
+    std::size_t makeLabel()
+    {
+        m_labels.push_back(0);
+        return m_labels.size() - 1;
+    }
+
+    void placeLabel(const std::size_t label)
+    {
+        m_labels[label] = m_code.size();
+    }
+
+    std::vector<InstructionType> m_code;
+    std::vector<std::size_t> m_labels;
+    std::vector<Fixup> m_fixups;
+};
+
+std::optional<std::uint32_t> Load(const posnet::PacketFilter::ConstRawFrameViewType frame, const std::uint32_t offset, const std::uint16_t size)
+{
+    const std::uint32_t length = size == BPF_W ? 4 : (size == BPF_H ? 2 : 1);
+    if (offset > frame.size() || frame.size() - offset < length) {
+        return std::nullopt;
+    }
+
+    const auto data = frame.data() + offset;
+    switch (length) {
+        case 4: return (static_cast<std::uint32_t>(data[0]) << 24) | (data[1] << 16) | (data[2] << 8) | data[3];
+        case 2: return (data[0] << 8) | data[1];
+        default:
+            return data[0];
+    }
+}
+
+} //! namespace
+
+namespace posnet {
+
+PacketFilter::PacketFilter(std::string expression, std::vector<InstructionType> program):
+m_expression(std::move(expression)),
+m_program(std::move(program))
+{}
+
+PacketFilter::CompileResultType PacketFilter::Compile(const std::string_view expression)
+{
+    Parser parser(expression);
+    const auto root = parser.parse();
+    if (!root) {
+        return CompileResultType::onError(*parser.getError());
+    }
+
+    auto program = CodeGenerator().generate(*root);
+    if (!program) {
+        return CompileResultType::onError(FilterError{ "The expression is too complex, the jump offset exceeds 255 instructions", 0 });
+    }
+
+    if (program->size() > BPF_MAXINSNS) {
+        return CompileResultType::onError(FilterError{ "The expression is too complex, the program exceeds " +
+            std::to_string(BPF_MAXINSNS) + " instructions", 0 });
+    }
+    return CompileResultType::onOk(PacketFilter(std::string(expression), std::move(*program)));
+}
+
+void PacketFilter::attachTo(const int socket) const
+{
+    struct sock_fprog program;
+    std::memset(&program, 0, sizeof(program));
+    program.len = static_cast<unsigned short>(m_program.size());
+    program.filter = const_cast<InstructionType*>(m_program.data());
+    if (setsockopt(socket, SOL_SOCKET, SO_ATTACH_FILTER, &program, sizeof(program)) < 0) {
+        throw std::runtime_error("Could not attach filter=\"" + m_expression + "\" to socket: " + GetLastSysError());
+    }
+}
+
+void PacketFilter::DetachFrom(const int socket)
+{
+    const int unused = 0;
+    if (setsockopt(socket, SOL_SOCKET, SO_DETACH_FILTER, &unused, sizeof(unused)) < 0) {
+        throw std::runtime_error("Could not detach filter from socket: " + GetLastSysError());
+    }
+}
+
+PacketFilter::SizeType PacketFilter::run(const ConstRawFrameViewType frame) const
+{
+    return RunBpfProgram(m_program, frame);
+}
+
+bool PacketFilter::match(const ConstRawFrameViewType frame) const
+{
+    return run(frame) != 0;
+}
+
+std::span<const PacketFilter::InstructionType> PacketFilter::getProgram() const
+{
+    return m_program;
+}
+
+const std::string& PacketFilter::getExpression() const
+{
+    return m_expression;
+}
+
+PacketFilter::SizeType RunBpfProgram(const std::span<const PacketFilter::InstructionType> program, const PacketFilter::ConstRawFrameViewType frame)
+{
+    std::uint32_t a = 0;
+    std::uint32_t x = 0;
+    std::uint32_t memory[BPF_MEMWORDS] = {};
+    for (std::size_t pc = 0; pc < program.size(); ++pc) {
+        const auto& instruction = program[pc];
+        const auto k = instruction.k;
+        switch (BPF_CLASS(instruction.code)) {
+            case BPF_LD:
+            case BPF_LDX: {
+                const auto isX = BPF_CLASS(instruction.code) == BPF_LDX;
+                std::uint32_t value = 0;
+                switch (BPF_MODE(instruction.code)) {
+                    case BPF_ABS:
+                    case BPF_IND: {
+                        const auto offset = BPF_MODE(instruction.code) == BPF_IND ? x + k : k;
+                        const auto loaded = Load(frame, offset, BPF_SIZE(instruction.code));
+                        if (!loaded) {
+                            return 0;
+                        }
+                        value = *loaded;
+                        break;
+                    }
+                    case BPF_MSH: {
+                        const auto loaded = Load(frame, k, BPF_B);
+                        if (!loaded) {
+                            return 0;
+                        }
+                        value = (*loaded & 0x0F) * 4;
+                        break;
+                    }
+                    case BPF_LEN: value = frame.size(); break;
+                    case BPF_IMM: value = k; break;
+                    case BPF_MEM: {
+                        if (k >= BPF_MEMWORDS) {
+                            return 0;
+                        }
+                        value = memory[k];
+                        break;
+                    }
+                    default:
+                        return 0;
+                }
+                (isX ? x : a) = value;
+                break;
+            }
+            case BPF_ST:
+            case BPF_STX: {
+                if (k >= BPF_MEMWORDS) {
+                    return 0;
+                }
+                memory[k] = BPF_CLASS(instruction.code) == BPF_ST ? a : x;
+                break;
+            }
+            case BPF_ALU: {
+                const auto operand = BPF_SRC(instruction.code) == BPF_X ? x : k;
+                switch (BPF_OP(instruction.code)) {
+                    case BPF_ADD: a += operand; break;
+                    case BPF_SUB: a -= operand; break;
+                    case BPF_MUL: a *= operand; break;
+                    case BPF_DIV: {
+                        if (operand == 0) {
+                            return 0;
+                        }
+                        a /= operand;
+                        break;
+                    }
+                    case BPF_MOD: {
+                        if (operand == 0) {
+                            return 0;
+                        }
+                        a %= operand;
+                        break;
+                    }
+                    case BPF_AND: a &= operand; break;
+                    case BPF_OR: a |= operand; break;
+                    case BPF_XOR: a ^= operand; break;
+                    case BPF_LSH: a = operand < 32 ? a << operand : 0; break;
+                    case BPF_RSH: a = operand < 32 ? a >> operand : 0; break;
+                    case BPF_NEG: a = -a; break;
+                    default:
+                        return 0;
+                }
+                break;
+            }
+            case BPF_JMP: {
+                const auto operand = BPF_SRC(instruction.code) == BPF_X ? x : k;
+                bool condition = false;
+                switch (BPF_OP(instruction.code)) {
+                    case BPF_JA: {
+                        pc += k;
+                        continue;
+                    }
+                    case BPF_JEQ: condition = (a == operand); break;
+                    case BPF_JGT: condition = (a > operand); break;
+                    case BPF_JGE: condition = (a >= operand); break;
+                    case BPF_JSET: condition = (a & operand) != 0; break;
+                    default:
+                        return 0;
+                }
+                pc += condition ? instruction.jt : instruction.jf;
+                break;
+            }
+            case BPF_RET: {
+                const auto value = BPF_RVAL(instruction.code) == BPF_A ? a : k;
+                return std::min<std::uint32_t>(value, frame.size());
+            }
+            case BPF_MISC: {
+                if (BPF_MISCOP(instruction.code) == BPF_TAX) {
+                    x = a;
+                } else {
+                    a = x;
+                }
+                break;
+            }
+            default:
+                return 0;
+        }
+    }
+    return 0;
+}
+
+} //! namespace posnet
@@ -0,0 +1,211 @@
+#include "net-io/packet_rx_ring.h"
+
+#include "utils/system_error.h"
+
+#include <stdexcept>
+#include <string>
+#include <cstring>
+#include <cerrno>
+#include <cassert>
+
+#include <unistd.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <net/if.h>
+#include <net/ethernet.h>
+#include <arpa/inet.h>
+
+using namespace posnet::utils;
+
+namespace {
+
+void CheckConfiguration(const posnet::PacketRxRing::Configuration& config)
+{
+    const auto pageSize = static_cast<unsigned int>(sysconf(_SC_PAGESIZE));
+    if (config.blockCount == 0) {
+        throw std::runtime_error("Invalid rx ring configuration: block count must be greater than zero");
+    }
+
+    if (config.blockSizeInBytes == 0 || config.blockSizeInBytes % pageSize != 0) {
+        throw std::runtime_error("Invalid rx ring configuration: block size=" + std::to_string(config.blockSizeInBytes) +
+            " must be a multiple of page size=" + std::to_string(pageSize));
+    }
+
+    if (config.frameSizeInBytes < TPACKET3_HDRLEN || config.frameSizeInBytes % TPACKET_ALIGNMENT != 0 ||
+        config.frameSizeInBytes > config.blockSizeInBytes) {
+        throw std::runtime_error("Invalid rx ring configuration: frame size=" + std::to_string(config.frameSizeInBytes));
+    }
+}
+
+void SetUpRing(const int socket, const posnet::PacketRxRing::Configuration& config)
+{
+    const int version = TPACKET_V3;
+    if (setsockopt(socket, SOL_PACKET, PACKET_VERSION, &version, sizeof(version)) < 0) {
+        throw std::runtime_error("Could not set TPACKET_V3 version of packet socket: " + GetLastSysError());
+    }
+
+    struct tpacket_req3 req;
+    std::memset(&req, 0, sizeof(req));
+    req.tp_block_size = config.blockSizeInBytes;
+    req.tp_block_nr = config.blockCount;
+    req.tp_frame_size = config.frameSizeInBytes;
+    req.tp_frame_nr = (config.blockSizeInBytes / config.frameSizeInBytes) * config.blockCount;
+    req.tp_retire_blk_tov = config.blockTimeoutInMs;
+    req.tp_feature_req_word = TP_FT_REQ_FILL_RXHASH;
+    if (setsockopt(socket, SOL_PACKET, PACKET_RX_RING, &req, sizeof(req)) < 0) {
+        throw std::runtime_error("Could not set up PACKET_RX_RING: " + GetLastSysError());
+    }
+}
+
+void BindToIFace(const int socket, const std::string_view ifaceName)
+{
+    const std::string name(ifaceName);
+    const auto index = if_nametoindex(name.c_str());
+    if (index == 0) {
+        throw std::runtime_error("Could not get index of iface=" + name + ": " + GetLastSysError());
+    }
+
+    struct sockaddr_ll addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sll_family = AF_PACKET;
+    addr.sll_protocol = htons(ETH_P_ALL);
+    addr.sll_ifindex = static_cast<int>(index);
+    if (bind(socket, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) < 0) {
+        throw std::runtime_error("Could not bind packet socket to iface=" + name + ": " + GetLastSysError());
+    }
+}
+
+int FanoutModeToType(const posnet::PacketRxRing::FanoutMode mode)
+{
+    using FanoutMode = posnet::PacketRxRing::FanoutMode;
+    switch (mode) {
+        case FanoutMode::Hash: return PACKET_FANOUT_HASH | PACKET_FANOUT_FLAG_DEFRAG;
+        case FanoutMode::Cpu: return PACKET_FANOUT_CPU;
+        case FanoutMode::RoundRobin: return PACKET_FANOUT_LB;
+        default:
+            throw std::runtime_error("Undefined fanout mode=" + std::to_string(static_cast<unsigned int>(mode)));
+    }
+}
+
+} //! namespace
+
+namespace posnet {
+
+PacketRxRing::Block::Block(struct tpacket_block_desc* const desc):
+m_desc(desc)
+{}
+
+PacketRxRing::PacketRxRing(const std::string_view ifaceName):
+PacketRxRing(ifaceName, Configuration{})
+{}
+
+PacketRxRing::PacketRxRing(const std::string_view ifaceName, const Configuration config):
+m_config(config),
+m_socket(-1),
+m_ring(nullptr),
+m_ringSize(static_cast<std::size_t>(config.blockSizeInBytes) * config.blockCount),
+m_currentBlock(0),
+m_statistics()
+{
+    CheckConfiguration(m_config);
+
+    m_socket = socket(AF_PACKET, SOCK_RAW, htons(ETH_P_ALL));
+    if (m_socket < 0) {
+        throw std::runtime_error("Could not open packet socket: " + GetLastSysError());
+    }
+
+    try {
+        SetUpRing(m_socket, m_config);
+
+        void* const ring = mmap(nullptr, m_ringSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_socket, 0);
+        if (ring == MAP_FAILED) {
+            throw std::runtime_error("Could not map PACKET_RX_RING: " + GetLastSysError());
+        }
+        m_ring = static_cast<ByteType*>(ring);
+
+        if (!ifaceName.empty()) {
+            BindToIFace(m_socket, ifaceName);
+        }
+    } catch (...) {
+        if (m_ring != nullptr) {
+            (void)munmap(m_ring, m_ringSize);
+        }
+        (void)close(m_socket);
+        throw;
+    }
+}
+
+PacketRxRing::~PacketRxRing()
+{
+    (void)munmap(m_ring, m_ringSize);
+    (void)close(m_socket);
+}
+
+std::optional<PacketRxRing::Block> PacketRxRing::nextBlock(const int timeoutInMs)
+{
+    const auto desc = getBlockDesc(m_currentBlock);
+    if ((__atomic_load_n(&desc->hdr.bh1.block_status, __ATOMIC_ACQUIRE) & TP_STATUS_USER) == 0) {
+        struct pollfd pfd;
+        std::memset(&pfd, 0, sizeof(pfd));
+        pfd.fd = m_socket;
+        pfd.events = POLLIN | POLLERR;
+        if (poll(&pfd, 1, timeoutInMs) < 0 && errno != EINTR) {
+            throw std::runtime_error("Could not poll packet socket: " + GetLastSysError());
+        }
+
+        if ((__atomic_load_n(&desc->hdr.bh1.block_status, __ATOMIC_ACQUIRE) & TP_STATUS_USER) == 0) {
+            return std::nullopt;
+        }
+    }
+
+    return Block(desc);
+}
+
+void PacketRxRing::releaseBlock(const Block block)
+{
+    assert(block.m_desc == getBlockDesc(m_currentBlock));
+    __atomic_store_n(&block.m_desc->hdr.bh1.block_status, TP_STATUS_KERNEL, __ATOMIC_RELEASE);
+    m_currentBlock = (m_currentBlock + 1) % m_config.blockCount;
+}
+
+void PacketRxRing::joinFanoutGroup(const std::uint16_t groupId, const FanoutMode mode)
+{
+    const int fanoutArg = groupId | (FanoutModeToType(mode) << 16);
+    if (setsockopt(m_socket, SOL_PACKET, PACKET_FANOUT, &fanoutArg, sizeof(fanoutArg)) < 0) {
+        throw std::runtime_error("Could not join fanout group=" + std::to_string(groupId) + ": " + GetLastSysError());
+    }
+}
+
+PacketRxRing::Statistics PacketRxRing::getStatistics()
+{
+    // The kernel resets its counters on every read, so they are accumulated here
+    struct tpacket_stats_v3 stats;
+    socklen_t statsSize = sizeof(stats);
+    std::memset(&stats, 0, sizeof(stats));
+    if (getsockopt(m_socket, SOL_PACKET, PACKET_STATISTICS, &stats, &statsSize) < 0) {
+        throw std::runtime_error("Could not get statistics of packet socket: " + GetLastSysError());
+    }
+
+    m_statistics.receivedFrames += stats.tp_packets;
+    m_statistics.droppedFrames += stats.tp_drops;
+    m_statistics.freezeQueueCount += stats.tp_freeze_q_cnt;
+    return m_statistics;
+}
+
+const PacketRxRing::Configuration& PacketRxRing::getConfiguration() const
+{
+    return m_config;
+}
+
+int PacketRxRing::getSocket() const
+{
+    return m_socket;
+}
+
+struct tpacket_block_desc* PacketRxRing::getBlockDesc(const SizeType index) const
+{
+    return reinterpret_cast<struct tpacket_block_desc*>(m_ring + static_cast<std::size_t>(index) * m_config.blockSizeInBytes);
+}
+
+} //! namespace posnet
@@ -0,0 +1,323 @@
+#include "net-io/packet_tx_ring.h"
+
+#include "utils/system_error.h"
+
+#include <stdexcept>
+#include <string>
+#include <cstring>
+#include <cerrno>
+#include <cassert>
+
+#include <unistd.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <net/if.h>
+#include <net/ethernet.h>
+#include <arpa/inet.h>
+
+using namespace posnet::utils;
+
+namespace {
+
+// The kernel expects the frame data right after the aligned tpacket2_hdr if PACKET_TX_HAS_OFF is not set
+constexpr auto FRAME_DATA_OFFSET = TPACKET2_HDRLEN - sizeof(struct sockaddr_ll);
+
+posnet::PacketTxRing::SizeType CalcBlockSize(const posnet::PacketTxRing::SizeType frameSize)
+{
+    const auto pageSize = static_cast<posnet::PacketTxRing::SizeType>(sysconf(_SC_PAGESIZE));
+    return (frameSize + pageSize - 1) / pageSize * pageSize;
+}
+
+void CheckConfiguration(const posnet::PacketTxRing::Configuration& config)
+{
+    if (config.frameCount == 0) {
+        throw std::runtime_error("Invalid tx ring configuration: frame count must be greater than zero");
+    }
+
+    if (config.frameSizeInBytes <= FRAME_DATA_OFFSET || config.frameSizeInBytes % TPACKET_ALIGNMENT != 0) {
+        throw std::runtime_error("Invalid tx ring configuration: frame size=" + std::to_string(config.frameSizeInBytes));
+    }
+}
+
+void SetUpRing(const int socket, const posnet::PacketTxRing::Configuration& config, const posnet::PacketTxRing::SizeType blockSize)
+{
+    const int version = TPACKET_V2;
+    if (setsockopt(socket, SOL_PACKET, PACKET_VERSION, &version, sizeof(version)) < 0) {
+        throw std::runtime_error("Could not set TPACKET_V2 version of packet socket: " + GetLastSysError());
+    }
+
+    if (config.bypassQdisc) {
+        const int one = 1;
+        if (setsockopt(socket, SOL_PACKET, PACKET_QDISC_BYPASS, &one, sizeof(one)) < 0) {
+            throw std::runtime_error("Could not enable PACKET_QDISC_BYPASS: " + GetLastSysError());
+        }
+    }
+
+    struct tpacket_req req;
+    std::memset(&req, 0, sizeof(req));
+    req.tp_block_size = blockSize;
+    req.tp_frame_size = config.frameSizeInBytes;
+    req.tp_block_nr = config.frameCount / (blockSize / config.frameSizeInBytes);
+    req.tp_frame_nr = config.frameCount;
+    if (setsockopt(socket, SOL_PACKET, PACKET_TX_RING, &req, sizeof(req)) < 0) {
+        throw std::runtime_error("Could not set up PACKET_TX_RING: " + GetLastSysError());
+    }
+}
+
+void BindToIFace(const int socket, const std::string_view ifaceName)
+{
+    const std::string name(ifaceName);
+    const auto index = if_nametoindex(name.c_str());
+    if (index == 0) {
+        throw std::runtime_error("Could not get index of iface=" + name + ": " + GetLastSysError());
+    }
+
+    struct sockaddr_ll addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sll_family = AF_PACKET;
+    addr.sll_protocol = htons(ETH_P_ALL);
+    addr.sll_ifindex = static_cast<int>(index);
+    if (bind(socket, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) < 0) {
+        throw std::runtime_error("Could not bind packet socket to iface=" + name + ": " + GetLastSysError());
+    }
+}
+
+} //! namespace
+
+namespace posnet {
+
+PacketTxRing::Slot::Slot(struct tpacket2_hdr* const header, ByteType* const data, const SizeType capacity):
+m_header(header),
+m_data(data),
+m_size(0),
+m_capacity(capacity)
+{}
+
+PacketTxRing::Slot& PacketTxRing::Slot::append(const BaseFrame& frame)
+{
+    return append(frame.getAsRawFrameView());
+}
+
+PacketTxRing::Slot& PacketTxRing::Slot::append(const ConstRawFrameViewType data)
+{
+    const auto buffer = reserve(data.size());
+    std::memcpy(buffer.data(), data.data(), data.size());
+    return *this;
+}
+
+PacketTxRing::RawFrameViewType PacketTxRing::Slot::reserve(const SizeType size)
+{
+    if (m_size + size > m_capacity) {
+        throw std::runtime_error("Attempt to write " + std::to_string(size) + " bytes to tx ring slot, which has only " +
+            std::to_string(m_capacity - m_size) + " free bytes");
+    }
+
+    const auto buffer = RawFrameViewType{ m_data + m_size, size };
+    m_size += size;
+    return buffer;
+}
+
+PacketTxRing::RawFrameViewType PacketTxRing::Slot::getData() const
+{
+    return RawFrameViewType{ m_data, m_size };
+}
+
+PacketTxRing::SizeType PacketTxRing::Slot::getSize() const
+{
+    return m_size;
+}
+
+PacketTxRing::SizeType PacketTxRing::Slot::getCapacity() const
+{
+    return m_capacity;
+}
+
+PacketTxRing::PacketTxRing(const std::string_view ifaceName):
+PacketTxRing(ifaceName, Configuration{})
+{}
+
+PacketTxRing::PacketTxRing(const std::string_view ifaceName, const Configuration config):
+m_config(config),
+m_blockSize(CalcBlockSize(config.frameSizeInBytes)),
+m_socket(-1),
+m_ring(nullptr),
+m_ringSize(0),
+m_currentFrame(0),
+m_pendingFrames(0),
+m_oldestFrame(0),
+m_inFlightFrames(0),
+m_statistics()
+{
+    CheckConfiguration(m_config);
+
+    // The frame count is rounded up to fill the last block
+    const auto framesPerBlock = m_blockSize / m_config.frameSizeInBytes;
+    m_config.frameCount = (m_config.frameCount + framesPerBlock - 1) / framesPerBlock * framesPerBlock;
+    m_ringSize = static_cast<std::size_t>(m_config.frameCount / framesPerBlock) * m_blockSize;
+
+    m_socket = socket(AF_PACKET, SOCK_RAW, htons(ETH_P_ALL));
+    if (m_socket < 0) {
+        throw std::runtime_error("Could not open packet socket: " + GetLastSysError());
+    }
+
+    try {
+        SetUpRing(m_socket, m_config, m_blockSize);
+
+        void* const ring = mmap(nullptr, m_ringSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_socket, 0);
+        if (ring == MAP_FAILED) {
+            throw std::runtime_error("Could not map PACKET_TX_RING: " + GetLastSysError());
+        }
+        m_ring = static_cast<ByteType*>(ring);
+
+        BindToIFace(m_socket, ifaceName);
+    } catch (...) {
+        if (m_ring != nullptr) {
+            (void)munmap(m_ring, m_ringSize);
+        }
+        (void)close(m_socket);
+        throw;
+    }
+}
+
+PacketTxRing::~PacketTxRing()
+{
+    (void)munmap(m_ring, m_ringSize);
+    (void)close(m_socket);
+}
+
+std::optional<PacketTxRing::Slot> PacketTxRing::acquireSlot(const int timeoutInMs)
+{
+    const auto header = getFrameHeader(m_currentFrame);
+    auto status = __atomic_load_n(&header->tp_status, __ATOMIC_ACQUIRE);
+    if (status != TP_STATUS_AVAILABLE) {
+        // The slot may be already transmitted or rejected, it is returned to the ring before the kernel is waited for
+        reclaimFrames();
+        status = __atomic_load_n(&header->tp_status, __ATOMIC_ACQUIRE);
+    }
+
+    if (status != TP_STATUS_AVAILABLE && timeoutInMs != NO_TIMEOUT) {
+        // The ring is full, the kernel has to transmit the frames before the slot becomes free.
+        // The slot, which is still requested, was not taken by the previous send(e.g. EAGAIN), so the kernel is kicked again
+        if (m_pendingFrames != 0 || status == TP_STATUS_SEND_REQUEST) {
+            (void)kick(false);
+        }
+
+        struct pollfd pfd;
+        std::memset(&pfd, 0, sizeof(pfd));
+        pfd.fd = m_socket;
+        pfd.events = POLLOUT | POLLERR;
+        if (poll(&pfd, 1, timeoutInMs) < 0 && errno != EINTR) {
+            throw std::runtime_error("Could not poll packet socket: " + GetLastSysError());
+        }
+        status = __atomic_load_n(&header->tp_status, __ATOMIC_ACQUIRE);
+        reclaimFrames();
+    }
+
+    if (status != TP_STATUS_AVAILABLE) {
+        ++m_statistics.ringFullCount;
+        return std::nullopt;
+    }
+
+    const auto data = reinterpret_cast<ByteType*>(header) + FRAME_DATA_OFFSET;
+    return Slot(header, data, m_config.frameSizeInBytes - FRAME_DATA_OFFSET);
+}
+
+void PacketTxRing::commitSlot(const Slot slot)
+{
+    assert(slot.m_header == getFrameHeader(m_currentFrame));
+    // The kernel rejects the frame without the link layer header and stops at its slot
+    if (slot.m_size < ETH_HLEN) {
+        throw std::runtime_error("Could not commit the frame of tx ring: size=" + std::to_string(slot.m_size) +
+            " is less than the ethernet header");
+    }
+
+    slot.m_header->tp_len = slot.m_size;
+    __atomic_store_n(&slot.m_header->tp_status, TP_STATUS_SEND_REQUEST, __ATOMIC_RELEASE);
+
+    m_currentFrame = (m_currentFrame + 1) % m_config.frameCount;
+    ++m_pendingFrames;
+    ++m_inFlightFrames;
+}
+
+PacketTxRing::SizeType PacketTxRing::send(const bool waitForCompletion)
+{
+    const auto flushedFrames = kick(waitForCompletion);
+    reclaimFrames();
+    return flushedFrames;
+}
+
+PacketTxRing::SizeType PacketTxRing::getPendingFrameCount() const
+{
+    return m_pendingFrames;
+}
+
+const PacketTxRing::Statistics& PacketTxRing::getStatistics() const
+{
+    return m_statistics;
+}
+
+const PacketTxRing::Configuration& PacketTxRing::getConfiguration() const
+{
+    return m_config;
+}
+
+int PacketTxRing::getSocket() const
+{
+    return m_socket;
+}
+
+PacketTxRing::SizeType PacketTxRing::kick(const bool waitForCompletion)
+{
+    // The blocking call also waits for the frames, which were taken by the previous calls
+    if (m_pendingFrames == 0 && (!waitForCompletion || m_inFlightFrames == 0)) {
+        return 0;
+    }
+
+    ++m_statistics.sendCalls;
+    const auto flags = waitForCompletion ? 0 : MSG_DONTWAIT;
+    if (sendto(m_socket, nullptr, 0, flags, nullptr, 0) < 0) {
+        if (errno != EAGAIN && errno != ENOBUFS) {
+            throw std::runtime_error("Could not send frames of tx ring: " + GetLastSysError());
+        }
+
+        // The kernel stopped at the frame, which it could not take now, so the frames stay pending until the next kick
+        return 0;
+    }
+
+    const auto flushedFrames = m_pendingFrames;
+    m_pendingFrames = 0;
+    return flushedFrames;
+}
+
+void PacketTxRing::reclaimFrames() noexcept
+{
+    // The frames are transmitted in order, the slot returns to TP_STATUS_AVAILABLE after the frame has left the ring.
+    // The slot of the rejected frame is returned to the ring by user space, so the ring does not stop at it
+    while (m_inFlightFrames != 0) {
+        const auto header = getFrameHeader(m_oldestFrame);
+        const auto status = __atomic_load_n(&header->tp_status, __ATOMIC_ACQUIRE);
+        if (status == TP_STATUS_WRONG_FORMAT) {
+            ++m_statistics.wrongFormatFrames;
+            __atomic_store_n(&header->tp_status, TP_STATUS_AVAILABLE, __ATOMIC_RELEASE);
+        } else if (status == TP_STATUS_AVAILABLE) {
+            ++m_statistics.sentFrames;
+            m_statistics.sentBytes += header->tp_len;
+        } else {
+            break;
+        }
+
+        m_oldestFrame = (m_oldestFrame + 1) % m_config.frameCount;
+        --m_inFlightFrames;
+    }
+}
+
+struct tpacket2_hdr* PacketTxRing::getFrameHeader(const SizeType index) const
+{
+    const auto framesPerBlock = m_blockSize / m_config.frameSizeInBytes;
+    const auto offset = static_cast<std::size_t>(index / framesPerBlock) * m_blockSize +
+        static_cast<std::size_t>(index % framesPerBlock) * m_config.frameSizeInBytes;
+    return reinterpret_cast<struct tpacket2_hdr*>(m_ring + offset);
+}
+
+} //! namespace posnet
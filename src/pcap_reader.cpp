@@ -0,0 +1,336 @@
+#include "capture-file/pcap_reader.h"
+
+#include "utils/system_error.h"
+
+#include <stdexcept>
+#include <algorithm>
+#include <cstring>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+using namespace posnet::utils;
+
+namespace {
+
+constexpr std::uint32_t PCAP_MICROSECOND_MAGIC = 0xA1B2C3D4;
+constexpr std::uint32_t PCAP_NANOSECOND_MAGIC = 0xA1B23C4D;
+constexpr std::size_t PCAP_FILE_HEADER_SIZE = 24;
+constexpr std::size_t PCAP_RECORD_HEADER_SIZE = 16;
+
+constexpr std::uint32_t PCAPNG_SECTION_HEADER_BLOCK = 0x0A0D0D0A;
+constexpr std::uint32_t PCAPNG_INTERFACE_DESCRIPTION_BLOCK = 0x00000001;
+constexpr std::uint32_t PCAPNG_SIMPLE_PACKET_BLOCK = 0x00000003;
+constexpr std::uint32_t PCAPNG_ENHANCED_PACKET_BLOCK = 0x00000006;
+constexpr std::uint32_t PCAPNG_BYTE_ORDER_MAGIC = 0x1A2B3C4D;
+constexpr std::uint16_t PCAPNG_OPTION_END = 0;
+constexpr std::uint16_t PCAPNG_OPTION_IF_TSRESOL = 9;
+// Block type, block length and the trailing block length
+constexpr std::size_t PCAPNG_BLOCK_OVERHEAD = 12;
+constexpr std::size_t PCAPNG_ENHANCED_PACKET_BLOCK_HEADER_SIZE = 28;
+constexpr std::size_t PCAPNG_SIMPLE_PACKET_BLOCK_HEADER_SIZE = 12;
+constexpr std::size_t PCAPNG_INTERFACE_DESCRIPTION_BLOCK_HEADER_SIZE = 16;
+
+constexpr std::uint64_t NANOSECONDS_PER_SECOND = 1000000000;
+
+std::uint64_t PowerOf10(const unsigned int exponent)
+{
+    std::uint64_t value = 1;
+    for (unsigned int i = 0; i < exponent; ++i) {
+        value *= 10;
+    }
+    return value;
+}
+
+std::int64_t ToNanoseconds(const std::uint64_t timestamp, const std::uint64_t multiplier, const std::uint64_t divider)
+{
+    return static_cast<std::int64_t>(static_cast<unsigned __int128>(timestamp) * multiplier / divider);
+}
+
+} //! namespace
+
+namespace posnet {
+
+PcapReader::PcapReader(const std::string_view path):
+m_path(path),
+m_data(nullptr),
+m_size(0),
+m_offset(0),
+m_firstRecordOffset(0),
+m_format(FormatType::Pcap),
+m_isSwapped(false),
+m_linkType(0),
+m_interfaces()
+{
+    const int fd = open(m_path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw std::runtime_error("Could not open capture file=" + m_path + ": " + GetLastSysError());
+    }
+
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) < 0) {
+        const auto error = GetLastSysError();
+        (void)close(fd);
+        throw std::runtime_error("Could not get size of capture file=" + m_path + ": " + error);
+    }
+
+    m_size = static_cast<std::size_t>(fileStat.st_size);
+    if (m_size < sizeof(std::uint32_t)) {
+        (void)close(fd);
+        throw std::runtime_error("Capture file=" + m_path + " is too short");
+    }
+
+    void* const data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+    // The mapping keeps the file open by itself
+    (void)close(fd);
+    if (data == MAP_FAILED) {
+        throw std::runtime_error("Could not map capture file=" + m_path + ": " + GetLastSysError());
+    }
+    m_data = static_cast<const ByteType*>(data);
+    (void)madvise(data, m_size, MADV_SEQUENTIAL);
+
+    try {
+        parseFileHeader();
+    } catch (...) {
+        (void)munmap(data, m_size);
+        throw;
+    }
+}
+
+PcapReader::~PcapReader()
+{
+    (void)munmap(const_cast<ByteType*>(m_data), m_size);
+}
+
+std::optional<PcapReader::Record> PcapReader::next()
+{
+    return m_format == FormatType::Pcap ? nextPcapRecord() : nextPcapNgRecord();
+}
+
+void PcapReader::reset()
+{
+    if (m_format == FormatType::Pcap) {
+        m_offset = m_firstRecordOffset;
+    } else {
+        // The interfaces are described again by the blocks of the first section
+        m_offset = 0;
+        m_interfaces.clear();
+    }
+}
+
+PcapReader::FormatType PcapReader::getFormat() const
+{
+    return m_format;
+}
+
+std::uint16_t PcapReader::getLinkType() const
+{
+    return m_linkType;
+}
+
+std::size_t PcapReader::getFileSize() const
+{
+    return m_size;
+}
+
+void PcapReader::parseFileHeader()
+{
+    std::uint32_t magic;
+    std::memcpy(&magic, m_data, sizeof(magic));
+    if (magic == PCAPNG_SECTION_HEADER_BLOCK) {
+        m_format = FormatType::PcapNg;
+        // The interfaces are described by the blocks before the first frame, so the link type is known after the first record
+        (void)nextPcapNgRecord();
+        m_linkType = m_interfaces.empty() ? 0 : m_interfaces.front().linkType;
+        reset();
+        return;
+    }
+
+    m_format = FormatType::Pcap;
+    if (m_size < PCAP_FILE_HEADER_SIZE) {
+        throw std::runtime_error("Capture file=" + m_path + " is too short");
+    }
+
+    std::uint64_t multiplier = 0;
+    if (magic == PCAP_MICROSECOND_MAGIC || magic == __builtin_bswap32(PCAP_MICROSECOND_MAGIC)) {
+        multiplier = 1000;
+    } else if (magic == PCAP_NANOSECOND_MAGIC || magic == __builtin_bswap32(PCAP_NANOSECOND_MAGIC)) {
+        multiplier = 1;
+    } else {
+        throw std::runtime_error("Capture file=" + m_path + " is neither pcap nor pcapng file");
+    }
+
+    m_isSwapped = (magic != PCAP_MICROSECOND_MAGIC && magic != PCAP_NANOSECOND_MAGIC);
+    m_linkType = static_cast<std::uint16_t>(read32(20) & 0xFFFF);
+    m_interfaces.push_back(Interface{ m_linkType, multiplier, 1 });
+    m_firstRecordOffset = PCAP_FILE_HEADER_SIZE;
+    m_offset = m_firstRecordOffset;
+}
+
+std::optional<PcapReader::Record> PcapReader::nextPcapRecord()
+{
+    if (m_offset == m_size) {
+        return std::nullopt;
+    }
+
+    if (m_size - m_offset < PCAP_RECORD_HEADER_SIZE) {
+        throw std::runtime_error("Truncated record header of capture file=" + m_path + " at offset=" + std::to_string(m_offset));
+    }
+
+    const auto seconds = read32(m_offset);
+    const auto fraction = read32(m_offset + 4);
+    const auto capturedLength = read32(m_offset + 8);
+    const auto originalLength = read32(m_offset + 12);
+    const auto dataOffset = m_offset + PCAP_RECORD_HEADER_SIZE;
+    if (m_size - dataOffset < capturedLength) {
+        throw std::runtime_error("Truncated record of capture file=" + m_path + " at offset=" + std::to_string(m_offset));
+    }
+
+    const auto& interface = m_interfaces.front();
+    Record record{
+        ConstRawFrameViewType{ m_data + dataOffset, capturedLength },
+        TimestampType(static_cast<std::int64_t>(seconds * NANOSECONDS_PER_SECOND + fraction * interface.multiplier)),
+        originalLength,
+        0
+    };
+    m_offset = dataOffset + capturedLength;
+    return record;
+}
+
+std::optional<PcapReader::Record> PcapReader::nextPcapNgRecord()
+{
+    while (m_offset != m_size) {
+        if (m_size - m_offset < PCAPNG_BLOCK_OVERHEAD) {
+            throw std::runtime_error("Truncated block header of capture file=" + m_path + " at offset=" + std::to_string(m_offset));
+        }
+
+        std::uint32_t blockType;
+        std::memcpy(&blockType, m_data + m_offset, sizeof(blockType));
+        if (blockType == PCAPNG_SECTION_HEADER_BLOCK) {
+            // The byte order of the section has to be known before its length is read
+            std::uint32_t byteOrderMagic;
+            std::memcpy(&byteOrderMagic, m_data + m_offset + 8, sizeof(byteOrderMagic));
+            if (byteOrderMagic != PCAPNG_BYTE_ORDER_MAGIC && byteOrderMagic != __builtin_bswap32(PCAPNG_BYTE_ORDER_MAGIC)) {
+                throw std::runtime_error("Invalid byte order magic of capture file=" + m_path + " at offset=" + std::to_string(m_offset));
+            }
+            m_isSwapped = (byteOrderMagic != PCAPNG_BYTE_ORDER_MAGIC);
+        } else {
+            blockType = read32(m_offset);
+        }
+
+        const auto blockLength = read32(m_offset + 4);
+        if (blockLength < PCAPNG_BLOCK_OVERHEAD || blockLength % 4 != 0 || m_size - m_offset < blockLength) {
+            throw std::runtime_error("Invalid block length=" + std::to_string(blockLength) + " of capture file=" + m_path +
+                " at offset=" + std::to_string(m_offset));
+        }
+
+        const auto offset = m_offset;
+        m_offset += blockLength;
+        switch (blockType) {
+            case PCAPNG_SECTION_HEADER_BLOCK: {
+                // The interface ids are local for the section
+                m_interfaces.clear();
+                break;
+            }
+            case PCAPNG_INTERFACE_DESCRIPTION_BLOCK: {
+                parseInterfaceDescriptionBlock(offset, blockLength);
+                break;
+            }
+            case PCAPNG_ENHANCED_PACKET_BLOCK: {
+                if (blockLength < PCAPNG_ENHANCED_PACKET_BLOCK_HEADER_SIZE + 4) {
+                    throw std::runtime_error("Invalid enhanced packet block of capture file=" + m_path + " at offset=" + std::to_string(offset));
+                }
+
+                const auto interfaceId = read32(offset + 8);
+                const auto timestamp = (static_cast<std::uint64_t>(read32(offset + 12)) << 32) | read32(offset + 16);
+                const auto capturedLength = read32(offset + 20);
+                const auto originalLength = read32(offset + 24);
+                if (interfaceId >= m_interfaces.size() ||
+                    capturedLength > blockLength - PCAPNG_ENHANCED_PACKET_BLOCK_HEADER_SIZE - 4) {
+                    throw std::runtime_error("Invalid enhanced packet block of capture file=" + m_path + " at offset=" + std::to_string(offset));
+                }
+
+                const auto& interface = m_interfaces[interfaceId];
+                return Record{
+                    ConstRawFrameViewType{ m_data + offset + PCAPNG_ENHANCED_PACKET_BLOCK_HEADER_SIZE, capturedLength },
+                    TimestampType(ToNanoseconds(timestamp, interface.multiplier, interface.divider)),
+                    originalLength,
+                    interfaceId
+                };
+            }
+            case PCAPNG_SIMPLE_PACKET_BLOCK: {
+                if (blockLength < PCAPNG_SIMPLE_PACKET_BLOCK_HEADER_SIZE + 4 || m_interfaces.empty()) {
+                    throw std::runtime_error("Invalid simple packet block of capture file=" + m_path + " at offset=" + std::to_string(offset));
+                }
+
+                // The simple packet block has no timestamp and no captured length, the frame is cut by the block
+                const auto originalLength = read32(offset + 8);
+                const auto capturedLength = std::min<std::uint32_t>(originalLength, blockLength - PCAPNG_SIMPLE_PACKET_BLOCK_HEADER_SIZE - 4);
+                return Record{
+                    ConstRawFrameViewType{ m_data + offset + PCAPNG_SIMPLE_PACKET_BLOCK_HEADER_SIZE, capturedLength },
+                    TimestampType(0),
+                    originalLength,
+                    0
+                };
+            }
+            default:
+                break;
+        }
+    }
+    return std::nullopt;
+}
+
+void PcapReader::parseInterfaceDescriptionBlock(const std::size_t offset, const std::uint32_t blockLength)
+{
+    if (blockLength < PCAPNG_INTERFACE_DESCRIPTION_BLOCK_HEADER_SIZE + 4) {
+        throw std::runtime_error("Invalid interface description block of capture file=" + m_path + " at offset=" + std::to_string(offset));
+    }
+
+    // The timestamps are in microseconds by default
+    Interface interface{ read16(offset + 8), 1000, 1 };
+    auto optionOffset = offset + PCAPNG_INTERFACE_DESCRIPTION_BLOCK_HEADER_SIZE;
+    const auto optionsEnd = offset + blockLength - 4;
+    while (optionsEnd - optionOffset >= 4) {
+        const auto code = read16(optionOffset);
+        const auto length = read16(optionOffset + 2);
+        if (code == PCAPNG_OPTION_END || optionsEnd - optionOffset - 4 < length) {
+            break;
+        }
+
+        if (code == PCAPNG_OPTION_IF_TSRESOL && length >= 1) {
+            const auto resolution = m_data[optionOffset + 4];
+            const unsigned int exponent = resolution & 0x7F;
+            if ((resolution & 0x80) != 0) {
+                // The resolution is 2^-exponent seconds
+                interface.multiplier = NANOSECONDS_PER_SECOND;
+                interface.divider = std::uint64_t(1) << std::min(exponent, 63u);
+            } else if (exponent <= 9) {
+                interface.multiplier = PowerOf10(9 - exponent);
+                interface.divider = 1;
+            } else {
+                interface.multiplier = 1;
+                interface.divider = PowerOf10(std::min(exponent, 19u) - 9);
+            }
+        }
+        optionOffset += 4 + ((length + 3) & ~3u);
+    }
+    m_interfaces.push_back(interface);
+}
+
+std::uint16_t PcapReader::read16(const std::size_t offset) const
+{
+    std::uint16_t value;
+    std::memcpy(&value, m_data + offset, sizeof(value));
+    return m_isSwapped ? __builtin_bswap16(value) : value;
+}
+
+std::uint32_t PcapReader::read32(const std::size_t offset) const
+{
+    std::uint32_t value;
+    std::memcpy(&value, m_data + offset, sizeof(value));
+    return m_isSwapped ? __builtin_bswap32(value) : value;
+}
+
+} //! namespace posnet
@@ -0,0 +1,409 @@
+#include "capture-file/pcap_writer.h"
+
+#include "utils/system_error.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <cstring>
+#include <cstdlib>
+#include <cerrno>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace posnet::utils;
+
+namespace {
+
+using SizeType = posnet::PcapWriter::SizeType;
+using ByteType = posnet::PcapWriter::ByteType;
+
+// The magic number of pcap file with nanosecond timestamps
+constexpr std::uint32_t PCAP_NANOSECOND_MAGIC = 0xA1B23C4D;
+constexpr std::uint16_t PCAP_VERSION_MAJOR = 2;
+constexpr std::uint16_t PCAP_VERSION_MINOR = 4;
+constexpr SizeType PCAP_FILE_HEADER_SIZE = 24;
+constexpr SizeType PCAP_RECORD_HEADER_SIZE = 16;
+
+constexpr std::uint32_t PCAPNG_SECTION_HEADER_BLOCK = 0x0A0D0D0A;
+constexpr std::uint32_t PCAPNG_INTERFACE_DESCRIPTION_BLOCK = 0x00000001;
+constexpr std::uint32_t PCAPNG_ENHANCED_PACKET_BLOCK = 0x00000006;
+constexpr std::uint32_t PCAPNG_BYTE_ORDER_MAGIC = 0x1A2B3C4D;
+constexpr std::uint16_t PCAPNG_VERSION_MAJOR = 1;
+constexpr std::uint16_t PCAPNG_VERSION_MINOR = 0;
+constexpr std::uint16_t PCAPNG_OPTION_END = 0;
+constexpr std::uint16_t PCAPNG_OPTION_IF_TSRESOL = 9;
+// The timestamps are in 10^-9 seconds
+constexpr std::uint8_t PCAPNG_NANOSECOND_RESOLUTION = 9;
+constexpr SizeType PCAPNG_SECTION_HEADER_BLOCK_SIZE = 28;
+constexpr SizeType PCAPNG_INTERFACE_DESCRIPTION_BLOCK_SIZE = 32;
+// Block type, block length, interface id, timestamp(high and low), captured length, original length, block length
+constexpr SizeType PCAPNG_ENHANCED_PACKET_BLOCK_OVERHEAD = 32;
+
+constexpr SizeType MAX_FILE_HEADER_SIZE = PCAPNG_SECTION_HEADER_BLOCK_SIZE + PCAPNG_INTERFACE_DESCRIPTION_BLOCK_SIZE;
+constexpr SizeType MAX_RECORD_OVERHEAD = PCAPNG_ENHANCED_PACKET_BLOCK_OVERHEAD + 3;
+
+constexpr SizeType AlignTo4(const SizeType size)
+{
+    return (size + 3) & ~static_cast<SizeType>(3);
+}
+
+/**
+ * @brief Writes the values one by one in host byte order, the readers detect the byte order by the magic number.
+ */
+class RecordWriter final {
+public:
+    explicit RecordWriter(ByteType* const data):
+    m_data(data),
+    m_offset(0)
+    {}
+
+    template<typename T>
+    RecordWriter& put(const T value)
+    {
+        std::memcpy(m_data + m_offset, &value, sizeof(value));
+        m_offset += sizeof(value);
+        return *this;
+    }
+
+    RecordWriter& put(const posnet::PcapWriter::ConstRawFrameViewType data, const SizeType paddedSize)
+    {
+        std::memcpy(m_data + m_offset, data.data(), data.size());
+        std::memset(m_data + m_offset + data.size(), 0, paddedSize - data.size());
+        m_offset += paddedSize;
+        return *this;
+    }
+
+    SizeType getOffset() const
+    {
+        return m_offset;
+    }
+
+private:
+    ByteType* m_data;
+    SizeType m_offset;
+};
+
+void CheckConfiguration(const posnet::PcapWriter::Configuration& config)
+{
+    if (config.bufferCount < 2) {
+        throw std::runtime_error("Invalid pcap writer configuration: at least two buffers are required");
+    }
+
+    if (config.snapLength == 0) {
+        throw std::runtime_error("Invalid pcap writer configuration: snap length must be greater than zero");
+    }
+
+    if (config.bufferSizeInBytes < MAX_FILE_HEADER_SIZE + config.snapLength + MAX_RECORD_OVERHEAD) {
+        throw std::runtime_error("Invalid pcap writer configuration: buffer size=" + std::to_string(config.bufferSizeInBytes) +
+            " is less than the record of snap length=" + std::to_string(config.snapLength));
+    }
+}
+
+std::int64_t GetCurrentTimeInNs()
+{
+    const auto now = std::chrono::system_clock::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+}
+
+} //! namespace
+
+namespace posnet {
+
+PcapWriter::PcapWriter(const std::string_view path):
+PcapWriter(path, Configuration{})
+{}
+
+PcapWriter::PcapWriter(const std::string_view path, const Configuration config):
+m_config(config),
+m_fd(-1),
+m_storage(),
+m_current(),
+m_hasCurrent(false),
+m_isClosed(false),
+m_mutex(),
+m_condition(),
+m_freeBuffers(),
+m_fullBuffers(),
+m_stopRequested(false),
+m_error(nullptr),
+m_ioThread(),
+m_writtenFrames(0),
+m_droppedFrames(0),
+m_truncatedFrames(0),
+m_writtenBytes(0),
+m_flushCount(0),
+m_lastFlushLatency(0),
+m_maxFlushLatency(0),
+m_totalFlushLatency(0)
+{
+    CheckConfiguration(m_config);
+
+    const std::string name(path);
+    m_fd = open(name.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (m_fd < 0) {
+        throw std::runtime_error("Could not open capture file=" + name + ": " + GetLastSysError());
+    }
+
+    // The buffers are page-aligned, so the kernel copies them to the page cache by the whole pages
+    const auto alignedSize = (m_config.bufferSizeInBytes + BUFFER_ALIGNMENT_IN_BYTES - 1) / BUFFER_ALIGNMENT_IN_BYTES * BUFFER_ALIGNMENT_IN_BYTES;
+    for (SizeType i = 0; i < m_config.bufferCount; ++i) {
+        const auto data = static_cast<ByteType*>(std::aligned_alloc(BUFFER_ALIGNMENT_IN_BYTES, alignedSize));
+        if (data == nullptr) {
+            for (const auto buffer : m_storage) {
+                std::free(buffer);
+            }
+            (void)::close(m_fd);
+            throw std::runtime_error("Could not allocate buffers of pcap writer");
+        }
+        m_storage.push_back(data);
+        m_freeBuffers.push_back(Buffer{ data, 0 });
+    }
+
+    stageFileHeader();
+    m_ioThread = std::thread(&PcapWriter::runIOThread, this);
+}
+
+PcapWriter::~PcapWriter()
+{
+    try {
+        close();
+    } catch (...) {
+    }
+}
+
+bool PcapWriter::write(const ConstRawFrameViewType frame, const TimestampType timestamp, const SizeType originalLength)
+{
+    if (m_isClosed) {
+        return false;
+    }
+
+    const auto capturedLength = std::min<SizeType>(frame.size(), m_config.snapLength);
+    const auto recordSize = m_config.format == FormatType::Pcap ?
+        PCAP_RECORD_HEADER_SIZE + capturedLength :
+        PCAPNG_ENHANCED_PACKET_BLOCK_OVERHEAD + AlignTo4(capturedLength);
+
+    if (!reserveRecord(recordSize)) {
+        m_droppedFrames.store(m_droppedFrames.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return false;
+    }
+
+    const auto data = ConstRawFrameViewType{ frame.data(), capturedLength };
+    const auto wireLength = static_cast<std::uint32_t>(originalLength != 0 ? originalLength : frame.size());
+    const auto nanoseconds = static_cast<std::uint64_t>(timestamp.count());
+    RecordWriter writer(m_current.data + m_current.size);
+    if (m_config.format == FormatType::Pcap) {
+        writer.put(static_cast<std::uint32_t>(nanoseconds / 1000000000))
+            .put(static_cast<std::uint32_t>(nanoseconds % 1000000000))
+            .put(static_cast<std::uint32_t>(capturedLength))
+            .put(wireLength)
+            .put(data, capturedLength);
+    } else {
+        writer.put(PCAPNG_ENHANCED_PACKET_BLOCK)
+            .put(static_cast<std::uint32_t>(recordSize))
+            .put(static_cast<std::uint32_t>(0)) // interface id
+            .put(static_cast<std::uint32_t>(nanoseconds >> 32))
+            .put(static_cast<std::uint32_t>(nanoseconds & 0xFFFFFFFF))
+            .put(static_cast<std::uint32_t>(capturedLength))
+            .put(wireLength)
+            .put(data, AlignTo4(capturedLength))
+            .put(static_cast<std::uint32_t>(recordSize));
+    }
+    m_current.size += writer.getOffset();
+
+    m_writtenFrames.store(m_writtenFrames.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    if (capturedLength < frame.size()) {
+        m_truncatedFrames.store(m_truncatedFrames.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+    return true;
+}
+
+bool PcapWriter::write(const ConstRawFrameViewType frame)
+{
+    return write(frame, TimestampType(GetCurrentTimeInNs()));
+}
+
+void PcapWriter::flush()
+{
+    if (!m_isClosed && m_hasCurrent && m_current.size != 0) {
+        submitBuffer();
+    }
+}
+
+void PcapWriter::close()
+{
+    if (m_isClosed) {
+        return;
+    }
+
+    flush();
+    m_isClosed = true;
+    {
+        std::lock_guard lock(m_mutex);
+        m_stopRequested = true;
+    }
+    m_condition.notify_one();
+    m_ioThread.join();
+
+    (void)::close(m_fd);
+    // The queues keep the pointers to the storage, so they are cleared together with it
+    m_current = Buffer{};
+    m_hasCurrent = false;
+    m_freeBuffers.clear();
+    m_fullBuffers.clear();
+    for (const auto buffer : m_storage) {
+        std::free(buffer);
+    }
+    m_storage.clear();
+
+    if (m_error) {
+        std::rethrow_exception(m_error);
+    }
+}
+
+PcapWriter::Statistics PcapWriter::getStatistics() const
+{
+    Statistics statistics;
+    statistics.writtenFrames = m_writtenFrames.load(std::memory_order_relaxed);
+    statistics.droppedFrames = m_droppedFrames.load(std::memory_order_relaxed);
+    statistics.truncatedFrames = m_truncatedFrames.load(std::memory_order_relaxed);
+    statistics.writtenBytes = m_writtenBytes.load(std::memory_order_relaxed);
+    statistics.flushCount = m_flushCount.load(std::memory_order_relaxed);
+    statistics.lastFlushLatency = std::chrono::nanoseconds(m_lastFlushLatency.load(std::memory_order_relaxed));
+    statistics.maxFlushLatency = std::chrono::nanoseconds(m_maxFlushLatency.load(std::memory_order_relaxed));
+    statistics.totalFlushLatency = std::chrono::nanoseconds(m_totalFlushLatency.load(std::memory_order_relaxed));
+    return statistics;
+}
+
+const PcapWriter::Configuration& PcapWriter::getConfiguration() const
+{
+    return m_config;
+}
+
+void PcapWriter::stageFileHeader()
+{
+    m_current = m_freeBuffers.front();
+    m_freeBuffers.pop_front();
+    m_hasCurrent = true;
+
+    RecordWriter writer(m_current.data);
+    if (m_config.format == FormatType::Pcap) {
+        writer.put(PCAP_NANOSECOND_MAGIC)
+            .put(PCAP_VERSION_MAJOR)
+            .put(PCAP_VERSION_MINOR)
+            .put(static_cast<std::int32_t>(0)) // thiszone
+            .put(static_cast<std::uint32_t>(0)) // sigfigs
+            .put(static_cast<std::uint32_t>(m_config.snapLength))
+            .put(static_cast<std::uint32_t>(m_config.linkType));
+    } else {
+        writer.put(PCAPNG_SECTION_HEADER_BLOCK)
+            .put(static_cast<std::uint32_t>(PCAPNG_SECTION_HEADER_BLOCK_SIZE))
+            .put(PCAPNG_BYTE_ORDER_MAGIC)
+            .put(PCAPNG_VERSION_MAJOR)
+            .put(PCAPNG_VERSION_MINOR)
+            .put(static_cast<std::int64_t>(-1)) // the section length is not specified
+            .put(static_cast<std::uint32_t>(PCAPNG_SECTION_HEADER_BLOCK_SIZE));
+
+        writer.put(PCAPNG_INTERFACE_DESCRIPTION_BLOCK)
+            .put(static_cast<std::uint32_t>(PCAPNG_INTERFACE_DESCRIPTION_BLOCK_SIZE))
+            .put(m_config.linkType)
+            .put(static_cast<std::uint16_t>(0)) // reserved
+            .put(static_cast<std::uint32_t>(m_config.snapLength))
+            .put(PCAPNG_OPTION_IF_TSRESOL)
+            .put(static_cast<std::uint16_t>(sizeof(PCAPNG_NANOSECOND_RESOLUTION)))
+            .put(static_cast<std::uint32_t>(PCAPNG_NANOSECOND_RESOLUTION)) // the value is padded to 32 bits
+            .put(PCAPNG_OPTION_END)
+            .put(static_cast<std::uint16_t>(0))
+            .put(static_cast<std::uint32_t>(PCAPNG_INTERFACE_DESCRIPTION_BLOCK_SIZE));
+    }
+    m_current.size = writer.getOffset();
+}
+
+bool PcapWriter::reserveRecord(const SizeType recordSize)
+{
+    if (m_hasCurrent && m_current.size + recordSize <= m_config.bufferSizeInBytes) {
+        return true;
+    }
+
+    if (m_hasCurrent) {
+        submitBuffer();
+    }
+
+    std::lock_guard lock(m_mutex);
+    if (m_freeBuffers.empty()) {
+        return false;
+    }
+
+    m_current = m_freeBuffers.front();
+    m_freeBuffers.pop_front();
+    m_hasCurrent = true;
+    return true;
+}
+
+void PcapWriter::submitBuffer()
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_fullBuffers.push_back(m_current);
+    }
+    m_condition.notify_one();
+    m_hasCurrent = false;
+}
+
+void PcapWriter::runIOThread()
+{
+    while (true) {
+        std::unique_lock lock(m_mutex);
+        m_condition.wait(lock, [this] {
+            return m_stopRequested || !m_fullBuffers.empty();
+        });
+
+        if (m_fullBuffers.empty()) {
+            return;
+        }
+
+        auto buffer = m_fullBuffers.front();
+        m_fullBuffers.pop_front();
+        lock.unlock();
+
+        // After the first error the buffers are not written, but they are still returned to the capture thread
+        if (!m_error) {
+            try {
+                writeBuffer(buffer);
+            } catch (...) {
+                m_error = std::current_exception();
+            }
+        }
+
+        buffer.size = 0;
+        lock.lock();
+        m_freeBuffers.push_back(buffer);
+    }
+}
+
+void PcapWriter::writeBuffer(const Buffer& buffer)
+{
+    const auto startTime = std::chrono::steady_clock::now();
+    SizeType offset = 0;
+    while (offset < buffer.size) {
+        const auto result = ::write(m_fd, buffer.data + offset, buffer.size - offset);
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::runtime_error("Could not write capture file: " + GetLastSysError());
+        }
+        offset += static_cast<SizeType>(result);
+    }
+
+    const auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTime).count();
+    m_writtenBytes.fetch_add(buffer.size, std::memory_order_relaxed);
+    m_flushCount.fetch_add(1, std::memory_order_relaxed);
+    m_lastFlushLatency.store(latency, std::memory_order_relaxed);
+    m_totalFlushLatency.fetch_add(latency, std::memory_order_relaxed);
+    if (latency > m_maxFlushLatency.load(std::memory_order_relaxed)) {
+        m_maxFlushLatency.store(latency, std::memory_order_relaxed);
+    }
+}
+
+} //! namespace posnet
@@ -0,0 +1,458 @@
+#include "pipeline/pipeline.h"
+
+#include <stdexcept>
+#include <string>
+#include <algorithm>
+#include <cstring>
+#include <array>
+#include <utility>
+
+namespace {
+
+using StageState = posnet::Pipeline::StageState;
+
+void CheckConfiguration(const posnet::Pipeline::Configuration& config)
+{
+    if (config.ringCapacity == 0 || config.batchSize == 0) {
+        throw std::runtime_error("Invalid pipeline configuration: ring capacity=" + std::to_string(config.ringCapacity) +
+            " batch size=" + std::to_string(config.batchSize));
+    }
+}
+
+void CheckStage(const std::string& name, const posnet::Pipeline::SizeType threadCount, const bool hasHandler)
+{
+    if (threadCount == 0 || !hasHandler) {
+        throw std::runtime_error("Invalid pipeline stage " + name + ": thread count=" + std::to_string(threadCount) +
+            (hasHandler ? "" : " without handler"));
+    }
+}
+
+/**
+ * @brief Measures the time of one waiting, which can take several attempts.
+ */
+class StallTimer final {
+public:
+    void start()
+    {
+        if (!m_isStarted) {
+            m_startTime = std::chrono::steady_clock::now();
+            m_isStarted = true;
+        }
+    }
+
+    std::chrono::nanoseconds stop()
+    {
+        if (!m_isStarted) {
+            return std::chrono::nanoseconds::zero();
+        }
+
+        m_isStarted = false;
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_startTime);
+    }
+
+private:
+    std::chrono::steady_clock::time_point m_startTime{};
+    bool m_isStarted = false;
+};
+
+} //! namespace
+
+namespace posnet {
+
+struct Pipeline::Stage {
+    explicit Stage(std::string stageName, const SizeType stageThreadCount, ProcessorType stageProcessor):
+    name(std::move(stageName)),
+    threadCount(stageThreadCount),
+    processor(std::move(stageProcessor)),
+    controller(StageState::Created),
+    runningThreads(0),
+    processedFrames(0),
+    processedBatches(0),
+    droppedFrames(0),
+    stallTimeInNs(0),
+    input(nullptr),
+    output(nullptr),
+    next(nullptr)
+    {}
+
+    void addStallTime(const std::chrono::nanoseconds stallTime) noexcept
+    {
+        if (stallTime != std::chrono::nanoseconds::zero()) {
+            stallTimeInNs.fetch_add(static_cast<std::uint64_t>(stallTime.count()), std::memory_order_relaxed);
+        }
+    }
+
+    const std::string name;
+    const SizeType threadCount;
+    // It is empty for the capture stage
+    const ProcessorType processor;
+    utils::StageController<StageState> controller;
+    std::atomic<SizeType> runningThreads;
+    std::atomic<std::uint64_t> processedFrames;
+    std::atomic<std::uint64_t> processedBatches;
+    std::atomic<std::uint64_t> droppedFrames;
+    std::atomic<std::uint64_t> stallTimeInNs;
+    RingType* input;
+    RingType* output;
+    Stage* next;
+};
+
+Pipeline::CaptureContext::CaptureContext(Pipeline& pipeline, Stage& stage, const SizeType threadIndex):
+m_pipeline(pipeline),
+m_stage(stage),
+m_threadIndex(threadIndex),
+m_frameCache(pipeline.m_framePool),
+m_batch()
+{
+    m_batch.reserve(m_pipeline.m_config.batchSize);
+}
+
+Pipeline::CaptureContext::~CaptureContext()
+{
+    m_pipeline.releaseFrames(m_batch, m_frameCache);
+}
+
+bool Pipeline::CaptureContext::emit(const ConstRawFrameViewType frame, const FrameInfo& info)
+{
+    auto frameBuffer = m_frameCache.allocate();
+    if (frameBuffer == nullptr) {
+        m_stage.droppedFrames.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    const auto length = static_cast<SizeType>(std::min<std::size_t>(frame.size(), m_frameCache.getPool().getFrameSize()));
+    std::memcpy(frameBuffer, frame.data(), length);
+
+    auto& pipelineFrame = m_batch.emplace_back();
+    pipelineFrame.descriptor.data = frameBuffer;
+    pipelineFrame.descriptor.length = length;
+    pipelineFrame.descriptor.info = info;
+    if (pipelineFrame.descriptor.info.originalLength == 0) {
+        pipelineFrame.descriptor.info.originalLength = static_cast<SizeType>(frame.size());
+    }
+
+    if (m_batch.size() == m_pipeline.m_config.batchSize) {
+        flush();
+    }
+    return true;
+}
+
+void Pipeline::CaptureContext::flush()
+{
+    if (m_batch.empty()) {
+        return;
+    }
+
+    m_stage.processedFrames.fetch_add(m_batch.size(), std::memory_order_relaxed);
+    m_stage.processedBatches.fetch_add(1, std::memory_order_relaxed);
+    const auto droppedFrames = m_pipeline.forwardFrames(m_stage, m_batch, m_frameCache);
+    if (droppedFrames != 0) {
+        m_stage.droppedFrames.fetch_add(droppedFrames, std::memory_order_relaxed);
+    }
+    m_batch.clear();
+}
+
+bool Pipeline::CaptureContext::isStopRequested() const noexcept
+{
+    return m_stage.controller.getCurrentStage() != StageState::Running;
+}
+
+Pipeline::SizeType Pipeline::CaptureContext::getThreadIndex() const noexcept
+{
+    return m_threadIndex;
+}
+
+Pipeline::Pipeline(const Configuration config, FramePool& framePool, CaptureStage captureStage, std::vector<ProcessingStage> stages):
+m_config(config),
+m_framePool(framePool),
+m_captureHandler(std::move(captureStage.handler)),
+m_stages(),
+m_rings(),
+m_threads(),
+m_error()
+{
+    CheckConfiguration(m_config);
+    CheckStage(captureStage.name, captureStage.threadCount, static_cast<bool>(m_captureHandler));
+    m_stages.push_back(std::make_unique<Stage>(std::move(captureStage.name), captureStage.threadCount, ProcessorType{}));
+
+    for (auto& stage : stages) {
+        CheckStage(stage.name, stage.threadCount, static_cast<bool>(stage.processor));
+        m_rings.push_back(std::make_unique<RingType>(m_config.ringCapacity));
+
+        auto& prevStage = *m_stages.back();
+        m_stages.push_back(std::make_unique<Stage>(std::move(stage.name), stage.threadCount, std::move(stage.processor)));
+        prevStage.output = m_rings.back().get();
+        prevStage.next = m_stages.back().get();
+        m_stages.back()->input = m_rings.back().get();
+    }
+}
+
+Pipeline::~Pipeline()
+{
+    try {
+        stop();
+    } catch (...) {
+        // The error of the stage is not reported by the destructor
+    }
+}
+
+void Pipeline::start()
+{
+    for (const auto& stage : m_stages) {
+        if (stage->controller.getCurrentStage() != StageState::Created) {
+            throw std::runtime_error("Could not start pipeline: stage " + stage->name + " is " +
+                std::string(StageStateToStr(stage->controller.getCurrentStage())));
+        }
+    }
+
+    // The stages are started from the sink, so the capture stage does not fill the rings before their consumers are running
+    for (auto it = m_stages.rbegin(); it != m_stages.rend(); ++it) {
+        auto& stage = **it;
+        stage.runningThreads.store(stage.threadCount);
+        stage.controller.setNextStageStrongly(StageState::Running);
+        for (SizeType i = 0; i < stage.threadCount; ++i) {
+            if (&stage == m_stages.front().get()) {
+                m_threads.emplace_back(&Pipeline::runCapture, this, std::ref(stage), i);
+            } else {
+                m_threads.emplace_back(&Pipeline::runProcessing, this, std::ref(stage));
+            }
+        }
+    }
+}
+
+void Pipeline::drain()
+{
+    auto& captureStage = *m_stages.front();
+    if (captureStage.controller.getCurrentStage() == StageState::Created) {
+        stop();
+        return;
+    }
+
+    // The next stages are drained one by one by the last exiting thread of the previous stage(onThreadExit)
+    (void)captureStage.controller.gotoNextStageIfCurrentStage(StageState::Running, StageState::Draining);
+    joinThreads();
+    stop();
+}
+
+void Pipeline::stop()
+{
+    for (const auto& stage : m_stages) {
+        stage->controller.setNextStageStrongly(StageState::Stopped);
+    }
+    joinThreads();
+
+    // The frames, which have not reached the sink
+    std::array<PipelineFrame, DEFAULT_BATCH_SIZE> frames;
+    for (const auto& ring : m_rings) {
+        for (auto count = ring->dequeueBatch(frames); count != 0; count = ring->dequeueBatch(frames)) {
+            for (SizeType i = 0; i < count; ++i) {
+                m_framePool.deallocate(const_cast<ByteType*>(frames[i].descriptor.data));
+            }
+        }
+    }
+
+    std::exception_ptr error;
+    {
+        auto firstError = m_error.lock();
+        error = std::exchange(*firstError, nullptr);
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+bool Pipeline::isStopped() const noexcept
+{
+    return std::all_of(m_stages.cbegin(), m_stages.cend(), [](const auto& stage) {
+        return stage->controller.getCurrentStage() == StageState::Stopped;
+    });
+}
+
+Pipeline::SizeType Pipeline::getStageCount() const noexcept
+{
+    return static_cast<SizeType>(m_stages.size());
+}
+
+std::vector<Pipeline::StageStatistics> Pipeline::getStatistics() const
+{
+    std::vector<StageStatistics> statistics;
+    statistics.reserve(m_stages.size());
+    for (const auto& stage : m_stages) {
+        auto& stageStatistics = statistics.emplace_back();
+        stageStatistics.name = stage->name;
+        stageStatistics.state = stage->controller.getCurrentStage();
+        stageStatistics.threadCount = stage->threadCount;
+        stageStatistics.processedFrames = stage->processedFrames.load(std::memory_order_relaxed);
+        stageStatistics.processedBatches = stage->processedBatches.load(std::memory_order_relaxed);
+        stageStatistics.droppedFrames = stage->droppedFrames.load(std::memory_order_relaxed);
+        stageStatistics.queueDepth = stage->input != nullptr ? static_cast<SizeType>(stage->input->getSize()) : 0;
+        stageStatistics.stallTime = std::chrono::nanoseconds(stage->stallTimeInNs.load(std::memory_order_relaxed));
+    }
+    return statistics;
+}
+
+void Pipeline::runCapture(Stage& stage, const SizeType threadIndex)
+{
+    try {
+        CaptureContext context(*this, stage, threadIndex);
+        while (stage.controller.getCurrentStage() == StageState::Running) {
+            m_captureHandler(context);
+            context.flush();
+        }
+    } catch (...) {
+        onThreadError(std::current_exception());
+    }
+    onThreadExit(stage);
+}
+
+void Pipeline::runProcessing(Stage& stage)
+{
+    try {
+        FramePool::LocalCache frameCache(m_framePool);
+        std::vector<PipelineFrame> batch(m_config.batchSize);
+        StallTimer stallTimer;
+        utils::Backoff backoff;
+        while (true) {
+            // The state is read before the ring: the previous stage has sent all its frames before this stage is drained
+            const auto state = stage.controller.getCurrentStage();
+            if (state == StageState::Stopped) {
+                break;
+            }
+
+            const auto count = stage.input->dequeueBatch(batch);
+            if (count == 0) {
+                if (state == StageState::Draining) {
+                    break;
+                }
+                stallTimer.start();
+                backoff.pause();
+                continue;
+            }
+            stage.addStallTime(stallTimer.stop());
+            backoff.reset();
+
+            const auto frames = std::span<PipelineFrame>(batch.data(), count);
+            try {
+                stage.processor(frames);
+            } catch (...) {
+                releaseFrames(frames, frameCache);
+                throw;
+            }
+
+            stage.processedFrames.fetch_add(count, std::memory_order_relaxed);
+            stage.processedBatches.fetch_add(1, std::memory_order_relaxed);
+            const auto droppedFrames = forwardFrames(stage, frames, frameCache);
+            if (droppedFrames != 0) {
+                stage.droppedFrames.fetch_add(droppedFrames, std::memory_order_relaxed);
+            }
+        }
+        stage.addStallTime(stallTimer.stop());
+    } catch (...) {
+        onThreadError(std::current_exception());
+    }
+    onThreadExit(stage);
+}
+
+void Pipeline::onThreadExit(Stage& stage) noexcept
+{
+    if (stage.runningThreads.fetch_sub(1) != 1) {
+        return;
+    }
+
+    // The last thread of the stage: all frames of the stage have been sent to the next ring, so the next stage can be drained
+    stage.controller.setNextStageStrongly(StageState::Stopped);
+    if (stage.next != nullptr) {
+        (void)stage.next->controller.gotoNextStageIfCurrentStage(StageState::Running, StageState::Draining);
+    }
+}
+
+void Pipeline::onThreadError(const std::exception_ptr error) noexcept
+{
+    {
+        auto firstError = m_error.lock();
+        if (!*firstError) {
+            *firstError = error;
+        }
+    }
+
+    for (const auto& stage : m_stages) {
+        stage->controller.setNextStageStrongly(StageState::Stopped);
+    }
+}
+
+std::uint64_t Pipeline::forwardFrames(Stage& stage, std::span<PipelineFrame> frames, FramePool::LocalCache& frameCache)
+{
+    // The passed frames are moved to the front of the batch
+    const auto passedEnd = std::stable_partition(frames.begin(), frames.end(), [](const PipelineFrame& frame) {
+        return !frame.isDropped;
+    });
+    const auto passedCount = static_cast<std::size_t>(passedEnd - frames.begin());
+    std::uint64_t droppedCount = frames.size() - passedCount;
+    releaseFrames(frames.subspan(passedCount), frameCache);
+
+    auto passedFrames = std::span<const PipelineFrame>(frames.data(), passedCount);
+    if (stage.output == nullptr) {
+        releaseFrames(passedFrames, frameCache);
+        return droppedCount;
+    }
+
+    if (m_config.overflowPolicy == utils::OverflowPolicy::Drop) {
+        const auto sentCount = stage.output->tryEnqueueBatch(passedFrames);
+        releaseFrames(passedFrames.subspan(sentCount), frameCache);
+        return droppedCount + (passedFrames.size() - sentCount);
+    }
+
+    StallTimer stallTimer;
+    utils::Backoff backoff;
+    while (!passedFrames.empty()) {
+        const auto sentCount = stage.output->tryEnqueueBatch(passedFrames);
+        passedFrames = passedFrames.subspan(sentCount);
+        if (sentCount != 0) {
+            backoff.reset();
+            continue;
+        }
+
+        // The next stage will not take the frames, if the pipeline is stopped
+        if (stage.controller.getCurrentStage() == StageState::Stopped) {
+            droppedCount += passedFrames.size();
+            releaseFrames(passedFrames, frameCache);
+            break;
+        }
+        stallTimer.start();
+        backoff.pause();
+    }
+    stage.addStallTime(stallTimer.stop());
+    return droppedCount;
+}
+
+void Pipeline::releaseFrames(const std::span<const PipelineFrame> frames, FramePool::LocalCache& frameCache) noexcept
+{
+    for (const auto& frame : frames) {
+        frameCache.deallocate(const_cast<ByteType*>(frame.descriptor.data));
+    }
+}
+
+void Pipeline::joinThreads()
+{
+    for (auto& thread : m_threads) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+    m_threads.clear();
+}
+
+std::string_view StageStateToStr(const Pipeline::StageState state)
+{
+    switch (state) {
+        case Pipeline::StageState::Created: return "Created";
+        case Pipeline::StageState::Running: return "Running";
+        case Pipeline::StageState::Draining: return "Draining";
+        case Pipeline::StageState::Stopped: return "Stopped";
+        default:
+            return "Undefined";
+    }
+}
+
+} //! namespace posnet
@@ -19,13 +19,13 @@
 
 namespace posnet::utils {
     
-std::string MacAddrToStr(std::span<uint8_t, MAC_ADDRESS_LENGTH_IN_BYTES> macAddr)
+std::string MacAddrToStr(std::span<const uint8_t, MAC_ADDRESS_LENGTH_IN_BYTES> macAddr)
 {
-    auto addrStruct = reinterpret_cast<struct ether_addr*>(macAddr.data());
+    auto addrStruct = reinterpret_cast<const struct ether_addr*>(macAddr.data());
     return ether_ntoa(addrStruct);
 }
 
-std::string IpAddrToStr(const std::span<uint8_t, IP_ADDRESS_LENGTH_IN_BYTES> ipAddr)
+std::string IpAddrToStr(const std::span<const uint8_t, IP_ADDRESS_LENGTH_IN_BYTES> ipAddr)
 {
     static std::array<char, INET_ADDRSTRLEN> storage = {0};
     std::memset(storage.data(), 0, storage.size());
@@ -0,0 +1,446 @@
+#include "tcp-reassembly/tcp_reassembler.h"
+
+#include "frame-viewers/ip_viewer.h"
+#include "frame-viewers/tcp_viewer.h"
+#include "utils/byte_order.h"
+#include "utils/ring_policy.h"
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <algorithm>
+#include <cstring>
+#include <cassert>
+
+#include <netinet/ip.h>
+#include <netinet/tcp.h>
+
+using namespace posnet::utils;
+
+namespace {
+
+void CheckConfiguration(const posnet::TcpReassembler::Configuration& config)
+{
+    if (config.maxConnectionCount == 0 || config.maxConnectionCount >= UINT32_MAX / 2) {
+        throw std::runtime_error("Invalid tcp reassembler configuration: max connection count=" + std::to_string(config.maxConnectionCount));
+    }
+
+    if (config.memoryLimitInBytes < posnet::TcpReassembler::CHUNK_SIZE_IN_BYTES) {
+        throw std::runtime_error("Invalid tcp reassembler configuration: memory limit=" + std::to_string(config.memoryLimitInBytes));
+    }
+
+    if (config.maxBufferedBytesPerDirection < posnet::TcpReassembler::CHUNK_SIZE_IN_BYTES) {
+        throw std::runtime_error("Invalid tcp reassembler configuration: max buffered bytes per direction=" +
+            std::to_string(config.maxBufferedBytesPerDirection));
+    }
+
+    if (config.idleTimeout <= std::chrono::nanoseconds::zero()) {
+        throw std::runtime_error("Invalid tcp reassembler configuration: idle timeout must be greater than zero");
+    }
+}
+
+// The distance between the sequence numbers modulo 2^32, it is negative if lhs is before rhs
+std::int32_t SequenceDiff(const std::uint32_t lhs, const std::uint32_t rhs) noexcept
+{
+    return static_cast<std::int32_t>(lhs - rhs);
+}
+
+std::size_t ToIndex(const posnet::TcpReassembler::Direction direction) noexcept
+{
+    return static_cast<std::size_t>(direction);
+}
+
+} //! namespace
+
+namespace posnet {
+
+TcpReassembler::TcpReassembler(Configuration config, Handlers handlers, const TimestampType now):
+m_config(config),
+m_handlers(std::move(handlers)),
+m_connections(),
+m_freeConnections(),
+m_index(),
+m_indexMask(0),
+m_chunks(),
+m_freeChunks(),
+m_timerWheel(TimerWheel::Configuration{ .initialCapacity = config.maxConnectionCount }, now),
+m_nextConnectionId(0),
+m_statistics()
+{
+    CheckConfiguration(m_config);
+
+    m_connections.resize(m_config.maxConnectionCount);
+    m_freeConnections.reserve(m_config.maxConnectionCount);
+    for (auto index = m_config.maxConnectionCount; index > 0; --index) {
+        m_freeConnections.push_back(index - 1);
+    }
+
+    const auto indexSize = RoundUpToPowerOfTwo(static_cast<std::size_t>(m_config.maxConnectionCount) * 2);
+    m_index.assign(indexSize, NULL_INDEX);
+    m_indexMask = static_cast<std::uint32_t>(indexSize - 1);
+
+    const auto chunkCount = m_config.memoryLimitInBytes / CHUNK_SIZE_IN_BYTES;
+    m_chunks.resize(chunkCount);
+    m_freeChunks.reserve(chunkCount);
+    for (auto chunk = chunkCount; chunk > 0; --chunk) {
+        m_freeChunks.push_back(chunk - 1);
+    }
+}
+
+bool TcpReassembler::process(const ConstRawFrameViewType ipPacket, const TimestampType timestamp)
+{
+    advance(timestamp);
+
+    const auto ipViewer = IpViewer::TryView(ipPacket);
+    // The fragments have to be reassembled by IpReassembler first
+    if (!ipViewer || ipViewer->getProtocol() != IpViewer::ProtocolType::TCP
+        || (NetworkToHost16(static_cast<std::uint16_t>(ipViewer->getFragmentOffset())) & (IP_MF | IP_OFFMASK)) != 0) {
+        ++m_statistics.skippedPackets;
+        return false;
+    }
+
+    const auto ipPayload = ipViewer->getPayload(ipPacket);
+    const auto tcpViewer = TcpViewer::TryView(ipPayload);
+    if (!tcpViewer) {
+        ++m_statistics.skippedPackets;
+        return false;
+    }
+
+    ++m_statistics.segments;
+    const FlowKey key(*ipViewer, *tcpViewer);
+    const auto flags = tcpViewer->getFlags();
+    const auto sequence = static_cast<std::uint32_t>(tcpViewer->getSequenceNumber());
+    const auto payload = tcpViewer->getPayload(ipPayload);
+
+    auto direction = Direction::ClientToServer;
+    auto index = findConnection(key);
+    if (index == NULL_INDEX) {
+        index = findConnection(key.getReversed());
+        direction = Direction::ServerToClient;
+    }
+
+    if (index == NULL_INDEX) {
+        // Only SYN or the payload opens the connection, so the segments after the close(ACK of FIN, RST) do not reopen it.
+        // SYN+ACK is sent by the server
+        if ((flags & TH_RST) != 0 || ((flags & TH_SYN) == 0 && payload.empty())) {
+            ++m_statistics.skippedPackets;
+            return false;
+        }
+
+        const bool isSynAck = (flags & (TH_SYN | TH_ACK)) == (TH_SYN | TH_ACK);
+        direction = isSynAck ? Direction::ServerToClient : Direction::ClientToServer;
+        index = createConnection(isSynAck ? key.getReversed() : key, timestamp);
+        if (index == NULL_INDEX) {
+            ++m_statistics.connectionDrops;
+            return false;
+        }
+    } else {
+        (void)m_timerWheel.reschedule(m_connections[index].timerId, timestamp + m_config.idleTimeout);
+    }
+
+    if ((flags & TH_RST) != 0) {
+        closeConnection(index, CloseReason::Reset);
+        return true;
+    }
+
+    auto& connection = m_connections[index];
+    auto& half = connection.halves[ToIndex(direction)];
+    auto dataSequence = sequence;
+    if ((flags & TH_SYN) != 0) {
+        // SYN takes one sequence number
+        ++dataSequence;
+        if (!half.isStarted) {
+            half.isStarted = true;
+            half.nextSequence = dataSequence;
+        }
+    } else if (!half.isStarted) {
+        // The stream is picked up in the middle
+        half.isStarted = true;
+        half.nextSequence = sequence;
+    }
+
+    if (!payload.empty() && !half.isClosed) {
+        handleData(connection, direction, dataSequence, payload);
+    }
+
+    if ((flags & TH_FIN) != 0 && !half.hasFin) {
+        half.hasFin = true;
+        half.finSequence = dataSequence + static_cast<std::uint32_t>(payload.size());
+    }
+
+    if (half.hasFin && !half.isClosed && half.nextSequence == half.finSequence) {
+        half.isClosed = true;
+        if (connection.halves[0].isClosed && connection.halves[1].isClosed) {
+            closeConnection(index, CloseReason::Fin);
+        }
+    }
+    return true;
+}
+
+TcpReassembler::SizeType TcpReassembler::advance(const TimestampType now)
+{
+    return static_cast<SizeType>(m_timerWheel.advance(now, [this](TimerWheel::TimerIdType, const std::uint64_t index) {
+        closeConnection(static_cast<std::uint32_t>(index), CloseReason::Timeout);
+    }));
+}
+
+void TcpReassembler::clear()
+{
+    for (std::uint32_t index = 0; index < m_connections.size(); ++index) {
+        if (m_connections[index].timerId != TimerWheel::INVALID_TIMER_ID) {
+            closeConnection(index, CloseReason::Clear);
+        }
+    }
+}
+
+const TcpReassembler::Configuration& TcpReassembler::getConfiguration() const noexcept
+{
+    return m_config;
+}
+
+TcpReassembler::Statistics TcpReassembler::getStatistics() const noexcept
+{
+    auto statistics = m_statistics;
+    statistics.activeConnections = static_cast<SizeType>(m_connections.size() - m_freeConnections.size());
+    statistics.usedMemoryInBytes = static_cast<SizeType>((m_chunks.size() - m_freeChunks.size()) * CHUNK_SIZE_IN_BYTES);
+    return statistics;
+}
+
+std::uint32_t TcpReassembler::findConnection(const FlowKey& key) const noexcept
+{
+    for (auto position = static_cast<std::uint32_t>(key.getHash()) & m_indexMask; ; position = (position + 1) & m_indexMask) {
+        const auto index = m_index[position];
+        if (index == NULL_INDEX || m_connections[index].info.key == key) {
+            return index;
+        }
+    }
+}
+
+std::uint32_t TcpReassembler::createConnection(const FlowKey& key, const TimestampType timestamp)
+{
+    if (m_freeConnections.empty()) {
+        return NULL_INDEX;
+    }
+
+    const auto index = m_freeConnections.back();
+    m_freeConnections.pop_back();
+
+    auto position = static_cast<std::uint32_t>(key.getHash()) & m_indexMask;
+    while (m_index[position] != NULL_INDEX) {
+        position = (position + 1) & m_indexMask;
+    }
+    m_index[position] = index;
+
+    auto& connection = m_connections[index];
+    connection.info = StreamInfo{ .key = key, .connectionId = ++m_nextConnectionId };
+    connection.halves = {};
+    connection.timerId = m_timerWheel.schedule(timestamp + m_config.idleTimeout, index);
+    ++m_statistics.createdConnections;
+    return index;
+}
+
+void TcpReassembler::handleData(Connection& connection, const Direction direction, const std::uint32_t sequence,
+    const ConstRawFrameViewType payload)
+{
+    auto& half = connection.halves[ToIndex(direction)];
+    const auto offset = SequenceDiff(sequence, half.nextSequence);
+    if (offset <= 0) {
+        const auto deliveredLength = static_cast<std::uint32_t>(-static_cast<std::int64_t>(offset));
+        if (deliveredLength >= payload.size()) {
+            ++m_statistics.retransmittedSegments;
+            return;
+        }
+
+        // The in-order segment is delivered from the packet
+        deliver(connection, direction, payload.subspan(deliveredLength));
+        drain(connection, direction);
+        return;
+    }
+
+    ++m_statistics.outOfOrderSegments;
+    if (bufferSegment(half, sequence, payload)) {
+        return;
+    }
+
+    ++m_statistics.bufferOverflows;
+    while (half.chunkHead != NULL_INDEX) {
+        skipGap(connection, direction);
+        if (SequenceDiff(sequence, half.nextSequence) <= 0) {
+            handleData(connection, direction, sequence, payload);
+            return;
+        }
+
+        if (bufferSegment(half, sequence, payload)) {
+            return;
+        }
+    }
+
+    // Nothing is buffered and the segment still does not fit, so the hole before it is skipped
+    const auto gap = static_cast<std::uint32_t>(SequenceDiff(sequence, half.nextSequence));
+    if (m_handlers.onGap) {
+        m_handlers.onGap(connection.info, direction, gap);
+    }
+    ++m_statistics.gaps;
+    m_statistics.gapBytes += gap;
+    half.nextSequence = sequence;
+    deliver(connection, direction, payload);
+}
+
+bool TcpReassembler::bufferSegment(HalfStream& half, std::uint32_t sequence, ConstRawFrameViewType payload) noexcept
+{
+    // The budget is charged by the whole chunks, because every segment takes at least one chunk of the pool
+    const auto chunkCount = (payload.size() + CHUNK_SIZE_IN_BYTES - 1) / CHUNK_SIZE_IN_BYTES;
+    if ((static_cast<std::size_t>(half.chunkCount) + chunkCount) * CHUNK_SIZE_IN_BYTES > m_config.maxBufferedBytesPerDirection
+        || chunkCount > m_freeChunks.size()) {
+        return false;
+    }
+
+    // The chunks are inserted after the chunks with the same or the lower sequence number, so the first copy is delivered first
+    auto prev = NULL_INDEX;
+    auto next = half.chunkHead;
+    while (next != NULL_INDEX && SequenceDiff(m_chunks[next].sequence, sequence) <= 0) {
+        prev = next;
+        next = m_chunks[next].next;
+    }
+
+    half.bufferedBytes += static_cast<std::uint32_t>(payload.size());
+    half.chunkCount += static_cast<std::uint32_t>(chunkCount);
+    m_statistics.bufferedBytes += static_cast<SizeType>(payload.size());
+    while (!payload.empty()) {
+        const auto index = m_freeChunks.back();
+        m_freeChunks.pop_back();
+
+        auto& chunk = m_chunks[index];
+        chunk.sequence = sequence;
+        chunk.length = static_cast<std::uint32_t>(std::min<std::size_t>(payload.size(), CHUNK_SIZE_IN_BYTES));
+        std::memcpy(chunk.data.data(), payload.data(), chunk.length);
+        chunk.next = next;
+        if (prev != NULL_INDEX) {
+            m_chunks[prev].next = index;
+        } else {
+            half.chunkHead = index;
+        }
+
+        prev = index;
+        sequence += chunk.length;
+        payload = payload.subspan(chunk.length);
+    }
+    return true;
+}
+
+void TcpReassembler::deliver(Connection& connection, const Direction direction, const ConstRawFrameViewType data)
+{
+    if (m_handlers.onData) {
+        m_handlers.onData(connection.info, direction, data);
+    }
+
+    const auto size = static_cast<std::uint32_t>(data.size());
+    connection.info.deliveredBytes[ToIndex(direction)] += size;
+    connection.halves[ToIndex(direction)].nextSequence += size;
+    m_statistics.deliveredBytes += size;
+}
+
+void TcpReassembler::drain(Connection& connection, const Direction direction)
+{
+    auto& half = connection.halves[ToIndex(direction)];
+    while (half.chunkHead != NULL_INDEX) {
+        const auto index = half.chunkHead;
+        const auto& chunk = m_chunks[index];
+        const auto offset = SequenceDiff(chunk.sequence, half.nextSequence);
+        if (offset > 0) {
+            break;
+        }
+
+        const auto deliveredLength = static_cast<std::uint32_t>(-static_cast<std::int64_t>(offset));
+        if (deliveredLength < chunk.length) {
+            deliver(connection, direction, ConstRawFrameViewType(chunk.data.data() + deliveredLength, chunk.length - deliveredLength));
+        }
+
+        half.chunkHead = chunk.next;
+        half.bufferedBytes -= chunk.length;
+        --half.chunkCount;
+        m_statistics.bufferedBytes -= chunk.length;
+        m_freeChunks.push_back(index);
+    }
+}
+
+void TcpReassembler::skipGap(Connection& connection, const Direction direction)
+{
+    auto& half = connection.halves[ToIndex(direction)];
+    assert(half.chunkHead != NULL_INDEX);
+    const auto firstSequence = m_chunks[half.chunkHead].sequence;
+    const auto gap = static_cast<std::uint32_t>(SequenceDiff(firstSequence, half.nextSequence));
+    if (m_handlers.onGap) {
+        m_handlers.onGap(connection.info, direction, gap);
+    }
+
+    ++m_statistics.gaps;
+    m_statistics.gapBytes += gap;
+    half.nextSequence = firstSequence;
+    drain(connection, direction);
+}
+
+void TcpReassembler::closeConnection(const std::uint32_t index, const CloseReason reason)
+{
+    if (m_handlers.onClose) {
+        m_handlers.onClose(m_connections[index].info, reason);
+    }
+
+    // The timer of the expired connection is already released
+    (void)m_timerWheel.cancel(m_connections[index].timerId);
+    releaseConnection(index);
+    ++m_statistics.closedConnections;
+}
+
+void TcpReassembler::releaseConnection(const std::uint32_t index) noexcept
+{
+    auto& connection = m_connections[index];
+    for (auto& half : connection.halves) {
+        for (auto chunk = half.chunkHead; chunk != NULL_INDEX; chunk = m_chunks[chunk].next) {
+            m_freeChunks.push_back(chunk);
+        }
+        m_statistics.bufferedBytes -= half.bufferedBytes;
+        half = HalfStream{};
+    }
+    connection.timerId = TimerWheel::INVALID_TIMER_ID;
+
+    // The next connections of the probe sequence are shifted back into the hole, if the hole is between their home position and them
+    auto hole = static_cast<std::uint32_t>(connection.info.key.getHash()) & m_indexMask;
+    while (m_index[hole] != index) {
+        hole = (hole + 1) & m_indexMask;
+    }
+    m_index[hole] = NULL_INDEX;
+    for (auto position = (hole + 1) & m_indexMask; m_index[position] != NULL_INDEX; position = (position + 1) & m_indexMask) {
+        const auto home = static_cast<std::uint32_t>(m_connections[m_index[position]].info.key.getHash()) & m_indexMask;
+        if (((position - home) & m_indexMask) >= ((position - hole) & m_indexMask)) {
+            m_index[hole] = m_index[position];
+            m_index[position] = NULL_INDEX;
+            hole = position;
+        }
+    }
+    m_freeConnections.push_back(index);
+}
+
+std::string_view DirectionToStr(const TcpReassembler::Direction direction)
+{
+    switch (direction) {
+        case TcpReassembler::Direction::ClientToServer: return "ClientToServer";
+        case TcpReassembler::Direction::ServerToClient: return "ServerToClient";
+        default:
+            return "Undefined";
+    }
+}
+
+std::string_view CloseReasonToStr(const TcpReassembler::CloseReason reason)
+{
+    switch (reason) {
+        case TcpReassembler::CloseReason::Fin: return "Fin";
+        case TcpReassembler::CloseReason::Reset: return "Reset";
+        case TcpReassembler::CloseReason::Timeout: return "Timeout";
+        case TcpReassembler::CloseReason::Clear: return "Clear";
+        default:
+            return "Undefined";
+    }
+}
+
+} //! namespace posnet
@@ -0,0 +1,241 @@
+#include "utils/timer_wheel.h"
+
+#include <stdexcept>
+#include <algorithm>
+#include <utility>
+#include <cassert>
+
+namespace {
+
+constexpr std::uint64_t WHEEL_RANGE_IN_TICKS = std::uint64_t{ 1 } << (posnet::utils::TimerWheel::SLOT_BITS * posnet::utils::TimerWheel::LEVEL_COUNT);
+
+} //! namespace
+
+namespace posnet::utils {
+
+TimerWheel::TimerWheel(Configuration config, const TimestampType now):
+m_config(config),
+m_timers(),
+m_freeHead(NULL_INDEX),
+m_slots(),
+m_levelTimerCounts(),
+m_timerCount(0),
+m_currentTick(0),
+m_currentTime(now)
+{
+    if (m_config.tickDuration <= TimestampType::zero()) {
+        throw std::runtime_error("Invalid timer wheel configuration: tick duration must be greater than zero");
+    }
+
+    m_timers.reserve(m_config.initialCapacity);
+    m_slots.fill(NULL_INDEX);
+    m_levelTimerCounts.fill(0);
+    m_currentTick = toTick(now);
+}
+
+TimerWheel::TimerIdType TimerWheel::schedule(const TimestampType expiry, const std::uint64_t userData)
+{
+    const auto index = allocate();
+    auto& timer = m_timers[index];
+    timer.expiryTick = toExpiryTick(expiry);
+    timer.userData = userData;
+    link(index);
+    ++m_timerCount;
+    return makeId(index);
+}
+
+TimerWheel::TimerIdType TimerWheel::scheduleAfter(const TimestampType timeout, const std::uint64_t userData)
+{
+    return schedule(m_currentTime + timeout, userData);
+}
+
+bool TimerWheel::reschedule(const TimerIdType timerId, const TimestampType expiry) noexcept
+{
+    const auto index = findTimer(timerId);
+    if (index == NULL_INDEX) {
+        return false;
+    }
+
+    unlink(index);
+    m_timers[index].expiryTick = toExpiryTick(expiry);
+    link(index);
+    return true;
+}
+
+bool TimerWheel::cancel(const TimerIdType timerId) noexcept
+{
+    const auto index = findTimer(timerId);
+    if (index == NULL_INDEX) {
+        return false;
+    }
+
+    unlink(index);
+    release(index);
+    return true;
+}
+
+bool TimerWheel::isActive(const TimerIdType timerId) const noexcept
+{
+    return findTimer(timerId) != NULL_INDEX;
+}
+
+TimerWheel::TimestampType TimerWheel::getCurrentTime() const noexcept
+{
+    return m_currentTime;
+}
+
+TimerWheel::SizeType TimerWheel::getTimerCount() const noexcept
+{
+    return m_timerCount;
+}
+
+const TimerWheel::Configuration& TimerWheel::getConfiguration() const noexcept
+{
+    return m_config;
+}
+
+std::uint64_t TimerWheel::toTick(const TimestampType timestamp) const noexcept
+{
+    return timestamp > TimestampType::zero() ? static_cast<std::uint64_t>(timestamp.count() / m_config.tickDuration.count()) : 0;
+}
+
+std::uint64_t TimerWheel::toExpiryTick(const TimestampType expiry) const noexcept
+{
+    // The expiry is rounded up, so the timer never fires before it
+    const auto tickDuration = static_cast<std::uint64_t>(m_config.tickDuration.count());
+    return expiry > TimestampType::zero() ? (static_cast<std::uint64_t>(expiry.count()) + tickDuration - 1) / tickDuration : 0;
+}
+
+std::uint32_t TimerWheel::findTimer(const TimerIdType timerId) const noexcept
+{
+    const auto index = static_cast<std::uint32_t>(timerId);
+    if (index >= m_timers.size()) {
+        return NULL_INDEX;
+    }
+
+    const auto& timer = m_timers[index];
+    return (timer.generation == static_cast<std::uint32_t>(timerId >> 32) && timer.slot != NULL_INDEX) ? index : NULL_INDEX;
+}
+
+TimerWheel::TimerIdType TimerWheel::makeId(const std::uint32_t index) const noexcept
+{
+    return (static_cast<TimerIdType>(m_timers[index].generation) << 32) | index;
+}
+
+std::uint32_t TimerWheel::allocate()
+{
+    if (m_freeHead != NULL_INDEX) {
+        const auto index = m_freeHead;
+        m_freeHead = m_timers[index].next;
+        return index;
+    }
+
+    if (m_timers.size() >= NULL_INDEX) {
+        throw std::runtime_error("Could not schedule timer: too many timers");
+    }
+    m_timers.emplace_back();
+    return static_cast<std::uint32_t>(m_timers.size() - 1);
+}
+
+void TimerWheel::release(const std::uint32_t index) noexcept
+{
+    auto& timer = m_timers[index];
+    // The generation is never zero, so the identifier is never INVALID_TIMER_ID
+    timer.generation = timer.generation == UINT32_MAX ? 1 : timer.generation + 1;
+    timer.next = m_freeHead;
+    m_freeHead = index;
+    --m_timerCount;
+}
+
+void TimerWheel::link(const std::uint32_t index) noexcept
+{
+    auto& timer = m_timers[index];
+    // The expired timer is put into the slot of the next processed tick
+    auto expiryTick = std::max(timer.expiryTick, m_currentTick);
+    const auto delta = expiryTick - m_currentTick;
+    if (delta >= WHEEL_RANGE_IN_TICKS) {
+        // The timer is put to the farthest slot, it is moved further when the slot is cascaded
+        expiryTick = m_currentTick + WHEEL_RANGE_IN_TICKS - 1;
+    }
+
+    unsigned int level = 0;
+    while (level + 1 < LEVEL_COUNT && delta >= (std::uint64_t{ 1 } << (SLOT_BITS * (level + 1)))) {
+        ++level;
+    }
+
+    const auto slot = level * SLOT_COUNT + static_cast<std::uint32_t>((expiryTick >> (SLOT_BITS * level)) & SLOT_MASK);
+    timer.prev = NULL_INDEX;
+    timer.next = m_slots[slot];
+    if (timer.next != NULL_INDEX) {
+        m_timers[timer.next].prev = index;
+    }
+    m_slots[slot] = index;
+    timer.slot = slot;
+    ++m_levelTimerCounts[level];
+}
+
+void TimerWheel::unlink(const std::uint32_t index) noexcept
+{
+    auto& timer = m_timers[index];
+    assert(timer.slot != NULL_INDEX);
+    if (timer.prev != NULL_INDEX) {
+        m_timers[timer.prev].next = timer.next;
+    } else {
+        m_slots[timer.slot] = timer.next;
+    }
+
+    if (timer.next != NULL_INDEX) {
+        m_timers[timer.next].prev = timer.prev;
+    }
+    --m_levelTimerCounts[timer.slot / SLOT_COUNT];
+    timer.slot = NULL_INDEX;
+}
+
+std::uint32_t TimerWheel::cascade() noexcept
+{
+    const auto slot = static_cast<std::uint32_t>(m_currentTick & SLOT_MASK);
+    if (slot != 0) {
+        return slot;
+    }
+
+    for (unsigned int level = 1; level < LEVEL_COUNT; ++level) {
+        const auto levelSlot = static_cast<std::uint32_t>((m_currentTick >> (SLOT_BITS * level)) & SLOT_MASK);
+        auto index = std::exchange(m_slots[level * SLOT_COUNT + levelSlot], NULL_INDEX);
+        while (index != NULL_INDEX) {
+            const auto next = m_timers[index].next;
+            --m_levelTimerCounts[level];
+            link(index);
+            index = next;
+        }
+
+        // The next level is cascaded only if this level wraps too
+        if (levelSlot != 0) {
+            break;
+        }
+    }
+    return slot;
+}
+
+std::uint64_t TimerWheel::getSkipMask() const noexcept
+{
+    // The slots of level N are cascaded only at the ticks, which are multiple of SLOT_COUNT^N
+    unsigned int level = 0;
+    while (level + 1 < LEVEL_COUNT && m_levelTimerCounts[level] == 0) {
+        ++level;
+    }
+    return (std::uint64_t{ 1 } << (SLOT_BITS * level)) - 1;
+}
+
+std::uint32_t TimerWheel::popExpired(const std::uint32_t slot) noexcept
+{
+    const auto index = m_slots[slot];
+    if (index == NULL_INDEX) {
+        return NULL_INDEX;
+    }
+
+    assert(m_timers[index].expiryTick <= m_currentTick);
+    unlink(index);
+    return index;
+}
+
+} //! namespace posnet::utils
@@ -1,4 +1,6 @@
 #include "include/frame-builder/udp_builder.h"
+#include "include/packet-buffer/packet_buffer.h"
+#include "include/frame-builder/ip_builder.h"
 
 #include "include/frame-viewers/ip_viewer.h"
 #include "include/frame-viewers/ethernet_viewer.h"
@@ -6,6 +8,8 @@
 
 #include "include/utils/algorithms.h"
 
+#include <stdexcept>
+#include <string>
 #include <sstream>
 #include <cstring>
 
@@ -22,12 +26,14 @@ m_frame()
 
 UdpBuilder& UdpBuilder::setSourcePort(const PortType port) &
 {
+    updateCheckSum(m_frame.source, htons(port));
     m_frame.source = htons(port);
     return *this;
 }
 
 UdpBuilder& UdpBuilder::setDestPort(const PortType port) &
 {
+    updateCheckSum(m_frame.dest, htons(port));
     m_frame.dest = htons(port);
     return *this;
 }
@@ -44,6 +50,15 @@ UdpBuilder& UdpBuilder::setCheckSum(const unsigned int checkSum) &
     return *this;
 }
 
+void UdpBuilder::updateCheckSum(const std::uint16_t oldPort, const std::uint16_t newPort)
+{
+    if (m_frame.check != 0) {
+        const auto checkSum = posnet::utils::UpdateChecksum16(ntohs(m_frame.check), ntohs(oldPort), ntohs(newPort));
+        // The zero checksum is transmitted as all ones, because the zero value means that there is no checksum(RFC 768)
+        m_frame.check = htons(checkSum == 0 ? 0xFFFF : checkSum);
+    }
+}
+
 // UdpBuilder& UdpBuilder::setPayload(const std::span<std::int8_t> payload) &
 // {
 //     if (sizeof(EthernetViewer::HeaderStructType) + IpViewer(m_rawFrame).getHeaderLengthInBytes() + payload.size() <= m_rawFrame.size()) {
@@ -102,6 +117,46 @@ unsigned int UdpBuilder::getDefaultCheckSum() const
     return {};
 }
 
+unsigned int UdpBuilder::calcCheckSum(const IpBuilder& ipBuilder, const std::span<const ConstRawFrameViewType> payload) const
+{
+    const IpViewer ipViewer(ipBuilder.getAsRawFrameView());
+
+    SizeType length = DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES;
+    for (const auto segment : payload) {
+        length += static_cast<SizeType>(segment.size());
+    }
+
+    auto header = m_frame;
+    header.check = 0;
+
+    posnet::utils::ChecksumAccumulator accumulator;
+    accumulator.addWord32(ntohl(ipViewer.getSourceIpAddress()))
+        .addWord32(ntohl(ipViewer.getDestIpAddress()))
+        .addWord16(IPPROTO_UDP)
+        .addWord16(static_cast<std::uint16_t>(length))
+        .add(ConstRawFrameViewType{ reinterpret_cast<const ByteType*>(&header), sizeof(header) });
+    for (const auto segment : payload) {
+        accumulator.add(segment);
+    }
+
+    const auto checkSum = accumulator.getChecksum();
+    // The zero checksum is transmitted as all ones, because the zero value means that there is no checksum(RFC 768)
+    return checkSum == 0 ? 0xFFFF : checkSum;
+}
+
+void UdpBuilder::prependTo(PacketBuffer& buffer) const
+{
+    const auto length = DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES + buffer.getSize();
+    if (length > UINT16_MAX) {
+        throw std::runtime_error("Could not prepend udp header to packet buffer: length=" + std::to_string(length) +
+            " exceeds the maximum=" + std::to_string(UINT16_MAX));
+    }
+
+    auto header = m_frame;
+    header.len = htons(static_cast<std::uint16_t>(length));
+    std::memcpy(buffer.prepend(DEFAULT_FRAME_HEADER_LENGTH_IN_BYTES).data(), &header, sizeof(header));
+}
+
 std::ostream& UdpBuilder::operator<<(std::ostream& os) const
 {
     return os << UdpViewer(getAsRawFrameView());
@@ -4,15 +4,17 @@
 #include <arpa/inet.h>
 #include <unistd.h>
 #include <string.h>
+#include <string_view>
+
+#include "include/net-io/batch_receiver.h"
 
 #define SERVER_PORT 12345
 #define BUFFER_SIZE 1024
+#define BATCH_SIZE 64
 
 int main() {
     int sockfd;
-    struct sockaddr_in server_addr, client_addr;
-    socklen_t client_addr_len = sizeof(client_addr);
-    char buffer[BUFFER_SIZE];
+    struct sockaddr_in server_addr;
 
     // Create a UDP socket
     sockfd = socket(AF_INET, SOCK_DGRAM, 0);
@@ -36,21 +38,26 @@ int main() {
 
     std::cout << "UDP server is listening on port " << SERVER_PORT << std::endl;
 
+    posnet::BatchReceiver receiver(sockfd, BATCH_SIZE, BUFFER_SIZE);
     while (true) {
-        // Receive data from the client
-        ssize_t recv_len = recvfrom(sockfd, buffer, BUFFER_SIZE - 1, 0, (struct sockaddr *)&client_addr, &client_addr_len);
-        if (recv_len < 0) {
-            perror("recvfrom");
+        // Receive all datagrams, which are already queued, by one syscall
+        const posnet::BatchReceiver::Batch* batch = nullptr;
+        try {
+            batch = &receiver.receive();
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << std::endl;
             close(sockfd);
             return 1;
         }
 
-        // Null-terminate the buffer
-        buffer[recv_len] = '\0';
+        for (posnet::BatchReceiver::SizeType i = 0; i < batch->size(); ++i) {
+            const auto datagram = batch->getFrame(i);
+            const auto& client_addr = reinterpret_cast<const struct sockaddr_in&>(batch->getSourceAddress(i));
 
-        // Print the received message
-        std::cout << "{Received message from " << inet_ntoa(client_addr.sin_addr) << ":" << ntohs(client_addr.sin_port) << "\t";
-        std::cout << "Message: " << buffer << "}" << std::endl;
+            // Print the received message
+            std::cout << "{Received message from " << inet_ntoa(client_addr.sin_addr) << ":" << ntohs(client_addr.sin_port) << "\t";
+            std::cout << "Message: " << std::string_view(reinterpret_cast<const char*>(datagram.data()), datagram.size()) << "}" << std::endl;
+        }
     }
     
     // Close the socket